@@ -16,6 +16,8 @@
  *
  * \internal
  * \par Modification History
+ * - 1.03 26-10-17  prescale the ISR execution time histogram.
+ * - 1.02 26-10-17  add ISR execution time statistics.
  * - 1.01 17-04-10  sdy, modified.
  * - 1.00 15-01-29  hbt, first implementation.
  * \endinternal
@@ -65,6 +67,66 @@ struct am_arm_nvic_isr_info {
     void         *p_arg;
 };
 
+/**
+ * \brief ISR ִʱֱͼͰ
+ *
+ * ֱͼĵλΪ 2^AM_ARM_NVIC_ISR_STAT_HIST_SHIFT ʱֵ 0 Ͱͳ
+ * ִʱ䲻 1 λĴ i Ͱi >= 1ͳִʱ
+ * [2^(i-1), 2^i) λڵĴΧļһͰͰ޼
+ * AM_ARM_NVIC_ISR_STAT_HIST_LOW()
+ */
+#ifndef AM_ARM_NVIC_ISR_STAT_HIST_NUM
+#define AM_ARM_NVIC_ISR_STAT_HIST_NUM    12
+#endif
+
+/**
+ * \brief ISR ִʱֱͼĵλΪ 2 ĸֵηʱֵ
+ *
+ * ӦʱƵѡʹһͰ޴ڹעִʱ䡣Ĭֵ 5
+ *  48 MHz ʱλԼΪ 0.67 us12 ͰһͰ 2^15 ֵԼ
+ * 683 usʼΪ 0 ʱλΪ 1 ֵ48 MHz ʱһͰԼ 21 us
+ * ʼ
+ */
+#ifndef AM_ARM_NVIC_ISR_STAT_HIST_SHIFT
+#define AM_ARM_NVIC_ISR_STAT_HIST_SHIFT  5
+#endif
+
+/**
+ * \brief ֱͼ i Ͱޣʱֵͨ am_timestamp_to_us() ת
+ */
+#define AM_ARM_NVIC_ISR_STAT_HIST_LOW(i) \
+    (((i) == 0) ? 0u : (1u << ((i) - 1 + AM_ARM_NVIC_ISR_STAT_HIST_SHIFT)))
+
+/**
+ * \brief ISR ִʱͳ
+ *
+ * ֱͼ⣬ʱ䵥λΪʱֵͨ am_timestamp_to_us() ת
+ * ִʱڼ䱻ȼжϴϵʱ䡣
+ */
+typedef struct am_arm_nvic_isr_stat {
+
+    /** \brief ִд */
+    uint32_t count;
+
+    /** \brief ִʱ */
+    uint32_t min;
+
+    /** \brief ִʱ */
+    uint32_t max;
+
+    /** \brief ִʱۼֵƽֵΪ sum / count */
+    uint64_t sum;
+
+    /**
+     * \brief ִʱֱͼ
+     *
+     * λ AM_ARM_NVIC_ISR_STAT_HIST_SHIFTĳͰʱͰֵ룬
+     * ֱͼӳǽڵķֲ
+     */
+    uint16_t hist[AM_ARM_NVIC_ISR_STAT_HIST_NUM];
+
+} am_arm_nvic_isr_stat_t;
+
 
 /** \brief ж豸Ϣ */
 typedef struct am_arm_nvic_devinfo {
@@ -92,6 +154,17 @@ typedef struct am_arm_nvic_devinfo {
 
     /** \brief ISR Ϣӳڴ(С isrinfo_cnt һ) */
     struct am_arm_nvic_isr_info *p_isrinfo;
+
+    /**
+     * \brief ISR ͳ
+     *
+     * жϰ˳ռ ISR Ϣǰ isrstat_cnt  ISR ϢӦж
+     * ִʱͳ
+     */
+    int isrstat_cnt;
+
+    /** \brief ISR ͳڴ(С isrstat_cnt һ)Ϊ NULL ʱͳ */
+    am_arm_nvic_isr_stat_t *p_isrstat;
     
     /** \brief ƽ̨ʼ */
     void     (*pfn_plfm_init)(void);
@@ -147,6 +220,50 @@ int am_arm_nvic_init (am_arm_nvic_dev_t           *p_dev,
  */
 void am_arm_nvic_deinit (void);
 
+/**
+ * \brief ȡжϵִʱͳ
+ *
+ * \param[in]  inum   : жϺ
+ * \param[out] p_stat : ڻȡͳֵ
+ *
+ * \retval  AM_OK       : ɹ
+ * \retval -AM_EINVAL   : Ч
+ * \retval -AM_EPERM    : жδ
+ * \retval -AM_ENOTSUP  : жδͳڴ
+ */
+int am_arm_nvic_isr_stat_get (int inum, am_arm_nvic_isr_stat_t *p_stat);
+
+/**
+ * \brief жϵִʱͳ
+ *
+ * \param[in] inum : жϺ
+ *
+ * \retval  AM_OK       : ɹ
+ * \retval -AM_EINVAL   : Ч
+ * \retval -AM_EPERM    : жδ
+ * \retval -AM_ENOTSUP  : жδͳڴ
+ */
+int am_arm_nvic_isr_stat_reset (int inum);
+
+/**
+ * \brief жϵִʱͳ
+ * \return 
+ */
+void am_arm_nvic_isr_stat_reset_all (void);
+
+/**
+ * \brief ƽִʱ
+ *
+ * \param[in] p_stat : ͳֵ
+ *
+ * \return ƽִʱ䣨ʱֵδִйʱΪ 0
+ */
+am_static_inline
+uint32_t am_arm_nvic_isr_stat_mean (const am_arm_nvic_isr_stat_t *p_stat)
+{
+    return (p_stat->count == 0) ? 0 : (uint32_t)(p_stat->sum / p_stat->count);
+}
+
 /**
  * @}
  */
@@ -88,6 +88,19 @@ am_arm_systick_init(am_arm_systick_dev_t           *p_dev,
  */
 void am_arm_systick_deinit(am_timer_handle_t handle);
 
+/**
+ * \brief ȡ SYSTICK жǷڹ״̬
+ *
+ * жڼڸȼжУжϼǷѾתжϻδ
+ *  am_timestamp_module_init()  pfn_pending 
+ *
+ * \param[in] p_arg : δʹ
+ *
+ * \retval AM_TRUE  : SYSTICK жϹ
+ * \retval AM_FALSE : SYSTICK жδ
+ */
+am_bool_t am_arm_systick_int_pending_get (void *p_arg);
+
 /** @} */
 
 #ifdef __cplusplus
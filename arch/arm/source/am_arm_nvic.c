@@ -16,6 +16,10 @@
  *
  * \internal
  * \par Modification history
+ * - 1.05 26-10-17  prescale the ISR execution time histogram.
+ * - 1.04 26-10-17  add optional CPU load accounting.
+ * - 1.03 26-10-17  add ISR execution time statistics.
+ * - 1.02 26-10-17  add optional interrupt trace.
  * - 1.01 17-04-10  sdy, modified.
  * - 1.00 14-12-04  hbt, first implementation.
  * \endinternal
@@ -23,7 +27,11 @@
 
 #include "ametal.h"
 #include "am_arm_nvic.h"
+#include "am_int.h"
+#include "am_timestamp.h"
 #include "hw/amhw_arm_nvic.h"
+#include "am_irq_trace.h"
+#include "am_cpu_load.h"
 
 /*******************************************************************************
 * ˽ж
@@ -39,6 +47,88 @@
 /** \brief ָж豸ָ */
 static am_arm_nvic_dev_t *__gp_nvic_dev = NULL;
 
+/******************************************************************************
+  غ
+*******************************************************************************/
+
+/* ͳֵ */
+static void __isr_stat_clr (am_arm_nvic_isr_stat_t *p_stat)
+{
+    int i;
+
+    p_stat->count = 0;
+    p_stat->min   = 0xFFFFFFFFu;
+    p_stat->max   = 0;
+    p_stat->sum   = 0;
+
+    for (i = 0; i < AM_ARM_NVIC_ISR_STAT_HIST_NUM; i++) {
+        p_stat->hist[i] = 0;
+    }
+}
+
+/* ۼһִʱ䣬жеãͬһжϲǶףж */
+static void __isr_stat_add (am_arm_nvic_isr_stat_t *p_stat, uint32_t dur)
+{
+    uint32_t val = dur >> AM_ARM_NVIC_ISR_STAT_HIST_SHIFT;
+    int      idx = 0;
+    int      i;
+
+    p_stat->count++;
+    p_stat->sum += dur;
+
+    if (dur < p_stat->min) {
+        p_stat->min = dur;
+    }
+    if (dur > p_stat->max) {
+        p_stat->max = dur;
+    }
+
+    /* ͰΪִʱЧλM0  CLZ ָλ */
+    while ((val != 0) && (idx < AM_ARM_NVIC_ISR_STAT_HIST_NUM - 1)) {
+        val >>= 1;
+        idx++;
+    }
+
+    if (p_stat->hist[idx] == 0xFFFF) {
+        for (i = 0; i < AM_ARM_NVIC_ISR_STAT_HIST_NUM; i++) {
+            p_stat->hist[i] >>= 1;
+        }
+    }
+    p_stat->hist[idx]++;
+}
+
+/* ȡж϶Ӧͳڴ */
+static int __isr_stat_find (int inum, am_arm_nvic_isr_stat_t **pp_stat)
+{
+    const am_arm_nvic_devinfo_t *p_nvic_devinfo = NULL;
+    int slot;
+
+    if ((NULL == __gp_nvic_dev) || (!__gp_nvic_dev->valid_flg)) {
+        return -AM_EINVAL;
+    }
+
+    p_nvic_devinfo = __gp_nvic_dev->p_devinfo;
+
+    if (!((inum >= p_nvic_devinfo->int_servinfo.inum_start) &&
+          (inum <= p_nvic_devinfo->int_servinfo.inum_end))) {
+        return -AM_EINVAL;
+    }
+
+    slot = p_nvic_devinfo->p_isrmap[inum];
+    if (slot == __INT_NOT_CONNECTED) {
+        return -AM_EPERM;
+    }
+
+    if ((NULL == p_nvic_devinfo->p_isrstat) ||
+        (slot >= p_nvic_devinfo->isrstat_cnt)) {
+        return -AM_ENOTSUP;
+    }
+
+    *pp_stat = &p_nvic_devinfo->p_isrstat[slot];
+
+    return AM_OK;
+}
+
 /******************************************************************************
   
 *******************************************************************************/
@@ -69,6 +159,12 @@ int am_arm_nvic_init (am_arm_nvic_dev_t           *p_dev,
         for (i = 0; i < p_devinfo->isrinfo_cnt; i++) {
             p_devinfo->p_isrinfo[i].pfn_isr = NULL;
         }
+
+        if (p_devinfo->p_isrstat != NULL) {
+            for (i = 0; i < p_devinfo->isrstat_cnt; i++) {
+                __isr_stat_clr(&p_devinfo->p_isrstat[i]);
+            }
+        }
     }
 
     amhw_arm_nvic_priority_group_set (p_devinfo->group);
@@ -103,15 +199,18 @@ void am_arm_nvic_deinit (void)
     }
 }
 
-/* жϴ */
-void am_exc_eint_handler (void)
+/* ַжӵĻص */
+static void __exc_eint_dispatch (void)
 {
     const am_arm_nvic_devinfo_t *p_nvic_devinfo = NULL;
     int           inum = 0;
     int           slot;
     am_pfnvoid_t  pfn_isr;
     void         *p_arg;
-
+    uint32_t      ts;
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    uint32_t      trace_ts = am_irq_trace_enter();
+#endif
 
     if (NULL == __gp_nvic_dev) {
         return;
@@ -135,8 +234,34 @@ void am_exc_eint_handler (void)
     p_arg   = p_nvic_devinfo->p_isrinfo[slot].p_arg;
 
     if (pfn_isr != NULL) {
-        pfn_isr(p_arg);
+        if ((p_nvic_devinfo->p_isrstat != NULL) &&
+            (slot < p_nvic_devinfo->isrstat_cnt)) {
+            ts = (uint32_t)am_timestamp_get();
+            pfn_isr(p_arg);
+            __isr_stat_add(&p_nvic_devinfo->p_isrstat[slot],
+                           (uint32_t)am_timestamp_get() - ts);
+        } else {
+            pfn_isr(p_arg);
+        }
     }
+
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    am_irq_trace_exit(inum, trace_ts);
+#endif
+}
+
+/* жϴ */
+void am_exc_eint_handler (void)
+{
+#if (AM_CPU_LOAD_ENABLE != 0)
+    int load_prev = am_cpu_load_enter(AM_CPU_LOAD_IRQ);
+#endif
+
+    __exc_eint_dispatch();
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
 }
 
 /* жϻص */
@@ -182,6 +307,12 @@ int am_int_connect (int inum, am_pfnvoid_t pfn_isr, void *p_arg)
         p_nvic_devinfo->p_isrmap[inum]          = slot;
         p_nvic_devinfo->p_isrinfo[slot].p_arg   = p_arg;
         p_nvic_devinfo->p_isrinfo[slot].pfn_isr = pfn_isr;
+
+        /* ӵж¿ʼͳ */
+        if ((p_nvic_devinfo->p_isrstat != NULL) &&
+            (slot < p_nvic_devinfo->isrstat_cnt)) {
+            __isr_stat_clr(&p_nvic_devinfo->p_isrstat[slot]);
+        }
     }
 
     if (slot == __INT_NOT_CONNECTED) {
@@ -279,4 +410,70 @@ int am_arm_nvic_priority_set(int inum,
     return AM_OK;
 }
 
+/* ȡжִʱͳ */
+int am_arm_nvic_isr_stat_get (int inum, am_arm_nvic_isr_stat_t *p_stat)
+{
+    am_arm_nvic_isr_stat_t *p_src = NULL;
+    int key;
+    int ret;
+
+    if (NULL == p_stat) {
+        return -AM_EINVAL;
+    }
+
+    ret = __isr_stat_find(inum, &p_src);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    key = am_int_cpu_lock();
+    *p_stat = *p_src;
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/* жִʱͳ */
+int am_arm_nvic_isr_stat_reset (int inum)
+{
+    am_arm_nvic_isr_stat_t *p_stat = NULL;
+    int key;
+    int ret;
+
+    ret = __isr_stat_find(inum, &p_stat);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    key = am_int_cpu_lock();
+    __isr_stat_clr(p_stat);
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/* жִʱͳ */
+void am_arm_nvic_isr_stat_reset_all (void)
+{
+    const am_arm_nvic_devinfo_t *p_nvic_devinfo = NULL;
+    int key;
+    int i;
+
+    if ((NULL == __gp_nvic_dev) || (!__gp_nvic_dev->valid_flg)) {
+        return;
+    }
+
+    p_nvic_devinfo = __gp_nvic_dev->p_devinfo;
+
+    if (NULL == p_nvic_devinfo->p_isrstat) {
+        return;
+    }
+
+    for (i = 0; i < p_nvic_devinfo->isrstat_cnt; i++) {
+        key = am_int_cpu_lock();
+        __isr_stat_clr(&p_nvic_devinfo->p_isrstat[i]);
+        am_int_cpu_unlock(key);
+    }
+}
+
 /* end of file */
@@ -22,6 +22,15 @@ am_int_cpu_unlock    PROC
     BX      LR
     ENDP
 
+;/*
+; * uint32_t am_int_in_isr();
+; */
+am_int_in_isr    PROC
+    EXPORT  am_int_in_isr
+    MRS     r0, IPSR
+    BX      LR
+    ENDP
+
 ;/*
 ; * end of file
 ; */
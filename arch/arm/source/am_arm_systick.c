@@ -18,6 +18,8 @@
  *       am_mdelay()am_udelay()
  * \internal
  * \par Modification History
+ * - 1.04 26-10-17  add optional CPU load accounting
+ * - 1.03 26-10-17  add optional interrupt trace
  * - 1.02 15-12-14  hgo, fix potential bug caused by incorrect p_arg on callback
  * - 1.00 15-09-22  win, first implementation.
  * \endinternal
@@ -28,7 +30,10 @@
 *******************************************************************************/
 #include "am_arm_systick.h"
 #include "hw/amhw_arm_systick.h"
+#include "hw/amhw_arm_nvic.h"
 #include "am_clk.h"
+#include "am_irq_trace.h"
+#include "am_cpu_load.h"
 
 /*******************************************************************************
   
@@ -92,9 +97,24 @@ static am_arm_systick_dev_t *__gp_systick_dev;
  */
 void SysTick_Handler (void)
 {
+#if (AM_CPU_LOAD_ENABLE != 0)
+    int      load_prev = am_cpu_load_enter(AM_CPU_LOAD_IRQ);
+#endif
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    uint32_t trace_ts = am_irq_trace_enter();
+#endif
+
     if (__gp_systick_dev->pfn_callback != NULL) {
         __gp_systick_dev->pfn_callback(__gp_systick_dev->p_arg);
     }
+
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    am_irq_trace_exit(AM_IRQ_TRACE_INUM_SYSTICK, trace_ts);
+#endif
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
 }
 
 /*******************************************************************************
@@ -319,3 +339,10 @@ void am_arm_systick_deinit (am_timer_handle_t handle)
     amhw_arm_systick_int_disable(p_hw_systick);
     amhw_arm_systick_disable(p_hw_systick);
 }
+
+/******************************************************************************/
+am_bool_t am_arm_systick_int_pending_get (void *p_arg)
+{
+    /* ICSR Ĵ PENDSTSET λ */
+    return (am_bool_t)((AMHW_ARM_SCB->icsr & (1ul << 26)) != 0);
+}
@@ -17,6 +17,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add buffered output configuration
  * - 1.00 17-11-20  pea, first implementation
  * \endinternal
  */
@@ -40,6 +41,38 @@
 /** \brief õԴĲ */
 #define __DEBUG_BAUDRATE        115200
 
+/**
+ * \brief ϢͻСΪ 0 ʱԲѯʽ
+ *
+ * Ϊ 0 ʱϢд뻺ɴڷжϷͣڹжģʽ
+ * ԲѯʽӵԴڽݣ am_bsp_newlib ı׼룩
+ */
+#define __DEBUG_BUF_SIZE        0
+
+/** \brief ͻĴʽ AM_DEBUG_OVERFLOW_DROP */
+#define __DEBUG_OVERFLOW_POLICY AM_DEBUG_OVERFLOW_DROP
+
+#if (__DEBUG_BUF_SIZE > 0)
+
+/** \brief Ϣͻ */
+static char __g_debug_buf[__DEBUG_BUF_SIZE];
+
+#endif /* (__DEBUG_BUF_SIZE > 0) */
+
+/** \brief Գʼ */
+static void __debug_init (am_uart_handle_t handle)
+{
+#if (__DEBUG_BUF_SIZE > 0)
+    am_debug_buffered_init(handle,
+                           __DEBUG_BAUDRATE,
+                           __g_debug_buf,
+                           sizeof(__g_debug_buf),
+                           __DEBUG_OVERFLOW_POLICY);
+#else
+    am_debug_init(handle, __DEBUG_BAUDRATE);
+#endif /* (__DEBUG_BUF_SIZE > 0) */
+}
+
 /** \brief Դʵʼ */
 am_uart_handle_t am_debug_uart_inst_init (void)
 {
@@ -50,7 +83,7 @@ am_uart_handle_t am_debug_uart_inst_init (void)
     handle = am_zlg116_uart1_inst_init();
 
     /* Գʼ */
-    am_debug_init(handle, __DEBUG_BAUDRATE);
+    __debug_init(handle);
 
 #endif /* (__DEBUG_UART == 1) */
 
@@ -59,7 +92,7 @@ am_uart_handle_t am_debug_uart_inst_init (void)
     handle = am_zlg116_uart2_inst_init();
 
     /* Գʼ */
-    am_debug_init(handle, __DEBUG_BAUDRATE);
+    __debug_init(handle);
 
 #endif /* (__DEBUG_UART == 2) */
 
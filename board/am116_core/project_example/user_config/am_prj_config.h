@@ -69,6 +69,14 @@
 /** \brief Ƿʹ isr defer  */
 #define AM_CFG_ISR_DEFER_ENABLE          1
 
+/**
+ * \brief Ϊ1am_waitam_event_group ȴڼ CPU ˯ģʽWFIжϻ
+ *
+ * ˯ģʽ豣УԿӡĬΪ 0æȴȷϹе
+ * ȴжϽʹ
+ */
+#define AM_CFG_WAIT_SLEEP_ENABLE         0
+
 /** @} */
 
 /**
@@ -123,6 +131,14 @@
  */
 #define AM_CFG_SOFTIMER_ENABLE       1
 
+/**
+ * \brief Ϊ1ϵͳδʱ޽ģticklessģʽ
+ *
+ * ޽ģʽʹ TIM2  SYSTICKʱֻһʱʱжϣ
+ * ڵ͹Ӧã am_bsp_system_tickless.h
+ */
+#define AM_CFG_SYSTEM_TICKLESS_ENABLE    0
+
 /**
  * \brief Ϊ1ʼڵԴĬΪUART0
  *
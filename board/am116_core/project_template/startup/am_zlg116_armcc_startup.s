@@ -16,6 +16,7 @@
 ; * 
 ; * \internal
 ; * \par Modification History
+; * - 1.01 26-10-17  paint the stack for high-water measurement.
 ; * - 1.00 17-10-26  pea, first implementation.
 ; * \endinternal
 ; */
@@ -30,6 +31,10 @@ Stack_Size      EQU     0x00000400
 Stack_Mem       SPACE   Stack_Size
 __initial_sp
 
+                ; Stack bounds, used by am_stack.c
+                EXPORT  Stack_Mem
+                EXPORT  __initial_sp
+
 
 ; <h> Heap Configuration
 ;   <o>  Heap Size (in Bytes) <0x0-0xFFFFFFFF:8>
@@ -106,6 +111,20 @@ __Vectors       DCD     __initial_sp                   ; Top of Stack
 Reset_Handler   PROC
                 EXPORT  Reset_Handler             [WEAK]
                 IMPORT  __main
+
+                ; Paint the (still unused) stack with AM_STACK_PAINT_PATTERN
+                ; (am_stack.h) for stack high-water measurement
+                LDR     R0, =Stack_Mem
+                LDR     R1, =__initial_sp
+                LDR     R2, =0xA5A5A5A5
+StackPaint_Loop
+                CMP     R0, R1
+                BHS     StackPaint_Done
+                STR     R2, [R0]
+                ADDS    R0, R0, #4
+                B       StackPaint_Loop
+StackPaint_Done
+
                 LDR     R0, =__main
                 BX      R0
                 ENDP
@@ -153,7 +172,6 @@ am_exc_eint_handler
 
                 IF      :DEF:__MICROLIB
                 
-                EXPORT  __initial_sp
                 EXPORT  __heap_base
                 EXPORT  __heap_limit
                 
@@ -33,6 +33,7 @@
 *  09.04.2011  mifi  First Version
 *  29.04.2011  mifi  Call SystemInit, and set the Vector Table Offset
 *                    before copy of data and bss segment.
+*  17.10.2026        Paint the stack for high-water measurement.
 ****************************************************************************/
 #define __CRT_C__
 
@@ -50,6 +51,7 @@ extern unsigned long _sdata;
 extern unsigned long _edata;
 extern unsigned long _sbss;
 extern unsigned long _ebss;
+extern unsigned long _sstack;
 
 /* This is the main */
 extern int main (void);
@@ -85,6 +87,18 @@ void ResetHandler (void)
    uint32_t *pSrc;
    uint32_t *pDest;
 
+   /*
+    * Paint the unused part of the stack (below the current stack
+    * pointer) with AM_STACK_PAINT_PATTERN from am_stack.h, so that
+    * am_stack_high_water_get() can find the deepest stack usage.
+    */
+   __asm volatile ("mov %0, sp" : "=r" (pSrc));
+   pDest = &_sstack;
+   while(pDest < pSrc)
+   {
+      *pDest++ = 0xA5A5A5A5;
+   }
+
    /*
     * Call the SystemInit code from CMSIS interface if available.
     * SystemInit is a week function which can be override
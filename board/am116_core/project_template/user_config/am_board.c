@@ -28,6 +28,7 @@
 #include "am_event_category_input.h"
 #include "am_zlg116.h"
 #include "am_zlg116_inst_init.h"
+#include "am_wait.h"
 
 #include "am_bsp_system_heap.h"
 #include "am_bsp_delay_timer.h"
@@ -43,6 +44,18 @@
 #include "am_bsp_newlib.h"
 #endif
 
+#if (AM_CFG_WAIT_SLEEP_ENABLE == 1)
+
+/* ȴڼĿкCPU ˯ģʽжϻ */
+static void __wait_idle_sleep (void *p_arg)
+{
+    (void)p_arg;
+
+    am_zlg116_pwr_sleep();
+}
+
+#endif /* (AM_CFG_WAIT_SLEEP_ENABLE == 1) */
+
 /*******************************************************************************
   弶ʼ
 *******************************************************************************/
@@ -78,11 +91,13 @@ void am_board_init (void)
     #endif
 #endif /* (AM_CFG_STDLIB_ENABLE == 1) */
 
-#if ((AM_CFG_SOFTIMER_ENABLE == 1) || (AM_CFG_KEY_GPIO_ENABLE == 1))
+#if (AM_CFG_SYSTEM_TICKLESS_ENABLE == 1)
+    am_system_tick_softimer_tickless_inst_init();
+#elif ((AM_CFG_SOFTIMER_ENABLE == 1) || (AM_CFG_KEY_GPIO_ENABLE == 1))
     am_system_tick_softimer_inst_init();
 #elif (AM_CFG_SYSTEM_TICK_ENABLE == 1)
     am_system_tick_inst_init();
-#endif /* ((AM_CFG_SOFTIMER_ENABLE == 1) || (AM_CFG_KEY_GPIO_ENABLE == 1)) */
+#endif /* (AM_CFG_SYSTEM_TICKLESS_ENABLE == 1) */
 
     /* ʱʹ ϵͳδĶʱ (ʱ SYSTICK) */
 #if (AM_CFG_DELAY_ENABLE == 1)
@@ -110,6 +125,10 @@ void am_board_init (void)
     am_bsp_isr_defer_pendsv_init();
 #endif /* (AM_CFG_ISR_DEFER_ENABLE == 1) */
 
+#if (AM_CFG_WAIT_SLEEP_ENABLE == 1)
+    am_wait_idle_set(__wait_idle_sleep, NULL);
+#endif /* (AM_CFG_WAIT_SLEEP_ENABLE == 1) */
+
     /* ݴ */
 }
 
@@ -17,6 +17,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add ISR execution time statistics.
  * - 1.00 15-01-29  hbt, first implementation.
  * \endinternal
  */
@@ -49,6 +50,29 @@ static struct am_arm_nvic_isr_info __nvic_isr_infor[__ISRINFO_COUNT];
  *        λõӳ䣬СһMCUֵ֧жϸȡ
  */
 static uint8_t __nvic_isr_map[INUM_INTERNAL_COUNT];
+
+/**
+ * \brief ISR ͳ
+ *        жϰ˳ռ ISR Ϣǰ __ISRSTAT_COUNT ӵжͳ
+ *        ִʱ䣨//ƽʱ估ֱͼÿԼռ 44 ֽڣ
+ *        Ϊ 0 ͳơ
+ */
+#define __ISRSTAT_COUNT    8
+
+#if (__ISRSTAT_COUNT > 0)
+
+/**
+ * \brief 洢жִʱͳ
+ */
+static am_arm_nvic_isr_stat_t __nvic_isr_stat[__ISRSTAT_COUNT];
+
+#define __NVIC_ISR_STAT    __nvic_isr_stat
+
+#else
+
+#define __NVIC_ISR_STAT    NULL
+
+#endif
  
 
 /** \brief ж豸Ϣ */
@@ -77,6 +101,8 @@ static const am_arm_nvic_devinfo_t __g_nvic_devinfo =
     __nvic_isr_map,        /**< \brief ISR Ϣӳ(С input_cnt һ) */
     __ISRINFO_COUNT,       /**< \brief ISR Ϣ */
     __nvic_isr_infor,      /**< \brief ISR Ϣӳڴ(С isrinfo_cnt һ) */
+    __ISRSTAT_COUNT,       /**< \brief ISR ͳ */
+    __NVIC_ISR_STAT,       /**< \brief ISR ͳڴ(С isrstat_cnt һ) */
 
     NULL,                  /**< \brief ƽ̨ʼ */
     NULL                   /**< \brief ƽ̨ȥʼ */
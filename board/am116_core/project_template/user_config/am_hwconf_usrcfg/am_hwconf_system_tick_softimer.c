@@ -25,9 +25,11 @@
 #include "am_timer.h"
 #include "am_softimer.h"
 #include "am_system.h"
+#include "am_timestamp.h"
 #include "am_arm_nvic.h"
 #include "am_arm_systick.h"
 #include "am_zlg116_inst_init.h"
+#include "am_bsp_system_tickless.h"
 
 /**
  * \addtogroup am_if_src_hwconf_system_tick_softimer
@@ -45,6 +47,7 @@
 /** \brief ʱصڲϵͳδ */
 am_local void __system_tick_callback (void *p_arg)
 {
+    am_timestamp_module_rollover();
     am_system_module_tick();       /* ϵͳδ */
 }
 
@@ -67,6 +70,12 @@ void am_system_tick_inst_init (void)
         am_system_module_init(__SYSTEM_TICK_RATE);
 
         am_timer_enable(handle, 0, clk_freq / __SYSTEM_TICK_RATE);
+
+        /* ʱ SYSTICK ֵϵͳδж϶ */
+        am_timestamp_module_init(handle,
+                                 0,
+                                 am_arm_systick_int_pending_get,
+                                 NULL);
     }
 }
 
@@ -75,6 +84,7 @@ void am_system_tick_inst_init (void)
 /** \brief ʱصڲϵͳδʱȵ */
 am_local void __system_tick_softimer_callback (void *p_arg)
 {
+    am_timestamp_module_rollover();
     am_system_module_tick();       /* ϵͳδ */
     am_softimer_module_tick();     /* ʱ */
 }
@@ -104,6 +114,72 @@ void am_system_tick_softimer_inst_init (void)
          * ע֮ǰ
          */
         am_timer_enable_us(handle, 0, 1000000 / __SYSTEM_TICK_RATE);
+
+        /* ʱ SYSTICK ֵϵͳδж϶ */
+        am_timestamp_module_init(handle,
+                                 0,
+                                 am_arm_systick_int_pending_get,
+                                 NULL);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * \brief ޽ĶʱļƵƵ֮
+ *
+ * ֵԽöʱʱԽСοߵĽԽ٣
+ * TIM2 Ϊ 16 λʱֵΪ 16 ʱ 4095 
+ */
+#define __SYSTEM_TICKLESS_CYCLES_PER_TICK    16
+
+/** \brief SYSTICK ص޽ģʽ½ʱ */
+am_local void __timestamp_callback (void *p_arg)
+{
+    am_timestamp_module_rollover();
+}
+
+/** \brief ϵͳδʵʼ(ʹʱ޽ģʽ) */
+void am_system_tick_softimer_tickless_inst_init (void)
+{
+    am_timer_handle_t handle    = am_zlg116_tim2_timing_inst_init();
+    am_timer_handle_t ts_handle = am_zlg116_systick_inst_init();
+
+    /*
+     * TIM2 ļᱻãʱ SYSTICKʱΪֵ
+     * жϴʱͬʹøöʱ
+     */
+    if (NULL != ts_handle) {
+
+        am_arm_nvic_priority_set(SysTick_IRQn, 0x03, 0x03);
+
+        am_timer_callback_set(ts_handle, 0, __timestamp_callback, NULL);
+
+        am_timer_enable(ts_handle, 0, 0xFFFFFF);
+
+        am_timestamp_module_init(ts_handle,
+                                 0,
+                                 am_arm_systick_int_pending_get,
+                                 NULL);
+    }
+
+    if (NULL != handle) {
+
+        uint32_t clkin_freq;
+
+        am_timer_clkin_freq_get(handle, &clkin_freq);
+
+        am_timer_prescale_set(handle,
+                              0,
+                              clkin_freq / (__SYSTEM_TICK_RATE *
+                                            __SYSTEM_TICKLESS_CYCLES_PER_TICK));
+
+        /* ʼʱ */
+        am_softimer_module_init(__SYSTEM_TICK_RATE);
+
+        am_system_module_init(__SYSTEM_TICK_RATE);
+
+        am_bsp_system_tickless_init(handle, 0, __SYSTEM_TICK_RATE);
     }
 }
 
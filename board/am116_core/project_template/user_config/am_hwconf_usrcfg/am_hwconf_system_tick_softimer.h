@@ -39,6 +39,13 @@ void am_system_tick_inst_init (void);
  */
 void am_system_tick_softimer_inst_init (void);
 
+/**
+ * \brief ϵͳδʵʼ(ʹʱ޽ģʽ)
+ *
+ * \note ʹ TIM2 Ϊ޽Ķʱʱ TIM2 ;
+ */
+void am_system_tick_softimer_tickless_inst_init (void);
+
 #ifdef __cplusplus
 }
 #endif
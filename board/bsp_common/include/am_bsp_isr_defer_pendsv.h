@@ -19,6 +19,8 @@
  *
  * \internal
  * \par modification history
+ * - 1.02 26-10-17  PRI_QUOTA requires a job or time budget
+ * - 1.01 26-10-17  add processing budget
  * - 1.00 12-10-23  tee, first implementation
  * \endinternal
  */
@@ -40,6 +42,37 @@ extern "C" {
  */
 #define AM_BSP_ISR_DEFER_PRIORITY_NUM     32
 
+/**
+ * \brief PendSV ÿദӳ0 ʾƣ
+ *
+ * Ϊ 0 ʱPendSV дӳŷءһԤ
+ * ʱ PendSV أʣ 1ms ʱٴδ PendSVһ
+ * ӳʱڼѭСڹ̵Ԥж塣
+ */
+#ifndef AM_BSP_ISR_DEFER_BUDGET_JOBS
+#define AM_BSP_ISR_DEFER_BUDGET_JOBS      0
+#endif
+
+/**
+ * \brief PendSV ÿδӳʱ䣨us0 ʾ
+ *
+ * ѳʼ am_timestamp ʱʹʱʱʹϵͳļʱΪһ
+ */
+#ifndef AM_BSP_ISR_DEFER_BUDGET_US
+#define AM_BSP_ISR_DEFER_BUDGET_US        0
+#endif
+
+/**
+ * \brief ÿȼÿദӳ0 ʾϸȼ
+ *
+ *  am_jobq_budget_t  pri_quota Աֻ˳PendSV Ҫ
+ * ʱԤܷأñʱͬʱ
+ * AM_BSP_ISR_DEFER_BUDGET_JOBS  AM_BSP_ISR_DEFER_BUDGET_US
+ */
+#ifndef AM_BSP_ISR_DEFER_PRI_QUOTA
+#define AM_BSP_ISR_DEFER_PRI_QUOTA        0
+#endif
+
 /**
  * \brief ISR DEFER 弶ʼжӳ PENDSV 
  */
@@ -18,6 +18,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.01 26-10-17  add am_bsp_system_heap_get().
  * - 1.00 17-08-17  tee, first implementation.
  * \endinternal
  */
@@ -25,6 +26,8 @@
 #ifndef __AM_BSP_SYSTEM_HEAP_H
 #define __AM_BSP_SYSTEM_HEAP_H
 
+#include "am_memheap.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,6 +37,13 @@ extern "C" {
  */
 void am_bsp_system_heap_init (void);
 
+/**
+ * \brief ȡϵͳѣ am_memheap_info_get()am_memheap_check() 
+ *
+ * \return ϵͳ
+ */
+struct am_memheap *am_bsp_system_heap_get (void);
+
 #ifdef __cplusplus
 }
 #endif
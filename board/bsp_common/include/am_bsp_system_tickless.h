@@ -0,0 +1,65 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ͨöʱʵֵ޽ģticklessϵͳδʱ
+ *
+ * ģʽ£ϵͳδʱҪԣ 1KHzĶʱжϣʹܳ
+ * ʱڶûʱڡ޽ģʽ£ʱֻһʱʱ
+ * жϣжһƽڼ侭нģڼ am_sys_tick_get() ͨ
+ * ȡʱǰֵõȷĽ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+#ifndef __AM_BSP_SYSTEM_TICKLESS_H
+#define __AM_BSP_SYSTEM_TICKLESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_timer.h"
+
+/**
+ * \brief ޽ģʽʼ
+ *
+ * ǰʹͬĽƵʳʼϵͳģ飨am_system_module_init()
+ * ʱģ飨am_softimer_module_init()úöʱԤƵֵ
+ * ʱļƵӦΪƵʵԽöʱʱ
+ * ԽСοߵĽԽ٣ܶʱλƣ
+ *
+ * \param[in] handle    : ʱ׼
+ * \param[in] chan      : ʹõĶʱͨ
+ * \param[in] tick_rate : Ƶ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 󣬻ʱļƵʵڽƵ
+ * \retval -AM_ENOTSUP: ʱ֧жϻܶȡǰֵ
+ *
+ * \note öʱɱģռöʱʱὫ㣬˲
+ *       am_bsp_delay_timer_init() ʹͬһʱ
+ */
+int am_bsp_system_tickless_init (am_timer_handle_t handle,
+                                 uint8_t           chan,
+                                 uint32_t          tick_rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_BSP_SYSTEM_TICKLESS_H */
+
+/* end of file */
@@ -16,6 +16,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add optional CPU load accounting.
  * - 1.00 17-11-12  tee, first implementation.
  * \endinternal
  */
@@ -25,6 +26,7 @@
 #include "am_int.h"
 #include "am_timer.h"
 #include "am_bsp_delay_timer.h"
+#include "am_cpu_load.h"
 
 /*******************************************************************************
   Local macro define
@@ -376,7 +378,13 @@ void am_bsp_delay_timer_init (am_timer_handle_t handle, uint8_t chan)
 /******************************************************************************/
 void am_mdelay (uint32_t nms)
 {
+#if (AM_CPU_LOAD_ENABLE != 0)
+    int load_prev = am_cpu_load_enter(AM_CPU_LOAD_IDLE);
+#endif
     __delay((uint64_t)nms * __g_delay_timer.freq / 1000);
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
 }
 
 /******************************************************************************/
@@ -16,6 +16,11 @@
  *
  * \internal
  * \par modification history
+ * - 1.04 26-10-17  supply the budget clock; deferred jobs are charged as JOB
+ *                  load; PRI_QUOTA alone is rejected
+ * - 1.03 26-10-17  add optional CPU load accounting
+ * - 1.02 26-10-17  add optional interrupt trace
+ * - 1.01 26-10-17  add processing budget
  * - 1.00 12-10-23  orz, first implementation
  * \endinternal
  */
@@ -23,6 +28,10 @@
 #include "ametal.h"
 #include "am_isr_defer.h"
 #include "am_bsp_isr_defer_pendsv.h"
+#include "am_softimer.h"
+#include "am_timestamp.h"
+#include "am_irq_trace.h"
+#include "am_cpu_load.h"
 
 /*******************************************************************************
   ڲ궨
@@ -34,6 +43,18 @@
 /** \brief ϵͳ쳣ȼüĴַ 0xE000ED20  */
 #define  __SHP2_ADDRESS  0xE000ED20    
 
+/** \brief ǷÿδԤ */
+#define  __ISR_DEFER_BUDGET_ENABLE  ((AM_BSP_ISR_DEFER_BUDGET_JOBS != 0) || \
+                                     (AM_BSP_ISR_DEFER_BUDGET_US   != 0) || \
+                                     (AM_BSP_ISR_DEFER_PRI_QUOTA   != 0))
+
+/* ֻʱԤԶ꣬PendSV Իᴦ */
+#if (AM_BSP_ISR_DEFER_PRI_QUOTA != 0) &&   \
+    (AM_BSP_ISR_DEFER_BUDGET_JOBS == 0) && \
+    (AM_BSP_ISR_DEFER_BUDGET_US == 0)
+#error "AM_BSP_ISR_DEFER_PRI_QUOTA needs AM_BSP_ISR_DEFER_BUDGET_JOBS or _US"
+#endif
+
 /*******************************************************************************
   ڲ
 *******************************************************************************/
@@ -43,12 +64,113 @@ static void __isr_defer_trigger (void *p_arg)
     *(volatile unsigned int *)__ICSR_ADDRESS |= 0x10000000;
 }
 
+#if __ISR_DEFER_BUDGET_ENABLE
+
+/** \brief ÿδԤ㣬ʱʱ __isr_defer_clock_update()  */
+static am_jobq_budget_t __g_isr_defer_budget = {
+    AM_BSP_ISR_DEFER_BUDGET_JOBS,
+    0,
+    NULL,
+    AM_BSP_ISR_DEFER_PRIORITY_NUM - 1,
+    AM_BSP_ISR_DEFER_PRI_QUOTA,
+};
+
+#if (AM_BSP_ISR_DEFER_BUDGET_US != 0)
+
+/** \brief ǰʹõʱƵʣ0 ʾʹϵͳ */
+static uint32_t __g_isr_defer_clock_freq;
+
+/* ʱĵ 32 λ */
+static uint32_t __isr_defer_ts_get (void)
+{
+    return (uint32_t)am_timestamp_get();
+}
+
+/* ϵͳ */
+static uint32_t __isr_defer_tick_get (void)
+{
+    return (uint32_t)am_sys_tick_get();
+}
+
+/*
+ * ѳʼ am_timestamp ʱʹʱʱʹϵͳļʱʱ
+ * ģ֮ųʼÿδǰ飬Ƶʲʱٻ
+ */
+static void __isr_defer_clock_update (void)
+{
+    uint32_t freq = am_timestamp_freq_get();
+
+    if ((__g_isr_defer_budget.pfn_time_get != NULL) &&
+        (freq == __g_isr_defer_clock_freq)) {
+        return;
+    }
+
+    __g_isr_defer_clock_freq = freq;
+
+    if (freq != 0) {
+        __g_isr_defer_budget.max_time =
+            (uint32_t)am_timestamp_from_us(AM_BSP_ISR_DEFER_BUDGET_US);
+        __g_isr_defer_budget.pfn_time_get = __isr_defer_ts_get;
+    } else {
+        __g_isr_defer_budget.max_time =
+            am_ms_to_ticks((AM_BSP_ISR_DEFER_BUDGET_US + 999) / 1000);
+        __g_isr_defer_budget.pfn_time_get = __isr_defer_tick_get;
+    }
+}
+
+#endif /* (AM_BSP_ISR_DEFER_BUDGET_US != 0) */
+
+/** \brief ԤԺٴδ PendSV ʱ */
+static am_softimer_t __g_isr_defer_resume_timer;
+
+static void __isr_defer_resume (void *p_arg)
+{
+    am_softimer_stop(&__g_isr_defer_resume_timer);
+
+    __isr_defer_trigger(p_arg);
+}
+
+#endif /* __ISR_DEFER_BUDGET_ENABLE */
+
 /*******************************************************************************
   жϴ
 *******************************************************************************/
 void PendSV_Handler (void)
 {
+#if (AM_CPU_LOAD_ENABLE != 0)
+
+    /* PendSV ֻڴжӳ̼Ϊ */
+    int      load_prev = am_cpu_load_enter(AM_CPU_LOAD_JOB);
+#endif
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    uint32_t trace_ts = am_irq_trace_enter();
+#endif
+
+#if __ISR_DEFER_BUDGET_ENABLE
+
+#if (AM_BSP_ISR_DEFER_BUDGET_US != 0)
+    __isr_defer_clock_update();
+#endif
+
+    /*
+     * ڴֱٴδ PendSV򷵻غٴν룬ѭȻò
+     * Уӳ 1ms ټʣ
+     */
+    if (am_isr_defer_job_process_budget(&__g_isr_defer_budget,
+                                        NULL) == -AM_EAGAIN) {
+        am_softimer_start(&__g_isr_defer_resume_timer, 1);
+    }
+#else
     am_isr_defer_job_process();
+#endif
+
+#if (AM_IRQ_TRACE_ENABLE != 0)
+    am_irq_trace_exit(AM_IRQ_TRACE_INUM_PENDSV, trace_ts);
+#endif
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
 }
  
 /*******************************************************************************
@@ -65,6 +187,10 @@ void am_bsp_isr_defer_pendsv_init (void)
     *(volatile unsigned int *)__SHP2_ADDRESS  |= (0xC0ul << 16);
  
     am_isr_defer_init(__isr_defer_trigger, NULL);
+
+#if __ISR_DEFER_BUDGET_ENABLE
+    am_softimer_init(&__g_isr_defer_resume_timer, __isr_defer_resume, NULL);
+#endif
 }
  
 /* end of file */
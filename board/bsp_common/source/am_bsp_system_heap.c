@@ -16,6 +16,9 @@
  *
  * \internal
  * \par modification history:
+ * - 1.03 26-10-17  tag blocks with the caller of am_mem_xxx()
+ * - 1.02 26-10-17  add am_bsp_system_heap_get()
+ * - 1.01 26-10-17  allocate aligned blocks in the heap, no extra pointer
  * - 1.00 14-06-13  zen, first implementation
  * \endinternal
  */
@@ -24,6 +27,7 @@
 #include "am_mem.h"
 #include "am_memheap.h"
 #include "am_board.h"
+#include "am_bsp_system_heap.h"
 
 #include <string.h>
 
@@ -66,46 +70,40 @@ void am_bsp_system_heap_init (void)
 #endif
 
     /* initialize a default heap in the system */
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+    am_memheap_tlsf_init(&__g_system_heap,
+                         "system_heap",
+                         (void *)heap_start,
+                         (uint32_t)heap_end - (uint32_t)heap_start);
+#else
     am_memheap_init(&__g_system_heap,
                     "system_heap",
                     (void *)heap_start,
                     (uint32_t)heap_end - (uint32_t)heap_start);
+#endif
 }
 
 /******************************************************************************/
-void *am_mem_align(size_t size, size_t align)
+struct am_memheap *am_bsp_system_heap_get (void)
 {
-    void    *align_ptr;
-    void    *ptr;
-    size_t   align_size;
-
-    /* align the alignment size to 4 byte */
-    align = AM_ROUND_UP(align, sizeof(void *));
-
-    /* get total aligned size */
-    align_size =  AM_ROUND_UP(size, sizeof(void *)) + align + sizeof(void *);
-
-    /* allocate memory block from heap */
-    ptr = am_memheap_alloc(&__g_system_heap, align_size);
-    if (ptr != NULL) {
-
-        /* round up ptr to align */
-        align_ptr = (void *)AM_ROUND_UP((uint32_t)ptr + sizeof(void *), align);
-
-        /* set the pointer before alignment pointer to the real pointer */
-        *((uint32_t *)((uint32_t)align_ptr - sizeof(void *))) = (uint32_t)ptr;
-
-        ptr = align_ptr;
-    }
+    return &__g_system_heap;
+}
 
-    return ptr;
+/******************************************************************************/
+void *am_mem_align(size_t size, size_t align)
+{
+    /* the heap splits the free block at the aligned address */
+    return am_memheap_alloc_align_tagged(&__g_system_heap,
+                                         size,
+                                         align,
+                                         AM_MEMHEAP_CALLER());
 }
 
 /******************************************************************************/
 void *am_mem_alloc(size_t size)
 {
-    /* allocate in the system heap */
-    return am_mem_align(size, 4);
+    /* allocate in the system heap, tagged with the caller of am_mem_alloc() */
+    return am_memheap_alloc_tagged(&__g_system_heap, size, AM_MEMHEAP_CALLER());
 }
 
 /******************************************************************************/
@@ -115,7 +113,9 @@ void *am_mem_calloc(size_t nelem, size_t size)
     size_t      total_size;
 
     total_size = nelem * size;
-    ptr = am_mem_alloc(total_size);
+    ptr = am_memheap_alloc_tagged(&__g_system_heap,
+                                  total_size,
+                                  AM_MEMHEAP_CALLER());
     if (ptr != NULL) {
         memset(ptr, 0, total_size);
     }
@@ -126,52 +126,26 @@ void *am_mem_calloc(size_t nelem, size_t size)
 /******************************************************************************/
 void am_mem_free(void *ptr)
 {
-    void *real_ptr = NULL;
-
-    if (ptr != NULL) {
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
-    }
-    am_memheap_free(real_ptr);
+    am_memheap_free(ptr);
 }
 
 /******************************************************************************/
 size_t am_mem_size(void *ptr)
 {
-    void *real_ptr = NULL;
-
-    if (ptr != NULL) {
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
+    if (ptr == NULL) {
+        return 0;
     }
-    return am_memheap_memsize( &__g_system_heap, real_ptr);
+    return am_memheap_memsize(&__g_system_heap, ptr);
 }
 
 /******************************************************************************/
 void *am_mem_realloc(void *ptr, size_t newsize)
 {
-    void  *real_ptr     = NULL;
-    void  *new_ptr      = NULL;
-
-    if (ptr != NULL) {
-        /* get real pointer */
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
-    } else {
-        /* equal malloc when ptr==NULL */
-        return am_mem_alloc(newsize);
-    }
-
-    /* allocate newsize plus one more pointer, used for save real pointer */
-    real_ptr = am_memheap_realloc(&__g_system_heap,
-                                  real_ptr,
-                                  newsize + sizeof(void *));
-
-    if (real_ptr != NULL) {
-        *(uint32_t *)real_ptr = (uint32_t)real_ptr;
-        new_ptr               = (void *)((size_t)real_ptr + sizeof(void *));
-    } else {
-        new_ptr = NULL;
-    }
-
-    return new_ptr;
+    /* equal malloc when ptr==NULL, equal free when newsize==0 */
+    return am_memheap_realloc_tagged(&__g_system_heap,
+                                     ptr,
+                                     newsize,
+                                     AM_MEMHEAP_CALLER());
 }
 
 /* end of file */
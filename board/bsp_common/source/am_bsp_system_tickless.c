@@ -0,0 +1,289 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ͨöʱʵֵ޽ģticklessϵͳδʱ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  silence unused p_arg warnings
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+#include "ametal.h"
+#include "am_int.h"
+#include "am_timer.h"
+#include "am_system.h"
+#include "am_softimer.h"
+#include "am_bsp_system_tickless.h"
+
+/*******************************************************************************
+  Local struct type define
+*******************************************************************************/
+
+/**
+ * \brief ޽ĶʱϢ
+ */
+static struct __tickless_timer {
+    am_timer_handle_t handle;           /**< \brief ʱ            */
+    uint8_t           chan;             /**< \brief ʱͨ                */
+    am_bool_t         announcing;       /**< \brief жƽ        */
+    uint32_t          cycles_per_tick;  /**< \brief һĶӦļֵ      */
+    uint32_t          max_ticks;        /**< \brief һʱĽ  */
+    uint32_t          period_ticks;     /**< \brief ǰʱڵĽ      */
+    uint32_t          offset;           /**< \brief ǰڿʼʱ߹ļ */
+    uint32_t          reload;           /**< \brief ǰõĶʱֵ      */
+} __g_tickless;
+
+/*******************************************************************************
+  Local Functions
+*******************************************************************************/
+
+/* ȡǰʱѾ߹ļֵ */
+static uint32_t __tickless_count_get (void)
+{
+    uint32_t count = 0;
+
+    am_timer_count_get(__g_tickless.handle, __g_tickless.chan, &count);
+
+    return count + __g_tickless.offset;
+}
+
+/******************************************************************************/
+
+/* ȡǰʱѾ߹δƽĽ */
+static uint32_t __tickless_elapsed_get (void)
+{
+    uint32_t ticks = __tickless_count_get() / __g_tickless.cycles_per_tick;
+
+    /* ѷתжϻδʣжƽ */
+    if (ticks >= __g_tickless.period_ticks) {
+        ticks = __g_tickless.period_ticks - 1;
+    }
+
+    return ticks;
+}
+
+/******************************************************************************/
+static am_tick_t __system_elapsed_get (void *p_arg)
+{
+    (void)p_arg;
+
+    return (am_tick_t)__tickless_elapsed_get();
+}
+
+/******************************************************************************/
+static unsigned int __softimer_elapsed_get (void *p_arg)
+{
+    (void)p_arg;
+
+    return (unsigned int)__tickless_elapsed_get();
+}
+
+/******************************************************************************/
+
+/*
+ * ʼһµĶʱڣcount ΪڿʼʱѾ߹ļֵ
+ *
+ * ոշתʱrestart Ϊ AM_FALSEʱֵδı貹߹
+ * öʱɶʱԶأκ
+ */
+static void __tickless_period_start (uint32_t  ticks,
+                                     uint32_t  count,
+                                     am_bool_t restart)
+{
+    uint32_t reload = ticks * __g_tickless.cycles_per_tick - 1 - count;
+
+    __g_tickless.period_ticks = ticks;
+    __g_tickless.offset       = count;
+
+    if (restart || (count != 0) || (reload != __g_tickless.reload)) {
+        __g_tickless.reload = reload;
+        am_timer_enable(__g_tickless.handle, __g_tickless.chan, reload);
+    }
+}
+
+/******************************************************************************/
+
+/* һʱڵʱ̣õһʱڵĽ */
+static uint32_t __tickless_next_ticks_get (uint32_t count)
+{
+    uint32_t ticks = am_softimer_module_next_ticks_get();
+
+    if (ticks > __g_tickless.max_ticks) {
+        ticks = __g_tickless.max_ticks;
+    }
+
+    /* ߹ļһεڵʱ̣컽 */
+    if (ticks * __g_tickless.cycles_per_tick <= count) {
+        ticks = count / __g_tickless.cycles_per_tick + 1;
+    }
+
+    return ticks;
+}
+
+/******************************************************************************/
+
+/*
+ * ƽģһʱڵʱ̿ʼµĶʱ
+ *
+ * ǰжϣkey Ϊ am_int_cpu_lock() ķֵǰʱ
+ * صִʱܳһʱڣƽǰȽʱΪ
+ * ֵصִڼתʧġ
+ */
+static void __tickless_announce (uint32_t  ticks,
+                                 uint32_t  count,
+                                 am_bool_t restart,
+                                 int       key)
+{
+    __tickless_period_start(__g_tickless.max_ticks, count, restart);
+
+    __g_tickless.announcing = AM_TRUE;
+
+    am_int_cpu_unlock(key);
+
+    if (ticks > 0) {
+        am_system_module_announce(ticks);
+        am_softimer_module_announce(ticks);
+    }
+
+    key = am_int_cpu_lock();
+
+    __g_tickless.announcing = AM_FALSE;
+
+    /* ʱصִڼ䣬Ѿ߹ļ */
+    count = __tickless_count_get();
+
+    __tickless_period_start(__tickless_next_ticks_get(count), count, AM_FALSE);
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+
+/* ʱڽƽڵн */
+static void __tickless_timer_callback (void *p_arg)
+{
+    int key;
+
+    (void)p_arg;
+
+    key = am_int_cpu_lock();
+
+    /* Ѿתڴӵǰֵʼ */
+    __g_tickless.offset = 0;
+
+    __tickless_announce(__g_tickless.period_ticks,
+                        __tickless_count_get(),
+                        AM_FALSE,
+                        key);
+}
+
+/******************************************************************************/
+
+/* µʱ䵽ʱڵǰڽʱ̣ǰǰ */
+static void __softimer_update (void *p_arg)
+{
+    uint32_t count;
+    uint32_t elapsed;
+    int      key;
+
+    (void)p_arg;
+
+    key = am_int_cpu_lock();
+
+    /* ƽڼĶʱƽɺͳһ */
+    if ((!__g_tickless.announcing) &&
+        (am_softimer_module_next_ticks_get() < __g_tickless.period_ticks)) {
+
+        count   = __tickless_count_get();
+        elapsed = count / __g_tickless.cycles_per_tick;
+
+        /* ѷתʱɼִежϴ */
+        if (elapsed < __g_tickless.period_ticks) {
+
+            /* ߹ƽһĵļв */
+            __tickless_announce(elapsed,
+                                count - elapsed * __g_tickless.cycles_per_tick,
+                                AM_TRUE,
+                                key);
+            return;
+        }
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/*******************************************************************************
+  Public Functions
+*******************************************************************************/
+
+int am_bsp_system_tickless_init (am_timer_handle_t handle,
+                                 uint8_t           chan,
+                                 uint32_t          tick_rate)
+{
+    const am_timer_info_t *p_info = NULL;
+    uint32_t               freq   = 0;
+    uint32_t               max_count;
+
+    if ((NULL == handle) || (0 == tick_rate)) {
+        return -AM_EINVAL;
+    }
+
+    p_info = am_timer_info_get(handle);
+
+    if ((!(AM_TIMER_CAN_INTERRUPT & p_info->features)) ||
+        (!(AM_TIMER_INTERMEDIATE_COUNT & p_info->features)) ||
+        (AM_TIMER_STOP_WHILE_READ & p_info->features) ||
+        (AM_TIMER_CANNOT_MODIFY_ROLLOVER & p_info->features)) {
+        return -AM_ENOTSUP;
+    }
+
+    if (chan >= p_info->chan_num) {
+        return -AM_EINVAL;
+    }
+
+    am_timer_count_freq_get(handle, chan, &freq);
+
+    if (freq < tick_rate) {
+        return -AM_EINVAL;
+    }
+
+    if (p_info->counter_width >= 32) {
+        max_count = 0xFFFFFFFF;
+    } else {
+        max_count = (1ul << p_info->counter_width) - 1;
+    }
+
+    __g_tickless.handle          = handle;
+    __g_tickless.chan            = chan;
+    __g_tickless.announcing      = AM_FALSE;
+    __g_tickless.cycles_per_tick = freq / tick_rate;
+    __g_tickless.max_ticks       = max_count / __g_tickless.cycles_per_tick;
+    __g_tickless.period_ticks    = 0;
+    __g_tickless.offset          = 0;
+    __g_tickless.reload          = 0;
+
+    am_system_module_tickless_set(__system_elapsed_get, NULL);
+    am_softimer_module_tickless_set(__softimer_elapsed_get,
+                                    __softimer_update,
+                                    NULL);
+
+    am_timer_callback_set(handle, chan, __tickless_timer_callback, NULL);
+
+    __tickless_period_start(__tickless_next_ticks_get(0), 0, AM_TRUE);
+
+    return AM_OK;
+}
+
+/* end of file */
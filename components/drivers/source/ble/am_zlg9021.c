@@ -16,9 +16,12 @@
  *
  * \internal
  * \par Modification History
+ * - 1.01 26-10-17  use leveled log macros.
  * - 1.00 16-09-06  tee, first implementation.
  * \endinternal
  */
+#define AM_LOG_MODULE   AM_LOG_MOD_DRV
+
 #include "ametal.h"
 #include "am_zlg9021.h"
 #include "am_gpio.h"
@@ -769,9 +772,9 @@ am_local int __zlg9021_cmd_result_info_get (am_zlg9021_dev_t    *p_this,
 
     p_this->p_cmd_rxbuf[p_this->cmd_rx_len] = '\0';
 
-    AM_DBG_INFO("ack is %d bytes : \r\n%s",
-                p_this->cmd_rx_len,
-                p_this->p_cmd_rxbuf);
+    AM_LOGD("ack is %d bytes : \r\n%s",
+            p_this->cmd_rx_len,
+            p_this->p_cmd_rxbuf);
 
     /* Only the "RST-SYSTEMRESET" needn't check */
     if (need_check) {
@@ -19,6 +19,7 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  use leveled log macros.
  * - 1.00 15-09-14  tee, first implementation.
  * \endinternal
  */
@@ -26,6 +27,8 @@
 /*******************************************************************************
   includes
 *******************************************************************************/
+#define AM_LOG_MODULE   AM_LOG_MOD_DRV
+
 #include "ametal.h"
 #include "am_vdebug.h"
 #include "am_mx25xx.h"
@@ -496,9 +499,9 @@ am_mx25xx_handle_t am_mx25xx_init (am_mx25xx_dev_t           *p_dev,
 
     if (id != p_devinfo->type.id) {
 
-        AM_DBG_INFO("The id is %x, not your choice chip(id=%x)",
-                    id,
-                    p_devinfo->type.id);
+        AM_LOGE("The id is %x, not your choice chip(id=%x)",
+                id,
+                p_devinfo->type.id);
 
         return NULL;
     }
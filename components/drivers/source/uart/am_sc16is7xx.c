@@ -79,10 +79,13 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-17  use leveled log macros
  * - 1.00 18-05-22  pea, first implementation
  * \endinternal
  */
 
+#define AM_LOG_MODULE   AM_LOG_MOD_DRV
+
 #include "ametal.h"
 #include "am_sc16is7xx.h"
 #include "am_int.h"
@@ -300,7 +303,7 @@ am_local void __i2c_complete (void *p_arg)
     am_int_cpu_unlock(key);
 
     if (0 != p_dev->sm_cnt[*p_chan]) {
-        AM_DBG_INFO("i2c %d sm_cnt: %d\r\n", *p_chan, p_dev->sm_cnt[*p_chan]);
+        AM_LOGD("i2c %d sm_cnt: %d\r\n", *p_chan, p_dev->sm_cnt[*p_chan]);
     }
 
     /* ¼״̬ */
@@ -334,7 +337,7 @@ am_local void __irq_pint_isr (void *p_arg)
         }
 
         if (0 != p_dev->sm_cnt[i]) {
-            AM_DBG_INFO("isr %d sm_cnt: %d\r\n", i, p_dev->sm_cnt);
+            AM_LOGD("isr %d sm_cnt: %d\r\n", i, p_dev->sm_cnt);
         }
 
         /* ¼״̬ */
@@ -1571,7 +1574,7 @@ am_sc16is7xx_handle_t am_sc16is7xx_init (am_sc16is7xx_dev_t           *p_dev,
         err |= am_gpio_trigger_cfg(p_devinfo->irq_pin, AM_GPIO_TRIGGER_FALL);
         err |= am_gpio_trigger_off(p_dev->p_devinfo->irq_pin);
         if (AM_OK != err) {
-            AM_DBG_INFO("gpio trigger init failed %d!\r\n", err);
+            AM_LOGE("gpio trigger init failed %d!\r\n", err);
             return NULL;
         }
     } else {
@@ -1585,13 +1588,13 @@ am_sc16is7xx_handle_t am_sc16is7xx_init (am_sc16is7xx_dev_t           *p_dev,
         err |= __reg_write(p_dev, i, SC16IS7XX_REG_EFR, SC16IS7XX_EFR_ENHANCE_EN_BIT);
         err |= __general_access_enable(p_dev, i);
         if (AM_OK != err) {
-            AM_DBG_INFO("enhance enable failed %d!\r\n", err);
+            AM_LOGE("enhance enable failed %d!\r\n", err);
             return NULL;
         }
 
         err |= __reg_write(p_dev, i, SC16IS7XX_REG_FCR, SC16IS7XX_FCR_FIFO_EN_BIT);
         if (AM_OK != err) {
-            AM_DBG_INFO("fifo enable failed %d!\r\n", err);
+            AM_LOGE("fifo enable failed %d!\r\n", err);
             return NULL;
         }
 
@@ -1621,14 +1624,14 @@ am_sc16is7xx_handle_t am_sc16is7xx_init (am_sc16is7xx_dev_t           *p_dev,
         /* ôѡ */
         err = __serial_opts_set(p_dev, i, p_dev->serial_opts[i]);
         if (AM_OK != err) {
-            AM_DBG_INFO("serial opts set failed %d!\r\n", err);
+            AM_LOGE("serial opts set failed %d!\r\n", err);
             return NULL;
         }
 
         /* ò */
         err = __serial_rate_set(p_dev, i, p_devinfo->serial_rate[i]);
         if (AM_OK != err) {
-            AM_DBG_INFO("serial rate set failed %d!\r\n", err);
+            AM_LOGE("serial rate set failed %d!\r\n", err);
             return NULL;
         }
     }
@@ -16,6 +16,8 @@
  *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-17  command and response buffers are taken from a scratch arena
+ *                  instead of the stack
  * - 1.01 18-01-16  pea, update API to v1.03 manual
  * - 1.00 15-09-06  afm, first implementation
  * \endinternal
@@ -26,6 +28,7 @@
 #include "am_gpio.h"
 #include "am_delay.h"
 #include "am_int.h"
+#include "am_arena.h"
 #include <string.h>
 
 #define __ZM516X_CFG_TAG    "\xAB\xBC\xCD"    /**< \brief ֡֡ͷ */
@@ -37,6 +40,21 @@
 #define __ZM516X_RSP_BUF_LEN       100    /**< \brief Ӧ𻺴泤 */
 #define __ZM516X_CMD_SPACE_TIME    5      /**< \brief ֡ʱ䣬λms */
 
+/** \brief ʱڴСӦ𻺴ָС룩 */
+#define __ZM516X_SCRATCH_SIZE  (AM_ROUND_UP(__ZM516X_CMD_BUF_LEN, sizeof(void *)) + \
+                                AM_ROUND_UP(__ZM516X_RSP_BUF_LEN, sizeof(void *)))
+
+/**
+ * \brief Ӧ𻺴ڵʱڴ ZM516X ʵ
+ *
+ * ÿӦ𻺴ڷǰ䡢ǰͷţռõߵջ
+ * ֻ񣨷жϣ˳ãam_zm516x_cfg_info_set() 
+ * ڲǶ׵ am_zm516x_cfg_info_get() ʱͷţͬһʱֻһ黺
+ */
+am_local void           *__g_zm516x_scratch_mem[__ZM516X_SCRATCH_SIZE /
+                                                sizeof(void *)];
+am_local struct am_arena __g_zm516x_scratch;
+
 /** \brief ò */
 enum __ZM516X_CFG_CMD {
     ZM516X_CFG_CONFIG_GET       = 0xD1,    /**< \brief ȡ */
@@ -101,6 +119,52 @@ am_local void __ack_pint_isr (void *p_arg)
     am_wait_done(&p_dev->ack_wait);
 }
 
+/**
+ * \brief ʱڴ漰Ӧ𻺴棨㣩
+ *
+ * \param[out] p_mark  : ǰλã __zm516x_buf_free()
+ * \param[out] pp_cmd  : 棬 __ZM516X_CMD_BUF_LEN
+ * \param[out] pp_rsp  : Ӧ𻺴棬 __ZM516X_RSP_BUF_LENNULL ʾҪ
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_ENOMEM : ʱڴռ䲻㣨δ am_zm516x_init() Ƕʹã
+ */
+am_local am_err_t __zm516x_buf_alloc (am_arena_mark_t  *p_mark,
+                                      uint8_t         **pp_cmd,
+                                      uint8_t         **pp_rsp)
+{
+    *p_mark = am_arena_mark(&__g_zm516x_scratch);
+
+    *pp_cmd = (uint8_t *)am_arena_alloc(&__g_zm516x_scratch,
+                                        __ZM516X_CMD_BUF_LEN);
+    if (*pp_cmd == NULL) {
+        return -AM_ENOMEM;
+    }
+    memset(*pp_cmd, 0, __ZM516X_CMD_BUF_LEN);
+
+    if (pp_rsp != NULL) {
+        *pp_rsp = (uint8_t *)am_arena_alloc(&__g_zm516x_scratch,
+                                            __ZM516X_RSP_BUF_LEN);
+        if (*pp_rsp == NULL) {
+            am_arena_reset_to(&__g_zm516x_scratch, *p_mark);
+            return -AM_ENOMEM;
+        }
+        memset(*pp_rsp, 0, __ZM516X_RSP_BUF_LEN);
+    }
+
+    return AM_OK;
+}
+
+/**
+ * \brief ͷ __zm516x_buf_alloc() Ļ棬 ret return ʹ
+ */
+am_local am_err_t __zm516x_buf_free (am_arena_mark_t mark, am_err_t ret)
+{
+    am_arena_reset_to(&__g_zm516x_scratch, mark);
+
+    return ret;
+}
+
 /** \brief  ZigBee  */
 am_local am_bool_t am_zm516x_send_cmd (am_uart_rngbuf_handle_t  rngbuf_handle,
                                        uint8_t                 *p_cmd,
@@ -211,14 +275,19 @@ am_err_t am_zm516x_cfg_info_get (am_zm516x_handle_t    handle,
                                  am_zm516x_cfg_info_t *p_info)
 {
     am_zm516x_dev_t *p_dev                         = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_info)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_CONFIG_GET;
     cmd_buf[4] = __ZM516X_CFG_END;
@@ -230,29 +299,34 @@ am_err_t am_zm516x_cfg_info_get (am_zm516x_handle_t    handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_CONFIG_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         memcpy(p_info, &rsp_buf[4], sizeof(am_zm516x_cfg_info_t));
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief  ZigBee ģͨţD2 */
 am_err_t am_zm516x_cfg_channel_set (am_zm516x_handle_t handle, uint8_t chan)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_CHAN_SET;
     cmd_buf[4] = chan;
@@ -265,17 +339,17 @@ am_err_t am_zm516x_cfg_channel_set (am_zm516x_handle_t handle, uint8_t chan)
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_CHAN_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ģ飨D4 */
@@ -288,8 +362,9 @@ am_err_t am_zm516x_discover (am_zm516x_handle_t     handle,
     uint8_t          i                             = 0;
     uint8_t          num                           = 0;
     uint8_t          pack_size                     = 0;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_base_info) || (NULL == p_get_size)) {
@@ -298,6 +373,10 @@ am_err_t am_zm516x_discover (am_zm516x_handle_t     handle,
 
     pack_size = sizeof(am_zm516x_base_info_t) + 4;
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_DISCOVER;
     cmd_buf[4] = __ZM516X_CFG_END;
@@ -315,10 +394,10 @@ am_err_t am_zm516x_discover (am_zm516x_handle_t     handle,
 
         for (i = 0; i < num; i++) {
             if (memcmp(rsp_buf + pack_size * i, __ZM516X_CFG_TAG, 3) != 0) {
-                return -AM_EPERM;
+                return __zm516x_buf_free(mark, -AM_EPERM);
             }
             if (rsp_buf[pack_size * i + 3] != ZM516X_CFG_DISCOVER) {
-                return -AM_EPERM;
+                return __zm516x_buf_free(mark, -AM_EPERM);
             }
             memcpy(p_base_info + i,
                   &rsp_buf[pack_size * i + 4],
@@ -326,9 +405,9 @@ am_err_t am_zm516x_discover (am_zm516x_handle_t     handle,
             (*p_get_size)++;
         }
 
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡԶϢD5 */
@@ -337,8 +416,9 @@ am_err_t am_zm516x_remote_info_get (am_zm516x_handle_t       handle,
                                     am_zm516x_remote_info_t *p_remote_info)
 {
     am_zm516x_dev_t *p_dev                         = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr) || (NULL == p_remote_info)) {
@@ -349,6 +429,10 @@ am_err_t am_zm516x_remote_info_get (am_zm516x_handle_t       handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_REMOTE_GET;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -362,15 +446,15 @@ am_err_t am_zm516x_remote_info_get (am_zm516x_handle_t       handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_REMOTE_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         memcpy(p_remote_info, &rsp_buf[4], sizeof(am_zm516x_remote_info_t));
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ޸ ZigBee ģϢD6óɹ踴λ */
@@ -379,8 +463,9 @@ am_err_t am_zm516x_cfg_info_set (am_zm516x_handle_t    handle,
 {
     am_zm516x_dev_t     *p_dev = (am_zm516x_dev_t *)handle;
     am_zm516x_cfg_info_t zb_info;
-    uint8_t              cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t              rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t             *cmd_buf;
+    uint8_t             *rsp_buf;
+    am_arena_mark_t      mark;
     uint16_t             rsp_len;
 
     if ((NULL == handle) || (NULL == p_info)) {
@@ -391,6 +476,10 @@ am_err_t am_zm516x_cfg_info_set (am_zm516x_handle_t    handle,
         return -AM_EPERM;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_CONFIG_SET;
     cmd_buf[4] = zb_info.my_addr[0];
@@ -405,17 +494,17 @@ am_err_t am_zm516x_cfg_info_set (am_zm516x_handle_t    handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_CONFIG_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ʹ ZigBee ģ鸴λD9 */
@@ -423,13 +512,18 @@ void am_zm516x_reset (am_zm516x_handle_t handle)
 {
     am_zm516x_dev_t     *p_dev = (am_zm516x_dev_t *)handle;
     am_zm516x_cfg_info_t zb_info;
-    uint8_t              cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
+    uint8_t             *cmd_buf;
+    am_arena_mark_t      mark;
     uint16_t             rsp_len;
 
     if (am_zm516x_cfg_info_get(handle, &zb_info) != AM_OK) {
         return;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, NULL) != AM_OK) {
+        return;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_RESET;
     cmd_buf[4] = zb_info.my_addr[0];
@@ -439,6 +533,7 @@ void am_zm516x_reset (am_zm516x_handle_t handle)
     cmd_buf[8] = __ZM516X_CFG_END;
 
     am_zm516x_send_cmd(p_dev->uart_handle, cmd_buf, 9, NULL, &rsp_len, 50);
+    __zm516x_buf_free(mark, AM_OK);
     am_mdelay(200);
 }
 
@@ -447,14 +542,19 @@ am_err_t am_zm516x_default_set (am_zm516x_handle_t handle)
 {
     am_zm516x_dev_t     *p_dev = (am_zm516x_dev_t *)handle;
     am_zm516x_cfg_info_t zb_info;
-    uint8_t              cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t              rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t             *cmd_buf;
+    uint8_t             *rsp_buf;
+    am_arena_mark_t      mark;
     uint16_t             rsp_len;
 
     if (am_zm516x_cfg_info_get(handle, &zb_info) != AM_OK) {
         return -AM_EPERM;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_REDEFAULT;
     cmd_buf[4] = zb_info.my_addr[0];
@@ -470,17 +570,17 @@ am_err_t am_zm516x_default_set (am_zm516x_handle_t handle)
                           &rsp_len,
                            70) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_REDEFAULT) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[8] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /**
@@ -492,8 +592,9 @@ am_err_t am_zm516x_cfg_display_head_set (am_zm516x_handle_t handle,
                                          am_bool_t          flag)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
@@ -504,6 +605,10 @@ am_err_t am_zm516x_cfg_display_head_set (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_SRC_DIS;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -518,20 +623,20 @@ am_err_t am_zm516x_cfg_display_head_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_SRC_DIS) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ַָ ZigBee ģ GPIO E1 */
@@ -540,8 +645,9 @@ am_err_t am_zm516x_cfg_gpio_dir_set (am_zm516x_handle_t handle,
                                      uint8_t            dir)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
@@ -552,6 +658,10 @@ am_err_t am_zm516x_cfg_gpio_dir_set (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_GPIO_DIR;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -567,23 +677,23 @@ am_err_t am_zm516x_cfg_gpio_dir_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_GPIO_DIR) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != dir) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[7] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģ GPIO E1 */
@@ -592,8 +702,9 @@ am_err_t am_zm516x_cfg_gpio_dir_get (am_zm516x_handle_t handle,
                                      uint8_t           *p_dir)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr) || (NULL == p_dir)) {
@@ -604,6 +715,10 @@ am_err_t am_zm516x_cfg_gpio_dir_get (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_GPIO_DIR;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -619,21 +734,21 @@ am_err_t am_zm516x_cfg_gpio_dir_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_GPIO_DIR) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[7] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         *p_dir = rsp_buf[6];
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief IO/AD ɼãE2óɹ踴λ */
@@ -644,8 +759,9 @@ am_err_t am_zm516x_cfg_io_adc_upload_set (am_zm516x_handle_t handle,
                                           am_bool_t          is_dormant)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
@@ -656,6 +772,10 @@ am_err_t am_zm516x_cfg_io_adc_upload_set (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_IO_ADC_UPLOAD;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -674,30 +794,30 @@ am_err_t am_zm516x_cfg_io_adc_upload_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_IO_ADC_UPLOAD) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != dir) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if ((rsp_buf[7] != AM_BITS_GET(period, 8, 8)) ||
             (rsp_buf[8] != AM_BITS_GET(period, 0, 8))){
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[9] != ((is_dormant != AM_FALSE) ? 1 : 0)) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[10] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief IO/AD ɼûȡE2 */
@@ -708,8 +828,9 @@ am_err_t am_zm516x_cfg_io_adc_upload_get (am_zm516x_handle_t handle,
                                           uint8_t           *p_is_dormant)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
@@ -720,6 +841,10 @@ am_err_t am_zm516x_cfg_io_adc_upload_get (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_IO_ADC_UPLOAD;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -735,16 +860,16 @@ am_err_t am_zm516x_cfg_io_adc_upload_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_IO_ADC_UPLOAD) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[10] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         if (NULL != p_dir) {
@@ -756,9 +881,9 @@ am_err_t am_zm516x_cfg_io_adc_upload_get (am_zm516x_handle_t handle,
         if (NULL != p_is_dormant) {
             *p_is_dormant = rsp_buf[9];
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ַָ ZigBee ģ GPIO ֵE3 */
@@ -767,8 +892,9 @@ am_err_t am_zm516x_cfg_gpio_set (am_zm516x_handle_t handle,
                                  uint8_t            value)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
@@ -779,6 +905,10 @@ am_err_t am_zm516x_cfg_gpio_set (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_GPIO_STATE;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -794,23 +924,23 @@ am_err_t am_zm516x_cfg_gpio_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_GPIO_STATE) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != value) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[7] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģ GPIO ֵE3 */
@@ -819,8 +949,9 @@ am_err_t am_zm516x_cfg_gpio_get (am_zm516x_handle_t handle,
                                  uint8_t           *p_value)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr) || (NULL == p_value)) {
@@ -831,6 +962,10 @@ am_err_t am_zm516x_cfg_gpio_get (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_GPIO_STATE;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -846,22 +981,22 @@ am_err_t am_zm516x_cfg_gpio_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_GPIO_STATE) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[7] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         *p_value = rsp_buf[6];
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ַָ ZigBee ģ PWM ֵE4 */
@@ -870,8 +1005,9 @@ am_err_t am_zm516x_cfg_pwm_set (am_zm516x_handle_t handle,
                                 am_zm516x_pwm_t   *p_pwm)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
     uint16_t         i;
     uint32_t         temp;
@@ -884,6 +1020,10 @@ am_err_t am_zm516x_cfg_pwm_set (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_PWM;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -906,13 +1046,13 @@ am_err_t am_zm516x_cfg_pwm_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_PWM) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         for (i = 0; i < 4; i++) {
@@ -920,16 +1060,16 @@ am_err_t am_zm516x_cfg_pwm_set (am_zm516x_handle_t handle,
             temp = AM_LONGSWAP(temp);
             if ((memcmp(rsp_buf + 5 * i + 6, &temp, 4) != 0) ||
                 (rsp_buf[5 * i + 10] != (p_pwm + i)->duty_cycle)) {
-                return -AM_EPERM;
+                return __zm516x_buf_free(mark, -AM_EPERM);
             }
         }
 
         if (rsp_buf[26] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģ PWM ֵãE4 */
@@ -938,8 +1078,9 @@ am_err_t am_zm516x_cfg_pwm_get (am_zm516x_handle_t handle,
                                 am_zm516x_pwm_t   *p_pwm)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
     uint16_t         i;
 
@@ -951,6 +1092,10 @@ am_err_t am_zm516x_cfg_pwm_get (am_zm516x_handle_t handle,
         return -AM_EFAULT;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_PWM;
     cmd_buf[4] = p_zb_addr->p_addr[0];
@@ -966,16 +1111,16 @@ am_err_t am_zm516x_cfg_pwm_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_PWM) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (memcmp(rsp_buf + 4, p_zb_addr->p_addr, 2) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[26] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         for (i = 0; i < 4; i++) {
@@ -983,9 +1128,9 @@ am_err_t am_zm516x_cfg_pwm_get (am_zm516x_handle_t handle,
             (p_pwm + i)->duty_cycle = rsp_buf[5 * i + 11];
         }
 
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ܣE5óɹ踴λ */
@@ -994,14 +1139,19 @@ am_err_t am_zm516x_cfg_network_set (am_zm516x_handle_t handle,
                                     uint8_t            type)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_NETWORK_SET;
     cmd_buf[4] = (state != AM_FALSE) ? 1 : 0;
@@ -1015,23 +1165,23 @@ am_err_t am_zm516x_cfg_network_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_NETWORK_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ((state != AM_FALSE) ? 1 : 0)) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[5] != type) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ӻ磨E6 */
@@ -1039,14 +1189,19 @@ am_err_t am_zm516x_cfg_join_enable (am_zm516x_handle_t handle,
                                     uint16_t           time)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_JOIN_ENABLE;
     cmd_buf[4] = AM_BITS_GET(time, 8, 8);
@@ -1060,21 +1215,21 @@ am_err_t am_zm516x_cfg_join_enable (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_JOIN_ENABLE) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if ((rsp_buf[4] != AM_BITS_GET(time, 8, 8)) ||
             (rsp_buf[5] != AM_BITS_GET(time, 0, 8))){
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[6] != ZM516X_CFG_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ѯģ洢ĴӻϢE7 */
@@ -1084,14 +1239,19 @@ am_err_t am_zm516x_cfg_slave_get (am_zm516x_handle_t      handle,
                                   uint8_t                *p_get_size)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len = 1;
 
     if ((NULL == handle) || (NULL == p_slave_info) || (NULL == p_get_size)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_SLAVE_GET;
     cmd_buf[4] = __ZM516X_CFG_END;
@@ -1103,13 +1263,13 @@ am_err_t am_zm516x_cfg_slave_get (am_zm516x_handle_t      handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_SLAVE_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[rsp_len - 1] != __ZM516X_CFG_END) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         *p_get_size = (buf_size > rsp_buf[4]) ? rsp_buf[4] : buf_size;
@@ -1118,9 +1278,9 @@ am_err_t am_zm516x_cfg_slave_get (am_zm516x_handle_t      handle,
                rsp_buf + 5,
               *p_get_size * sizeof(am_zm516x_slave_info_t));
 
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ѯӻ״̬E8 */
@@ -1129,14 +1289,19 @@ am_err_t am_zm516x_cfg_state_get (am_zm516x_handle_t handle,
                                   uint8_t           *p_response_state)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_CFG_TAG, 3);
     cmd_buf[3] = ZM516X_CFG_STATE_GET;
     cmd_buf[4] = __ZM516X_CFG_END;
@@ -1148,10 +1313,10 @@ am_err_t am_zm516x_cfg_state_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_CFG_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_CFG_STATE_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
 
         if (NULL != p_state) {
@@ -1161,9 +1326,9 @@ am_err_t am_zm516x_cfg_state_get (am_zm516x_handle_t handle,
             *p_response_state = rsp_buf[5];
         }
 
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /*******************************************************************************
@@ -1174,14 +1339,19 @@ am_err_t am_zm516x_cfg_state_get (am_zm516x_handle_t handle,
 am_err_t am_zm516x_channel_set (am_zm516x_handle_t handle, uint8_t chan)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_CHAN_SET;
     cmd_buf[4] = chan;
@@ -1193,17 +1363,17 @@ am_err_t am_zm516x_channel_set (am_zm516x_handle_t handle, uint8_t chan)
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_CHAN_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief  ZigBee ģĿַʱD2 */
@@ -1211,14 +1381,19 @@ am_err_t am_zm516x_dest_addr_set (am_zm516x_handle_t handle,
                                   am_zm516x_addr_t  *p_zb_addr)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_DEST_SET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1230,31 +1405,36 @@ am_err_t am_zm516x_dest_addr_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_DEST_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief  ZigBee ģյݰͷǷʾԴַʱD3 */
 am_err_t am_zm516x_display_head_set (am_zm516x_handle_t handle, am_bool_t flag)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_SRC_DIS;
     cmd_buf[4] = flag;
@@ -1266,17 +1446,17 @@ am_err_t am_zm516x_display_head_set (am_zm516x_handle_t handle, am_bool_t flag)
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_SRC_DIS) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ַָ ZigBee ģ GPIO ʱD4 */
@@ -1285,14 +1465,19 @@ am_err_t am_zm516x_gpio_dir (am_zm516x_handle_t handle,
                              uint8_t            dir)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_GPIO_DIR_SET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1304,17 +1489,17 @@ am_err_t am_zm516x_gpio_dir (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_GPIO_DIR_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4+p_zb_addr->addr_size] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģ GPIO ֵʱD5 */
@@ -1323,14 +1508,19 @@ am_err_t am_zm516x_gpio_get (am_zm516x_handle_t handle,
                              uint8_t           *p_value)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_GPIO_GET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1342,15 +1532,15 @@ am_err_t am_zm516x_gpio_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_GPIO_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         *p_value = rsp_buf[4+p_zb_addr->addr_size];
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ַָ ZigBee ģGPIOֵʱD6 */
@@ -1359,14 +1549,19 @@ am_err_t am_zm516x_gpio_set (am_zm516x_handle_t handle,
                              uint8_t            value)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_GPIO_SET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1379,17 +1574,17 @@ am_err_t am_zm516x_gpio_set (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_GPIO_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4 + p_zb_addr->addr_size] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģADתֵʱD7 */
@@ -1399,14 +1594,19 @@ am_err_t am_zm516x_ad_get (am_zm516x_handle_t handle,
                            uint16_t          *p_value)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr) || (NULL == p_value)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_ADC_GET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1419,34 +1619,40 @@ am_err_t am_zm516x_ad_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_ADC_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         *p_value = rsp_buf[4+p_zb_addr->addr_size] << 8 |
                    rsp_buf[5+p_zb_addr->addr_size];
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief  ZigBee ģ˯ģʽʱD8 */
 void am_zm516x_enter_sleep (am_zm516x_handle_t handle)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, NULL) != AM_OK) {
+        return;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_SLEEP;
     cmd_buf[4] = 0x01;
 
     am_zm516x_send_cmd(p_dev->uart_handle, cmd_buf, 5, NULL, &rsp_len, 50);
+    __zm516x_buf_free(mark, AM_OK);
     am_mdelay(200);
 }
 
@@ -1455,14 +1661,19 @@ am_err_t am_zm516x_mode_set (am_zm516x_handle_t    handle,
                              am_zm516x_comm_mode_t mode)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if (NULL == handle) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_MODE_SET;
     cmd_buf[4] = mode;
@@ -1474,17 +1685,17 @@ am_err_t am_zm516x_mode_set (am_zm516x_handle_t    handle,
                           &rsp_len,
                            50) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_MODE_SET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[4] != ZM516X_COM_OK) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ȡַָ ZigBee ģźǿȣʱDA */
@@ -1493,14 +1704,19 @@ am_err_t am_zm516x_sigal_get (am_zm516x_handle_t handle,
                               uint8_t           *p_signal)
 {
     am_zm516x_dev_t *p_dev = (am_zm516x_dev_t *)handle;
-    uint8_t          cmd_buf[__ZM516X_CMD_BUF_LEN] = {0};
-    uint8_t          rsp_buf[__ZM516X_RSP_BUF_LEN] = {0};
+    uint8_t         *cmd_buf;
+    uint8_t         *rsp_buf;
+    am_arena_mark_t  mark;
     uint16_t         rsp_len;
 
     if ((NULL == handle) || (NULL == p_zb_addr) || (NULL == p_signal)) {
         return -AM_EINVAL;
     }
 
+    if (__zm516x_buf_alloc(&mark, &cmd_buf, &rsp_buf) != AM_OK) {
+        return -AM_ENOMEM;
+    }
+
     memcpy(cmd_buf, __ZM516X_COM_TAG, 3);
     cmd_buf[3] = ZM516X_COM_CSQ_GET;
     memcpy(&cmd_buf[4], p_zb_addr->p_addr, p_zb_addr->addr_size);
@@ -1512,15 +1728,15 @@ am_err_t am_zm516x_sigal_get (am_zm516x_handle_t handle,
                           &rsp_len,
                            100) == AM_TRUE) {
         if (memcmp(rsp_buf, __ZM516X_COM_TAG, 3) != 0) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         if (rsp_buf[3] != ZM516X_COM_CSQ_GET) {
-            return -AM_EPERM;
+            return __zm516x_buf_free(mark, -AM_EPERM);
         }
         *p_signal = rsp_buf[4+p_zb_addr->addr_size];
-        return AM_OK;
+        return __zm516x_buf_free(mark, AM_OK);
     }
-    return -AM_EPERM;
+    return __zm516x_buf_free(mark, -AM_EPERM);
 }
 
 /** \brief ZM516Xģʼ */
@@ -1534,6 +1750,13 @@ am_zm516x_handle_t am_zm516x_init (am_zm516x_dev_t            *p_dev,
 
     p_dev->p_devinfo = (am_zm516x_dev_info_t *)p_info;
 
+    /* ״γʼʱõʱڴ */
+    if (__g_zm516x_scratch.p_start == NULL) {
+        am_arena_init(&__g_zm516x_scratch,
+                      __g_zm516x_scratch_mem,
+                      sizeof(__g_zm516x_scratch_mem));
+    }
+
     p_dev->uart_handle = am_uart_rngbuf_init(&p_dev->uart_rngbuf_dev,
                                               uart_handle,
                                               p_info->p_rxbuf,
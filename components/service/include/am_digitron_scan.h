@@ -16,6 +16,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-17  add AM_DIGITRON_SCAN_DEFER_ENABLE.
  * - 1.00 17-05-18  tee, first implementation.
  * \endinternal
  */
@@ -38,6 +39,25 @@ extern "C" {
  * @{
  */
 
+/**
+ * \brief Ƿжӳִɨ
+ *
+ * ĬΪ 0ɨʱصͨΪϵͳδжϣֱִСɨλ
+ * Ͷλ루ͨ HC595ʱϳΪ 1 ɨΪжӳҵ
+ * ִУƳжϵӦѵ am_isr_defer_init() ڴ
+ * жӳҵڻصֱִС
+ */
+#ifndef AM_DIGITRON_SCAN_DEFER_ENABLE
+#define AM_DIGITRON_SCAN_DEFER_ENABLE    0
+#endif
+
+/**
+ * \brief ɨҵжӳеȼɨʱΪУĬΪȼ
+ */
+#ifndef AM_DIGITRON_SCAN_DEFER_PRI
+#define AM_DIGITRON_SCAN_DEFER_PRI       0
+#endif
+
 /**
  * \brief ̬ɨϢ
  */
@@ -120,6 +140,9 @@ typedef struct am_digitron_scan_dev {
 
     am_digitron_dev_t isa;             /**< \brief Ǳ׼豸      */
     am_softimer_t     timer;           /**< \brief ʹʱ          */
+#if AM_DIGITRON_SCAN_DEFER_ENABLE
+    am_isr_defer_job_t job;            /**< \brief ɨжӳִ    */
+#endif
 
     uint8_t           scan_idx;        /**< \brief ǰɨ            */
     uint8_t           scan_interval;   /**< \brief ɨʱ            */
@@ -0,0 +1,237 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief CPU ͳʵ
+ *
+ * ÿлʱϴлʱۼлǰͳڵʱ
+ * ۼֵλ㡣
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_cpu_load.h"
+#include "am_timestamp.h"
+#include "am_softimer.h"
+#include "am_int.h"
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+
+/*******************************************************************************
+  Local Variables
+*******************************************************************************/
+
+/** \brief CPU ͳ */
+static struct __cpu_load {
+
+    /** \brief Ƿѿʼͳ */
+    volatile am_bool_t started;
+
+    /** \brief ǰ */
+    volatile int       cur;
+
+    /** \brief ϴлʱ */
+    am_timestamp_t     last;
+
+    /** \brief ǰڸۼʱ */
+    uint32_t           acc[AM_CPU_LOAD_NUM];
+
+    /** \brief ڵĸʱ */
+    uint32_t           hist[AM_CPU_LOAD_HIST_NUM][AM_CPU_LOAD_NUM];
+
+    /** \brief һڱλ */
+    unsigned int       idx;
+
+    /** \brief ɵ AM_CPU_LOAD_HIST_NUM */
+    unsigned int       filled;
+
+    /** \brief ڶʱ */
+    am_softimer_t      timer;
+
+} __g_cpu_load;
+
+/*******************************************************************************
+  Local Functions
+*******************************************************************************/
+
+/* ۼƵǰʱ䲢лڹж״̬µ */
+static void __cpu_load_switch (int type)
+{
+    am_timestamp_t now = am_timestamp_get();
+
+    __g_cpu_load.acc[__g_cpu_load.cur] += (uint32_t)(now - __g_cpu_load.last);
+
+    __g_cpu_load.last = now;
+    __g_cpu_load.cur  = type;
+}
+
+/* ڵ汾ڵͳֵ */
+static void __cpu_load_period (void *p_arg)
+{
+    uint32_t *p_hist;
+    int       key;
+    int       i;
+
+    (void)p_arg;
+
+    key = am_int_cpu_lock();
+
+    __cpu_load_switch(__g_cpu_load.cur);
+
+    p_hist = __g_cpu_load.hist[__g_cpu_load.idx];
+    for (i = 0; i < AM_CPU_LOAD_NUM; i++) {
+        p_hist[i]            = __g_cpu_load.acc[i];
+        __g_cpu_load.acc[i]  = 0;
+    }
+
+    if (++__g_cpu_load.idx >= AM_CPU_LOAD_HIST_NUM) {
+        __g_cpu_load.idx = 0;
+    }
+    if (__g_cpu_load.filled < AM_CPU_LOAD_HIST_NUM) {
+        __g_cpu_load.filled++;
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/*******************************************************************************
+  Public Functions
+*******************************************************************************/
+int am_cpu_load_init (void)
+{
+    int key;
+    int ret;
+    int i;
+
+    /* ³ʼʱֹͣڶʱ */
+    if (__g_cpu_load.started) {
+        __g_cpu_load.started = AM_FALSE;
+        am_softimer_stop(&__g_cpu_load.timer);
+    }
+
+    ret = am_softimer_init(&__g_cpu_load.timer, __cpu_load_period, NULL);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    key = am_int_cpu_lock();
+
+    for (i = 0; i < AM_CPU_LOAD_NUM; i++) {
+        __g_cpu_load.acc[i] = 0;
+    }
+
+    __g_cpu_load.idx     = 0;
+    __g_cpu_load.filled  = 0;
+    __g_cpu_load.last    = am_timestamp_get();
+    __g_cpu_load.started = AM_TRUE;
+
+    am_int_cpu_unlock(key);
+
+    am_softimer_start(&__g_cpu_load.timer, AM_CPU_LOAD_PERIOD_MS);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_cpu_load_enter (int type)
+{
+    int prev;
+    int key;
+
+    key = am_int_cpu_lock();
+
+    prev = __g_cpu_load.cur;
+
+    if (__g_cpu_load.started) {
+        __cpu_load_switch(type);
+    } else {
+        __g_cpu_load.cur = type;
+    }
+
+    am_int_cpu_unlock(key);
+
+    return prev;
+}
+
+/******************************************************************************/
+void am_cpu_load_exit (int prev)
+{
+    am_cpu_load_enter(prev);
+}
+
+/******************************************************************************/
+int am_cpu_load_get (uint32_t window_ms, am_cpu_load_t *p_load)
+{
+    uint32_t     sum[AM_CPU_LOAD_NUM] = {0};
+    uint64_t     total = 0;
+    unsigned int num;
+    unsigned int idx;
+    int          key;
+    int          i;
+    int          j;
+
+    if (p_load == NULL) {
+        return -AM_EINVAL;
+    }
+
+    num = (window_ms + AM_CPU_LOAD_PERIOD_MS - 1) / AM_CPU_LOAD_PERIOD_MS;
+    if (num == 0) {
+        num = 1;
+    }
+
+    key = am_int_cpu_lock();
+
+    if (num > __g_cpu_load.filled) {
+        num = __g_cpu_load.filled;
+    }
+
+    /* ǰۼ */
+    idx = __g_cpu_load.idx;
+    for (i = 0; i < (int)num; i++) {
+        idx = (idx == 0) ? AM_CPU_LOAD_HIST_NUM - 1 : idx - 1;
+
+        for (j = 0; j < AM_CPU_LOAD_NUM; j++) {
+            sum[j] += __g_cpu_load.hist[idx][j];
+        }
+    }
+
+    am_int_cpu_unlock(key);
+
+    if (num == 0) {
+        return -AM_EAGAIN;
+    }
+
+    for (i = 0; i < AM_CPU_LOAD_NUM; i++) {
+        total += sum[i];
+    }
+
+    p_load->window_ms = num * AM_CPU_LOAD_PERIOD_MS;
+
+    for (i = 0; i < AM_CPU_LOAD_NUM; i++) {
+        p_load->permille[i] = (total == 0) ?
+                              0 : (uint16_t)((uint64_t)sum[i] * 1000 / total);
+    }
+
+    p_load->busy = (total == 0) ?
+                   0 : (uint16_t)(1000 - (uint64_t)sum[AM_CPU_LOAD_IDLE] *
+                                         1000 / total);
+
+    return AM_OK;
+}
+
+#endif /* (AM_CPU_LOAD_ENABLE != 0) */
+
+/* end of file */
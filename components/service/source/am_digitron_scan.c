@@ -16,6 +16,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-17  deferred scan is opt-in (AM_DIGITRON_SCAN_DEFER_ENABLE).
  * - 1.00 17-05-12  tee, first implementation.
  * \endinternal
  */
@@ -502,6 +503,11 @@ int am_digitron_scan_init (am_digitron_scan_dev_t           *p_dev,
     p_dev->scan_interval = 1000 / p_info->scan_freq / (p_dev->num_digitron / p_dev->num_scan);
 
     am_softimer_init(&p_dev->timer, __digitron_dynamic_scan_timer_cb, p_dev);
+
+#if AM_DIGITRON_SCAN_DEFER_ENABLE
+    am_softimer_defer_set(&p_dev->timer, &p_dev->job, AM_DIGITRON_SCAN_DEFER_PRI);
+#endif
+
     am_softimer_start(&p_dev->timer, p_dev->scan_interval);
 
     /* ӱ׼豸  */
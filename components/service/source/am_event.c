@@ -16,6 +16,10 @@
  *
  * \internal
  * \par modification history:
+ * - 1.04 26-10-17  am_event_raise_copy() limits the size only in queued mode.
+ * - 1.03 26-10-17  detect a next handler that was re-registered by its
+ *                  registration generation.
+ * - 1.02 26-10-17  queued dispatch, traverse handlers with interrupts enabled.
  * - 1.01 15-01-05 orz, move event configuration to aw_event_cfg.c.
  * - 1.00 14-06-05 orz, first implementation.
  * \endinternal
@@ -23,42 +27,135 @@
 #include "ametal.h"
 #include "am_event.h"
 #include "am_int.h"
+#include "am_msgq.h"
+#include "am_isr_defer.h"
+#include <string.h>
+
+/*******************************************************************************
+  Local types and variables
+*******************************************************************************/
+
+/*
+ * ޸ĴʱرжϣִкݴжǷ
+ * ޸ģδ޸ʱֱʹ֮ǰȡһעʱֵͬʱ¼ڴ
+ *  gen ԱУʶעעᣨλѸı䣩Ĵ
+ */
+static volatile uint32_t __g_event_gen = 0;
+
+#if (AM_EVENT_QUEUE_SIZE > 0)
+
+/* ¼еһ¼ */
+struct __event_entry {
+    am_event_type_t *p_event;       /* ¼                              */
+    void            *p_evt_data;    /* ¼ݣδʱ              */
+    int              flags;         /* ־                          */
+    am_bool_t        copied;        /* ¼ǷƵ data         */
+    uint32_t         data[(AM_EVENT_QUEUE_DATA_SIZE + 3) / 4];
+};
+
+static struct __event_entry __g_event_buf[AM_EVENT_QUEUE_SIZE];
+static struct am_msgq       __g_event_msgq;
+static am_isr_defer_job_t   __g_event_job;
+static am_bool_t            __g_event_queue_inited = AM_FALSE;
+
+#endif /* (AM_EVENT_QUEUE_SIZE > 0) */
 
 /*******************************************************************************
   Local functions
 *******************************************************************************/
 
-/* go through an event handler list and call each handler functions */
+/* find the link pointing to the handler, must be called with CPU locked */
+static am_event_handler_t **__event_handler_find (am_event_handler_t **pp_head,
+                                                  am_event_handler_t  *p_handler)
+{
+    am_event_handler_t **pp;
+
+    for (pp = pp_head; NULL != *pp; pp = &(*pp)->p_next) {
+        if (*pp == p_handler) {
+            return pp;
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************/
+
+/*
+ * go through an event handler list and call each handler functions
+ *
+ * The CPU is only locked while stepping to the next handler, handler
+ * functions run with interrupts enabled. When the list was changed while a
+ * handler was running, the next handler is looked up again. A handler that
+ * was unregistered and registered again meanwhile is still found in the list,
+ * but at the head, so it is only trusted when its registration generation is
+ * unchanged; otherwise traversal would run handlers twice.
+ */
 static void __event_handler_process (am_event_handler_t **pp_head,
                                      am_event_type_t     *p_event,
                                      void                *p_evt_data)
 {
-    am_event_handler_t *p_next, *p_handler;
+    am_event_handler_t  *p_next, *p_handler;
+    am_event_handler_t **pp;
+    uint32_t             gen;
+    uint32_t             hdl_gen, next_gen = 0;
+    int                  key;
+
+    key = am_int_cpu_lock();
 
     for (p_handler = *pp_head; NULL != p_handler; p_handler = p_next) {
 
-        p_next = p_handler->p_next;   /* handlers may delete themselves */
+        p_next  = p_handler->p_next;   /* handlers may delete themselves */
+        gen     = __g_event_gen;
+        hdl_gen = p_handler->gen;
+        if (NULL != p_next) {
+            next_gen = p_next->gen;
+        }
+
+        am_int_cpu_unlock(key);
 
         if (NULL != p_handler->pfn_proc) {
             p_handler->pfn_proc(p_event, p_evt_data, p_handler->p_data);
         }
 
+        key = am_int_cpu_lock();
+
+        if (gen != __g_event_gen) {
+
+            /* the list was changed, continue with the next handler if it is
+             * still in the list at the same registration, otherwise with the
+             * new next of this handler, otherwise stop
+             */
+            if ((NULL != p_next) &&
+                ((p_next->gen != next_gen) ||
+                 (NULL == __event_handler_find(pp_head, p_next)))) {
+                p_next = NULL;
+                if ((p_handler->gen == hdl_gen) &&
+                    (NULL != __event_handler_find(pp_head, p_handler))) {
+                    p_next = p_handler->p_next;
+                }
+            }
+        }
+
         if (p_handler->flags & AM_EVENT_HANDLER_FLAG_AUTO_UNREG) {
+
             /* the handler request to delete it's self */
-            p_handler->p_next = NULL; /* this handler point to NULL */
-            *pp_head          = p_next; /* previous handler pointer point to next */
-        } else {
-             pp_head = &p_handler->p_next; /* now this handler is 'previous' */
+            pp = __event_handler_find(pp_head, p_handler);
+            if (NULL != pp) {
+                *pp               = p_handler->p_next;
+                p_handler->p_next = NULL;
+                __g_event_gen++;
+            }
         }
     }
+
+    am_int_cpu_unlock(key);
 }
 
 /******************************************************************************/
 /* raise an event immediately. */
 static int __event_raise (am_event_type_t *p_event, void *p_evt_data, int cat_only)
 {
-    int key = am_int_cpu_lock();
-
     /* process category handler for this event first */
     __event_handler_process(&p_event->p_category->p_handler, p_event, p_evt_data);
 
@@ -68,11 +165,79 @@ static int __event_raise (am_event_type_t *p_event, void *p_evt_data, int cat_on
         __event_handler_process(&p_event->p_handler, p_event, p_evt_data);
     }
 
+    return AM_OK;
+}
+
+#if (AM_EVENT_QUEUE_SIZE > 0)
+
+/******************************************************************************/
+/* the job raises all the queued events */
+static void __event_queue_job (void *p_arg)
+{
+    struct __event_entry entry;
+
+    (void)p_arg;
+
+    /* the job is the only reader of the queue */
+    while (am_msgq_pop(&__g_event_msgq, &entry) == AM_OK) {
+        __event_raise(entry.p_event,
+                      entry.copied ? (void *)entry.data : entry.p_evt_data,
+                      entry.flags & AM_EVENT_PROC_FLAG_CAT_ONLY);
+    }
+}
+
+/******************************************************************************/
+/* queue an event, the CPU is locked for a constant time only */
+static int __event_enqueue (am_event_type_t *p_event,
+                            const void      *p_evt_data,
+                            size_t           size,
+                            am_bool_t        copy,
+                            int              flags)
+{
+    struct __event_entry entry;
+    int                  ret;
+    int                  key;
+
+    entry.p_event    = p_event;
+    entry.p_evt_data = (void *)p_evt_data;
+    entry.flags      = flags;
+    entry.copied     = copy;
+
+    if (copy) {
+        memcpy(entry.data, p_evt_data, size);
+    }
+
+    key = am_int_cpu_lock();
+
+    if (!__g_event_queue_inited) {
+        am_msgq_init(&__g_event_msgq,
+                     __g_event_buf,
+                     sizeof(struct __event_entry),
+                     AM_EVENT_QUEUE_SIZE);
+        am_isr_defer_job_init(&__g_event_job,
+                              __event_queue_job,
+                              NULL,
+                              AM_EVENT_QUEUE_JOB_PRI);
+        __g_event_queue_inited = AM_TRUE;
+    }
+
+    /* writers of the queue are serialized by the lock */
+    ret = am_msgq_push(&__g_event_msgq, &entry);
+
     am_int_cpu_unlock(key);
 
-    return AM_OK;;
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    /* the job is already queued, it will process this event too */
+    ret = am_isr_defer_job_add(&__g_event_job);
+
+    return (ret == -AM_EBUSY) ? AM_OK : ret;
 }
 
+#endif /* (AM_EVENT_QUEUE_SIZE > 0) */
+
 /******************************************************************************/
 static int __event_handler_delete (am_event_handler_t **pp_head,
                                    am_event_handler_t  *p_handler)
@@ -88,6 +253,7 @@ static int __event_handler_delete (am_event_handler_t **pp_head,
             prev->p_next      = p_handler->p_next;
             p_handler->p_next = NULL;
             ret               = AM_OK;
+            __g_event_gen++;
             break;
         }
     }
@@ -134,7 +300,46 @@ int am_event_raise (am_event_type_t *p_event, void *p_evt_data, int flags)
         return -AM_EINVAL;
     }
 
+#if (AM_EVENT_QUEUE_SIZE > 0)
+    return __event_enqueue(p_event, p_evt_data, 0, AM_FALSE, cat_only);
+#else
     return __event_raise(p_event, p_evt_data, cat_only);
+#endif
+}
+
+/******************************************************************************/
+int am_event_raise_copy (am_event_type_t *p_event,
+                         const void      *p_evt_data,
+                         size_t           size,
+                         int              flags)
+{
+    int cat_only = flags & AM_EVENT_PROC_FLAG_CAT_ONLY;
+
+    if ((p_event == NULL) || ((p_evt_data == NULL) && (size != 0))) {
+        return -AM_EINVAL;
+    }
+
+#if (AM_EVENT_QUEUE_SIZE > 0)
+
+    /* only the queued mode copies the data */
+    if (size > AM_EVENT_QUEUE_DATA_SIZE) {
+        return -AM_EINVAL;
+    }
+
+    return __event_enqueue(p_event, p_evt_data, size, AM_TRUE, cat_only);
+#else
+    return __event_raise(p_event, (void *)p_evt_data, cat_only);
+#endif
+}
+
+/******************************************************************************/
+uint32_t am_event_queue_overflow_get (void)
+{
+#if (AM_EVENT_QUEUE_SIZE > 0)
+    return __g_event_queue_inited ? am_msgq_overflow_get(&__g_event_msgq) : 0;
+#else
+    return 0;
+#endif
 }
 
 /******************************************************************************/
@@ -152,6 +357,7 @@ int am_event_handler_register (am_event_type_t     *p_event,
     /* add the handler to event handler list */
     p_handler->p_next  = p_event->p_handler;
     p_event->p_handler = p_handler;
+    p_handler->gen     = ++__g_event_gen;
 
     am_int_cpu_unlock(key);
 
@@ -184,6 +390,7 @@ int am_event_category_handler_register (am_event_category_t *p_category,
     /* add the handler to event category handler list */
     p_handler->p_next     = p_category->p_handler;
     p_category->p_handler = p_handler;
+    p_handler->gen        = ++__g_event_gen;
 
     am_int_cpu_unlock(key);
 
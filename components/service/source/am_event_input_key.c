@@ -16,6 +16,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-17  copy key data when raising, for queued event dispatch.
  * - 1.00 17-05-12  tee, first implementation.
  * \endinternal
  */
@@ -79,9 +80,7 @@ int am_input_key_report (int key_code, int key_state)
     data.key_code   = key_code;
     data.key_state  = key_state;
 
-    am_event_raise(&__g_event_input_key, &data, 0);
-
-    return AM_OK;
+    return am_event_raise_copy(&__g_event_input_key, &data, sizeof(data), 0);
 }
 
 /******************************************************************************/
@@ -15,10 +15,21 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  use leveled log macros.
  * - 1.00 16-08-23  tee, first implementation.
  * \endinternal
  */
-#undef AM_VDEBUG
+
+/**
+ * \brief FTL ʱ־Ĭֻ;棬деĵ־
+ */
+#ifndef AM_FTL_LOG_LEVEL
+#define AM_FTL_LOG_LEVEL        AM_LOG_LEVEL_WARN
+#endif
+
+#define AM_LOG_MODULE           AM_LOG_MOD_FTL
+#define AM_LOG_MODULE_LEVEL     AM_FTL_LOG_LEVEL
+
 #include "ametal.h"
 #include "am_ftl.h"
 #include "string.h"
@@ -137,7 +148,7 @@ static int __ftl_bci_read (am_ftl_serv_t    *p_ftl,
     ret = am_mtd_read(p_ftl->mtd, addr, p_bci, sizeof(struct __ftl_bci));
 
     if (ret < sizeof(struct __ftl_bci)) {
-        AM_DBG_INFO("ftl: __ftl_bci_read error, ret is: %d\n", ret);
+        AM_LOGE("ftl: __ftl_bci_read error, ret is: %d\n", ret);
         return ret;
     }
 
@@ -160,7 +171,7 @@ static int __ftl_bci_write (am_ftl_serv_t    *p_ftl,
     ret = am_mtd_write(p_ftl->mtd, addr, p_bci, sizeof(struct __ftl_bci));
 
     if (ret < sizeof(struct __ftl_bci)) {
-        AM_DBG_INFO("ftl: __ftl_bci_write error, ret is: %d\n", ret);
+        AM_LOGE("ftl: __ftl_bci_write error, ret is: %d\n", ret);
         return ret;
     }
 
@@ -187,7 +198,7 @@ static int __ftl_sci_read (am_ftl_serv_t    *p_ftl,
     ret = am_mtd_read(p_ftl->mtd, addr, p_sci, sizeof(struct __ftl_sci));
 
     if (ret < sizeof(struct __ftl_sci)) {
-        AM_DBG_INFO("ftl: __ftl_sci_read error, ret is: %d\n", ret);
+        AM_LOGE("ftl: __ftl_sci_read error, ret is: %d\n", ret);
         return ret;
     }
 
@@ -213,7 +224,7 @@ static int __ftl_sci_write (am_ftl_serv_t    *p_ftl,
     ret = am_mtd_write(p_ftl->mtd, addr, p_sci, sizeof(struct __ftl_sci));
 
     if (ret < sizeof(struct __ftl_sci)) {
-        AM_DBG_INFO("ftl: __ftl_sci_write error, ret is: %d\n", ret);
+        AM_LOGE("ftl: __ftl_sci_write error, ret is: %d\n", ret);
         return ret;
     }
 
@@ -285,7 +296,7 @@ static int __ftl_block_erase (am_ftl_serv_t     *p_ftl,
     bci.magic_num = __FTL_MAGIC_NUM;
     bci.wear_info = wear_info;
 
-    AM_DBG_INFO("Erase block : %d \n", pbn);
+    AM_LOGD("Erase block : %d \n", pbn);
 
     ret = am_mtd_erase(p_ftl->mtd,
                        __FTL_PHY_BLOCK_START_ADDR_GET(p_ftl, pbn),
@@ -315,7 +326,7 @@ static int __free_block_init (am_ftl_serv_t *p_ftl)
 static int __free_block_set (am_ftl_serv_t *p_ftl, uint16_t pbn, int val)
 {
     if (val) {
-        AM_DBG_INFO("set the %d is free!\n", pbn);
+        AM_LOGD("set the %d is free!\n", pbn);
         p_ftl->p_free[pbn >> 5] |= (1 << (pbn & 0x1F));
     } else {
         p_ftl->p_free[pbn >> 5] &= ~(1 << (pbn & 0x1F));
@@ -347,10 +358,10 @@ static int __free_block_next_get (am_ftl_serv_t *p_ftl, uint16_t pbn)
         }
     }
 
-    AM_DBG_INFO("after the start bit %d, Can't find a free block!\n", pbn);
+    AM_LOGW("after the start bit %d, Can't find a free block!\n", pbn);
 
     for (i = 0; i < p_ftl->free_size; i++) {
-        AM_DBG_INFO("%x \n", p_free[i]);
+        AM_LOGD("%x \n", p_free[i]);
     }
 
     return -1;
@@ -407,9 +418,9 @@ static int __ftl_init (am_ftl_serv_t *p_ftl)
                                        p_info->logic_blk_size,
                                        p_info->nb_log_blocks);
 
-    AM_DBG_INFO("The expect size of ram is %d\n", ram_len);
+    AM_LOGD("The expect size of ram is %d\n", ram_len);
     if (p_info->len < ram_len) {
-        AM_DBG_INFO("The size (%d) of p_buf is not enough\n", p_info->len);
+        AM_LOGE("The size (%d) of p_buf is not enough\n", p_info->len);
         return -1;
     }
 
@@ -436,12 +447,12 @@ static int __ftl_init (am_ftl_serv_t *p_ftl)
     p_ftl->nb_blocks       -= p_info->reserved_blocks;
 
 
-    AM_DBG_INFO("The sectors hdr is %d \n", p_ftl->sectors_hdr);
-    AM_DBG_INFO("nb_blocks = %d \n", p_ftl->nb_blocks);
-    AM_DBG_INFO("max_lbn = %d \n", p_ftl->max_lbn);
-    AM_DBG_INFO("valid size / total_size = %d / %d \n",
-                (p_ftl->max_lbn + 1) * p_info->logic_blk_size,
-                AM_MTD_CHIP_SIZE_GET(p_ftl->mtd));
+    AM_LOGD("The sectors hdr is %d \n", p_ftl->sectors_hdr);
+    AM_LOGD("nb_blocks = %d \n", p_ftl->nb_blocks);
+    AM_LOGD("max_lbn = %d \n", p_ftl->max_lbn);
+    AM_LOGD("valid size / total_size = %d / %d \n",
+            (p_ftl->max_lbn + 1) * p_info->logic_blk_size,
+            AM_MTD_CHIP_SIZE_GET(p_ftl->mtd));
 
     if (__ftl_mem_init (p_ftl, p_info->p_buf, p_info->len) < 0) {
         return -1;
@@ -460,7 +471,7 @@ static int __ftl_log_block_process (am_ftl_serv_t *p_ftl)
 
         if (p_ftl->p_log_buf[i].used == p_ftl->sectors_per_blk) { /* full */
 
-            AM_DBG_INFO("The log buffer is full!\n");
+            AM_LOGD("The log buffer is full!\n");
 
             for (j = 0; j < p_ftl->sectors_per_blk; j++) {
                 if (p_ftl->p_log_buf[i].p_map[j] != j) {
@@ -484,7 +495,7 @@ static int __ftl_copy_block_process (am_ftl_serv_t *p_ftl, uint16_t copy_block)
     struct __ftl_bci  bci;
     size_t            log_blocks = p_ftl->p_info->nb_log_blocks;
 
-    AM_DBG_INFO("there is a copy block!\n");
+    AM_LOGD("there is a copy block!\n");
     if ((__ftl_bci_read(p_ftl, copy_block, &bci) < 0) ||
         (bci.lbn1 == 0xFFFF)) {
         if (__ftl_block_erase(p_ftl, copy_block) < 0) {
@@ -627,7 +638,7 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
 
                 if (p_ftl->p_eun_table[bci.lbn1] != 0xFFFF) { 
 
-                    AM_DBG_INFO("The lbn is already exist, just erase\n");
+                    AM_LOGD("The lbn is already exist, just erase\n");
                     __ftl_erase_at_mount(p_ftl, i, &wear_min, bci.wear_info);
                     continue;
                 }
@@ -643,7 +654,7 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
             } else {                                 /* a log buffer */
 
                 if (log_num >= log_blocks) {
-                    AM_DBG_INFO("too much log buffer?? \n");
+                    AM_LOGW("too much log buffer?? \n");
                     __ftl_erase_at_mount(p_ftl, i, &wear_min, bci.wear_info);
                     continue;
                 }
@@ -675,7 +686,7 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
                 /* not used */
                 if (sec_used == 0) {
 
-                    AM_DBG_INFO("The log buffer %d is not used! erase it \r\n",i);
+                    AM_LOGD("The log buffer %d is not used! erase it \r\n",i);
                     __free_block_set(p_ftl, i, 1);        /* mask it as free */
                     __ftl_erase_at_mount(p_ftl, i, &wear_min, bci.wear_info);
 
@@ -688,13 +699,13 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
                 p_ftl->p_log_buf[log_num].lbn  = bci.lbn1;
                 p_ftl->p_log_buf[log_num].used = sec_used;
 
-                AM_DBG_INFO("Find a log buffer! (%d, %d) : ", bci.lbn1, i);
+                AM_LOGD("Find a log buffer! (%d, %d) : ", bci.lbn1, i);
 
                 for (k = 0; k < sec_used; k++) {
-                    AM_DBG_INFO("%d  ", p_ftl->p_log_buf[log_num].p_map[k]);
+                    AM_LOGD("%d  ", p_ftl->p_log_buf[log_num].p_map[k]);
                 }
 
-                AM_DBG_INFO("\n");
+                AM_LOGD("\n");
 
                 log_num++;
             }
@@ -708,7 +719,7 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
         }
     }
 
-    AM_DBG_INFO("for each end!\n");
+    AM_LOGD("for each end!\n");
 
     /* process the copy block */
     if (copy_block != 0xFFFF) {
@@ -720,7 +731,7 @@ static int __nfl_mount (am_ftl_serv_t *p_ftl)
         __ftl_log_block_process(p_ftl);
     }
 
-    AM_DBG_INFO("last free is %d \n", p_ftl->last_free);
+    AM_LOGD("last free is %d \n", p_ftl->last_free);
 
     return 0;
 }
@@ -736,7 +747,7 @@ static uint16_t __ftl_freeblock_find (am_ftl_serv_t *p_ftl)
     int free = __free_block_next_get(p_ftl, p_ftl->last_free);
 
     if (free == -1) {
-        AM_DBG_INFO("__ftl_freeblock_find: there are too few free EUNs\n");
+        AM_LOGW("__ftl_freeblock_find: there are too few free EUNs\n");
         return __FTL_BLOCK_NIL;
     }
 
@@ -756,7 +767,7 @@ static int __ftl_log_buf_victim_switch (am_ftl_serv_t  *p_ftl,
 
     uint16_t direct_eun = p_ftl->p_eun_table[p_log->lbn];
 
-    AM_DBG_INFO("only need switch!\n");
+    AM_LOGD("only need switch!\n");
 
     /* may be erase last power up. because of power failed.*/
     if (direct_eun == 0xFFFF) {
@@ -802,7 +813,7 @@ static int __ftl_log_buf_victim_normal (am_ftl_serv_t  *p_ftl,
         return -1;
     }
 
-    AM_DBG_INFO("The new victim log buffer is %d \n", new_eun);
+    AM_LOGD("The new victim log buffer is %d \n", new_eun);
 
     /* Save the this_vuc, the first node in the chain (8 ,8) */
     __ftl_bci_read(p_ftl, new_eun, &bci);
@@ -941,12 +952,12 @@ static int __ftl_log_buf_victim (am_ftl_serv_t *p_ftl, struct log_buf *p_log)
 {
     int i;
 
-    AM_DBG_INFO("try to victim the block, lbn(%d)->pbn(%d)\n", p_log->lbn, 
-                                                               p_log->pbn);
+    AM_LOGD("try to victim the block, lbn(%d)->pbn(%d)\n", p_log->lbn, 
+                                                           p_log->pbn);
 
     if (p_log->used == p_ftl->sectors_per_blk) {
 
-        AM_DBG_INFO("The log buffer is full!\n");
+        AM_LOGD("The log buffer is full!\n");
 
         for (i = 0; i < p_ftl->sectors_per_blk; i++) {
             if (p_log->p_map[i] != i) {
@@ -996,7 +1007,7 @@ static int __ftl_writeunit_find (am_ftl_serv_t *p_ftl,
             return -1;
         }
 
-        AM_DBG_INFO("The new data block is %d .\n", write_eun);
+        AM_LOGD("The new data block is %d .\n", write_eun);
 
         p_ftl->p_eun_table[this_vuc] = write_eun;
 
@@ -1100,7 +1111,7 @@ static int __ftl_writeunit_find (am_ftl_serv_t *p_ftl,
         return -1;
     }
 
-    AM_DBG_INFO("The new log block is %d .\n", write_eun);
+    AM_LOGD("The new log block is %d .\n", write_eun);
 
     p_log_victim->pbn      = write_eun;
     p_log_victim->lbn      = this_vuc;
@@ -1250,9 +1261,9 @@ int am_ftl_read (am_ftl_handle_t handle, unsigned int lbn, void *p_buf)
     }
 
     if (lbn > p_ftl->max_lbn) {
-        AM_DBG_INFO("FTL:The lbn (%d) is exceed the max val (%d)",
-                lbn,
-                p_ftl->max_lbn);
+        AM_LOGE("FTL:The lbn (%d) is exceed the max val (%d)",
+            lbn,
+            p_ftl->max_lbn);
 
         return -1;
     }
@@ -1263,7 +1274,7 @@ int am_ftl_read (am_ftl_handle_t handle, unsigned int lbn, void *p_buf)
         return __ftl_data_read(p_ftl, read_eun, read_sec, p_buf);
 
     } else {
-        AM_DBG_INFO("Can't find the lbn %d to read!\n", lbn);
+        AM_LOGD("Can't find the lbn %d to read!\n", lbn);
     }
 
     /* the requested block is not on the media, return all 0x00 */
@@ -1287,9 +1298,9 @@ int am_ftl_write (am_ftl_handle_t handle, unsigned int lbn, void *p_buf)
     }
 
     if (lbn > p_ftl->max_lbn) {
-        AM_DBG_INFO("FTL:The lbn (%d) is exceed the max val (%d)",
-                lbn,
-                p_ftl->max_lbn);
+        AM_LOGE("FTL:The lbn (%d) is exceed the max val (%d)",
+            lbn,
+            p_ftl->max_lbn);
 
         return -1;
     }
@@ -1297,13 +1308,13 @@ int am_ftl_write (am_ftl_handle_t handle, unsigned int lbn, void *p_buf)
     /* find a space to write */
     if (__ftl_writeunit_find(p_ftl, lbn, &write_eun, &write_sec) < 0) {
 
-        AM_DBG_INFO("am_ftl_write(): Cannot find block to write to\n");
+        AM_LOGE("am_ftl_write(): Cannot find block to write to\n");
 
         /* If we _still_ haven't got a block to use, we're screwed */
         return -1;
     }
 
-    AM_DBG_INFO("Write lbn %d to (%d, %d)!\n", lbn, write_eun, write_sec);
+    AM_LOGD("Write lbn %d to (%d, %d)!\n", lbn, write_eun, write_sec);
 
     /* Set the TAG to __FTL_SECTOR_USED */
     memset(&sci, 0xFF, sizeof(struct __ftl_sci));
@@ -1322,7 +1333,7 @@ int am_ftl_write (am_ftl_handle_t handle, unsigned int lbn, void *p_buf)
     if (__ftl_memcmpb(p_ftl->p_wr_buf,
                       0xFF,
                       p_ftl->p_info->logic_blk_size) != 0) {
-        AM_DBG_INFO("The block is error ! write failed! \n");
+        AM_LOGE("The block is error ! write failed! \n");
         while(1);
     }
 #endif
@@ -1356,21 +1367,21 @@ am_ftl_handle_t am_ftl_init (am_ftl_serv_t          *p_ftl,
 
     /* initial the memory allocation */
     if (__ftl_init(p_ftl) < 0) {
-         AM_DBG_INFO("Initial Failed!\r\n");
+         AM_LOGE("Initial Failed!\r\n");
          return NULL;
     }
  
     if (__nfl_mount(p_ftl) < 0) {
-        AM_DBG_INFO("Mount Failed! Try to format!\r\n");
+        AM_LOGW("Mount Failed! Try to format!\r\n");
 
         if (__ftl_format_all(p_ftl) < 0) {
 
-            AM_DBG_INFO("format failed!\r\n");
+            AM_LOGE("format failed!\r\n");
             return NULL;
         }
 
         if (__nfl_mount(p_ftl) < 0) {
-            AM_DBG_INFO("Mount again Failed!\r\n");
+            AM_LOGE("Mount again Failed!\r\n");
             return NULL;
         }
     }
@@ -1421,10 +1432,10 @@ am_local int __ftl_nvram_program_data (am_ftl_serv_t        *p_ftl,
         /* find the space to read */
         if (__ftl_readunit_find(p_ftl, lbn, &read_eun, &read_sec) >= 0) {
 
-            AM_DBG_INFO("read %d nbytes from %d\n", len,
-                        __FTL_PHY_BLOCK_START_ADDR_GET(p_ftl, read_eun)
-                        + ((read_sec + p_ftl->sectors_hdr) * lbn_size)
-                        + off);
+            AM_LOGD("read %d nbytes from %d\n", len,
+                    __FTL_PHY_BLOCK_START_ADDR_GET(p_ftl, read_eun)
+                    + ((read_sec + p_ftl->sectors_hdr) * lbn_size)
+                    + off);
 
             /* read the data */
             return am_mtd_read(p_ftl->mtd,
@@ -1434,7 +1445,7 @@ am_local int __ftl_nvram_program_data (am_ftl_serv_t        *p_ftl,
                                p_buf,
                                len);
         } else {
-            AM_DBG_INFO("Can't find the lbn %d to read!\n", lbn);
+            AM_LOGD("Can't find the lbn %d to read!\n", lbn);
             memset(p_buf, 0x00, len);
             return 0;
         }
@@ -1445,7 +1456,7 @@ am_local int __ftl_nvram_program_data (am_ftl_serv_t        *p_ftl,
         /* find a space to write */
         if (__ftl_writeunit_find(p_ftl, lbn, &write_eun, &write_sec) < 0) {
 
-            AM_DBG_INFO("am_ftl_write(): Cannot find block to write to\n");
+            AM_LOGE("am_ftl_write(): Cannot find block to write to\n");
 
             /* If we _still_ haven't got a block to use, we're screwed */
             return -1;
@@ -1465,10 +1476,10 @@ am_local int __ftl_nvram_program_data (am_ftl_serv_t        *p_ftl,
             memset(p_ftl->p_wr_buf, 0x00, lbn_size);
         }
 
-        AM_DBG_INFO("write %d nbytes to %d\n", len,
-                    __FTL_PHY_BLOCK_START_ADDR_GET(p_ftl, write_eun)
-                    + ((write_sec + p_ftl->sectors_hdr) * lbn_size)
-                    + off);
+        AM_LOGD("write %d nbytes to %d\n", len,
+                __FTL_PHY_BLOCK_START_ADDR_GET(p_ftl, write_eun)
+                + ((write_sec + p_ftl->sectors_hdr) * lbn_size)
+                + off);
 
         /* change the value to write */
         memcpy(p_ftl->p_wr_buf + off, p_buf, len);
@@ -16,6 +16,7 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.03 26-10-17  add asynchronous read/write.
  * - 1.02 15-10-27  tee, add the concept of message.
  * - 1.01 15-08-19  tee, modified some interface.
  * - 1.00 14-11-01  jon, first implementation.
@@ -24,6 +25,7 @@
 
 #include "am_i2c.h"
 #include "am_wait.h"
+#include "am_mempool.h"
 
 /******************************************************************************/
 
@@ -35,33 +37,34 @@ static void __i2c_callback (void *p_arg)
 
 /******************************************************************************/
 
-static int __i2c_rw_sync (am_i2c_device_t *p_dev,
-                          uint32_t         sub_addr,
-                          uint8_t         *p_buf,
-                          uint32_t         nbytes,
-                          am_bool_t        is_read)
+/*
+ * дϢtrans ٰ 2 䣬subaddr_buf  2 ֽڣϢ
+ * ǰ뱣Ч
+ */
+static int __i2c_rw_msg_make (am_i2c_device_t   *p_dev,
+                              uint32_t           sub_addr,
+                              uint8_t           *p_buf,
+                              uint32_t           nbytes,
+                              am_bool_t          is_read,
+                              am_i2c_message_t  *p_msg,
+                              am_i2c_transfer_t *p_trans,
+                              uint8_t           *subaddr_buf,
+                              am_pfnvoid_t       pfn_complete,
+                              void              *p_arg)
 {
     uint16_t subaddr_len = AM_I2C_SUBADDR_LEN_GET(p_dev->dev_flags);
-    
-    am_i2c_transfer_t trans[3];
-    am_wait_t         trans_wait;
-    am_i2c_message_t  msg;
-    uint8_t           subaddr_buf[2];  /* ڴ2bytesڼӵַ */
-    int               ret;
-    
-    am_wait_init(&trans_wait);
-    
+
     /* if no sub address just send the data */
     if (subaddr_len == 0) {
         
-        am_i2c_mktrans(&trans[0],
+        am_i2c_mktrans(&p_trans[0],
                        p_dev->dev_addr,
                        p_dev->dev_flags |
                        ((is_read == AM_TRUE) ? AM_I2C_M_RD : AM_I2C_M_WR),
                        p_buf, 
                        nbytes);
         
-        am_i2c_mkmsg( &msg, &trans[0], 1, __i2c_callback, &trans_wait);
+        am_i2c_mkmsg(p_msg, &p_trans[0], 1, pfn_complete, p_arg);
                        
                        
     } else {
@@ -87,13 +90,13 @@ static int __i2c_rw_sync (am_i2c_device_t *p_dev,
         }
         
 
-        am_i2c_mktrans(&trans[0],
+        am_i2c_mktrans(&p_trans[0],
                        p_dev->dev_addr,
                        p_dev->dev_flags | AM_I2C_M_WR,
                        &subaddr_buf[0], 
                        subaddr_len);
         
-        am_i2c_mktrans(&trans[1],
+        am_i2c_mktrans(&p_trans[1],
                        p_dev->dev_addr,
                        p_dev->dev_flags | 
                        ((is_read == AM_TRUE) ? \
@@ -101,9 +104,43 @@ static int __i2c_rw_sync (am_i2c_device_t *p_dev,
                        p_buf, 
                        nbytes);
         
-        am_i2c_mkmsg( &msg, &trans[0], 2, __i2c_callback, &trans_wait);
+        am_i2c_mkmsg(p_msg, &p_trans[0], 2, pfn_complete, p_arg);
     }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+
+static int __i2c_rw_sync (am_i2c_device_t *p_dev,
+                          uint32_t         sub_addr,
+                          uint8_t         *p_buf,
+                          uint32_t         nbytes,
+                          am_bool_t        is_read)
+{
+    am_i2c_transfer_t trans[2];
+    am_wait_t         trans_wait;
+    am_i2c_message_t  msg;
+    uint8_t           subaddr_buf[2];  /* ڴ2bytesڼӵַ */
+    int               ret;
+    
+    am_wait_init(&trans_wait);
     
+    ret = __i2c_rw_msg_make(p_dev,
+                            sub_addr,
+                            p_buf,
+                            nbytes,
+                            is_read,
+                            &msg,
+                            trans,
+                            subaddr_buf,
+                            __i2c_callback,
+                            &trans_wait);
+
+    if (ret != AM_OK) {
+        return ret;
+    }
+
     ret = am_i2c_msg_start(p_dev->handle, &msg);
     
     if (ret != AM_OK) {
@@ -149,4 +186,119 @@ int am_i2c_read (am_i2c_device_t *p_dev,
                          AM_TRUE);
 }
 
+#if (AM_I2C_ASYNC_REQ_NUM > 0)
+
+/**
+ * \brief 첽д󣬴ڴз䣬ɺͷ
+ */
+struct __i2c_async_req {
+    am_i2c_message_t   msg;
+    am_i2c_transfer_t  trans[2];
+    uint8_t            subaddr_buf[2];
+    am_i2c_async_cb_t  pfn_cb;
+    void              *p_arg;
+};
+
+/** \brief 첽дڴ */
+AM_MEMPOOL_DEFINE(__g_i2c_async_pool,
+                  sizeof(struct __i2c_async_req),
+                  AM_I2C_ASYNC_REQ_NUM);
+
+/******************************************************************************/
+
+/* 첽дϢɣͷ֪ͨûصпµ */
+static void __i2c_async_complete (void *p_arg)
+{
+    struct __i2c_async_req *p_req  = (struct __i2c_async_req *)p_arg;
+    am_i2c_async_cb_t       pfn_cb = p_req->pfn_cb;
+    void                   *p_usr  = p_req->p_arg;
+    int                     status = p_req->msg.status;
+
+    am_mempool_free(&__g_i2c_async_pool, p_req);
+
+    if (pfn_cb != NULL) {
+        pfn_cb(p_usr, status);
+    }
+}
+
+/******************************************************************************/
+
+static int __i2c_rw_async (am_i2c_device_t   *p_dev,
+                           uint32_t           sub_addr,
+                           uint8_t           *p_buf,
+                           uint32_t           nbytes,
+                           am_bool_t          is_read,
+                           am_i2c_async_cb_t  pfn_cb,
+                           void              *p_arg)
+{
+    struct __i2c_async_req *p_req;
+    int                     ret;
+
+    p_req = (struct __i2c_async_req *)am_mempool_alloc(&__g_i2c_async_pool);
+
+    if (p_req == NULL) {
+        return -AM_ENOMEM;
+    }
+
+    p_req->pfn_cb = pfn_cb;
+    p_req->p_arg  = p_arg;
+
+    ret = __i2c_rw_msg_make(p_dev,
+                            sub_addr,
+                            p_buf,
+                            nbytes,
+                            is_read,
+                            &p_req->msg,
+                            p_req->trans,
+                            p_req->subaddr_buf,
+                            __i2c_async_complete,
+                            p_req);
+
+    if (ret == AM_OK) {
+        ret = am_i2c_msg_start(p_dev->handle, &p_req->msg);
+    }
+
+    if (ret != AM_OK) {
+        am_mempool_free(&__g_i2c_async_pool, p_req);
+    }
+
+    return ret;
+}
+
+/******************************************************************************/
+int am_i2c_write_async (am_i2c_device_t   *p_dev,
+                        uint32_t           sub_addr,
+                        const uint8_t     *p_buf,
+                        uint32_t           nbytes,
+                        am_i2c_async_cb_t  pfn_cb,
+                        void              *p_arg)
+{
+    return __i2c_rw_async(p_dev,
+                          sub_addr,
+                          (uint8_t *)p_buf,
+                          nbytes,
+                          AM_FALSE,
+                          pfn_cb,
+                          p_arg);
+}
+
+/******************************************************************************/
+int am_i2c_read_async (am_i2c_device_t   *p_dev,
+                       uint32_t           sub_addr,
+                       uint8_t           *p_buf,
+                       uint32_t           nbytes,
+                       am_i2c_async_cb_t  pfn_cb,
+                       void              *p_arg)
+{
+    return __i2c_rw_async(p_dev,
+                          sub_addr,
+                          p_buf,
+                          nbytes,
+                          AM_TRUE,
+                          pfn_cb,
+                          p_arg);
+}
+
+#endif /* (AM_I2C_ASYNC_REQ_NUM > 0) */
+
 /* end of file */
@@ -0,0 +1,230 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ⷢ/ķʵ
+ *
+ * ݻǰΪͷ¼üʱÿһߵĶУ
+ * üһȥáߵĶΪ am_msgqȡֻ
+ * ߣд뷽ߣждʱرжϡ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_pubsub.h"
+#include "am_int.h"
+#include <string.h>
+
+/** \brief ݻͷ */
+struct __pubsub_hdr {
+    am_pubsub_topic_t *p_topic;      /**< \brief     */
+    uint32_t           ref;          /**< \brief ü    */
+};
+
+/** \brief ݻõͷ */
+#define __PUBSUB_HDR(p_payload) \
+    ((struct __pubsub_hdr *)((char *)(p_payload) - AM_PUBSUB_BUF_HDR_SIZE))
+
+/** \brief б */
+static am_pubsub_topic_t *__gp_pubsub_topics = NULL;
+
+/******************************************************************************/
+int am_pubsub_sub_init (am_pubsub_sub_t    *p_sub,
+                        void              **p_queue,
+                        size_t              depth,
+                        am_pubsub_notify_t  pfn_notify,
+                        void               *p_arg)
+{
+    if (p_sub == NULL) {
+        return -AM_EINVAL;
+    }
+
+    p_sub->pfn_notify = pfn_notify;
+    p_sub->p_arg      = p_arg;
+
+    return am_msgq_init(&p_sub->queue, p_queue, sizeof(void *), depth);
+}
+
+/******************************************************************************/
+int am_pubsub_topic_init (am_pubsub_topic_t       *p_topic,
+                          const char              *p_name,
+                          size_t                   payload_size,
+                          void                    *p_pool,
+                          size_t                   pool_size,
+                          am_pubsub_sub_t *const  *pp_subs,
+                          size_t                   sub_num)
+{
+    int ret;
+    int key;
+
+    if ((p_topic == NULL) || (p_name == NULL) ||
+        ((pp_subs == NULL) && (sub_num != 0))) {
+        return -AM_EINVAL;
+    }
+
+    ret = am_mempool_init(&p_topic->pool,
+                          p_pool,
+                          pool_size,
+                          AM_ROUND_UP(payload_size, 8) + AM_PUBSUB_BUF_HDR_SIZE);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    p_topic->p_name       = p_name;
+    p_topic->payload_size = payload_size;
+    p_topic->pp_subs      = pp_subs;
+    p_topic->sub_num      = sub_num;
+    p_topic->seq          = 0;
+
+    key = am_int_cpu_lock();
+
+    p_topic->p_next    = __gp_pubsub_topics;
+    __gp_pubsub_topics = p_topic;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_pubsub_topic_t *am_pubsub_topic_find (const char *p_name)
+{
+    am_pubsub_topic_t *p_topic;
+
+    for (p_topic = __gp_pubsub_topics; p_topic != NULL; p_topic = p_topic->p_next) {
+        if (strcmp(p_topic->p_name, p_name) == 0) {
+            break;
+        }
+    }
+
+    return p_topic;
+}
+
+/******************************************************************************/
+void *am_pubsub_buf_alloc (am_pubsub_topic_t *p_topic)
+{
+    struct __pubsub_hdr *p_hdr = am_mempool_alloc(&p_topic->pool);
+
+    if (p_hdr == NULL) {
+        return NULL;
+    }
+
+    p_hdr->p_topic = p_topic;
+    p_hdr->ref     = 1;           /* ߵ */
+
+    return (char *)p_hdr + AM_PUBSUB_BUF_HDR_SIZE;
+}
+
+/******************************************************************************/
+int am_pubsub_publish (am_pubsub_topic_t *p_topic, void *p_payload)
+{
+    struct __pubsub_hdr *p_hdr;
+    am_pubsub_sub_t     *p_sub;
+    size_t               i;
+    int                  count = 0;
+    int                  key;
+
+    if ((p_topic == NULL) || (p_payload == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    p_hdr = __PUBSUB_HDR(p_payload);
+    if (p_hdr->p_topic != p_topic) {
+        return -AM_EINVAL;
+    }
+
+    for (i = 0; i < p_topic->sub_num; i++) {
+        p_sub = p_topic->pp_subs[i];
+
+        key = am_int_cpu_lock();
+
+        /* ã߶ȡͷ */
+        p_hdr->ref++;
+        if (am_msgq_push(&p_sub->queue, &p_payload) != AM_OK) {
+            p_hdr->ref--;
+            am_int_cpu_unlock(key);
+            continue;
+        }
+
+        am_int_cpu_unlock(key);
+
+        count++;
+
+        if (p_sub->pfn_notify != NULL) {
+            p_sub->pfn_notify(p_sub->p_arg);
+        }
+    }
+
+    p_topic->seq++;
+
+    /* ȥߵãûж߽ʱ黹 */
+    am_pubsub_release(p_payload);
+
+    return count;
+}
+
+/******************************************************************************/
+void *am_pubsub_receive (am_pubsub_sub_t *p_sub)
+{
+    void *p_payload;
+
+    if (am_msgq_pop(&p_sub->queue, &p_payload) != AM_OK) {
+        return NULL;
+    }
+
+    return p_payload;
+}
+
+/******************************************************************************/
+void am_pubsub_release (void *p_payload)
+{
+    struct __pubsub_hdr *p_hdr = __PUBSUB_HDR(p_payload);
+    uint32_t             ref;
+    int                  key;
+
+    key = am_int_cpu_lock();
+    ref = --p_hdr->ref;
+    am_int_cpu_unlock(key);
+
+    if (ref == 0) {
+        am_mempool_free(&p_hdr->p_topic->pool, p_hdr);
+    }
+}
+
+/******************************************************************************/
+void am_pubsub_ref (void *p_payload)
+{
+    struct __pubsub_hdr *p_hdr = __PUBSUB_HDR(p_payload);
+    int                  key;
+
+    key = am_int_cpu_lock();
+    p_hdr->ref++;
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+am_pubsub_topic_t *am_pubsub_topic_get (const void *p_payload)
+{
+    return __PUBSUB_HDR(p_payload)->p_topic;
+}
+
+/******************************************************************************/
+uint32_t am_pubsub_sub_lost_get (am_pubsub_sub_t *p_sub)
+{
+    return am_msgq_overflow_get(&p_sub->queue);
+}
+
+/* end of file */
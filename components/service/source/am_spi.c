@@ -16,12 +16,14 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add asynchronous write then read.
  * - 1.00 14-11-01  jon, first implementation.
  * \endinternal
  */
 
 #include "am_spi.h"
 #include "am_wait.h"
+#include "am_mempool.h"
 
 /**
  * \brief SPIϢɻص
@@ -35,35 +37,24 @@ static void __message_complete (void *p_arg)
 }
 
 /**
- * \brief д
+ * \brief дϢtrans ٰ 2 
  */
-int am_spi_write_then_read (am_spi_device_t *p_dev,
-                            const uint8_t   *p_txbuf,
-                            size_t           n_tx,
-                            uint8_t         *p_rxbuf,
-                            size_t           n_rx)
+static void __spi_write_then_read_msg_make (am_spi_message_t  *p_msg,
+                                            am_spi_transfer_t *p_trans,
+                                            const uint8_t     *p_txbuf,
+                                            size_t             n_tx,
+                                            uint8_t           *p_rxbuf,
+                                            size_t             n_rx,
+                                            am_pfnvoid_t       pfn_complete,
+                                            void              *p_arg)
 {
-    am_spi_transfer_t trans[2];
-    am_wait_t         msg_wait;
-    am_spi_message_t  spi_msg;
-    
-    if (p_dev == NULL) {
-        return -AM_EINVAL;
-    }
-    
-    if(p_txbuf == NULL && p_rxbuf == NULL) {
-        return AM_OK;
-    }
-    
-    am_wait_init(&msg_wait);
-    
-    am_spi_msg_init(&spi_msg,
-                    __message_complete,
-                    (void *)&msg_wait);
+    am_spi_msg_init(p_msg,
+                    pfn_complete,
+                    p_arg);
     
     if ((p_txbuf != NULL) && (n_tx != 0)) {
         
-        am_spi_mktrans(&trans[0], 
+        am_spi_mktrans(&p_trans[0], 
                         p_txbuf,
                         NULL,
                         n_tx,
@@ -73,12 +64,12 @@ int am_spi_write_then_read (am_spi_device_t *p_dev,
                         0,
                         0);
         
-        am_spi_trans_add_tail(&spi_msg, &trans[0]);
+        am_spi_trans_add_tail(p_msg, &p_trans[0]);
     }
     
     if ((p_rxbuf != NULL) && (n_rx != 0)) {
         
-        am_spi_mktrans(&trans[1], 
+        am_spi_mktrans(&p_trans[1], 
                         NULL,
                         p_rxbuf,
                         n_rx,
@@ -88,8 +79,41 @@ int am_spi_write_then_read (am_spi_device_t *p_dev,
                         0,
                         0);
         
-        am_spi_trans_add_tail(&spi_msg, &trans[1]);
+        am_spi_trans_add_tail(p_msg, &p_trans[1]);
     }
+}
+
+/**
+ * \brief д
+ */
+int am_spi_write_then_read (am_spi_device_t *p_dev,
+                            const uint8_t   *p_txbuf,
+                            size_t           n_tx,
+                            uint8_t         *p_rxbuf,
+                            size_t           n_rx)
+{
+    am_spi_transfer_t trans[2];
+    am_wait_t         msg_wait;
+    am_spi_message_t  spi_msg;
+    
+    if (p_dev == NULL) {
+        return -AM_EINVAL;
+    }
+    
+    if(p_txbuf == NULL && p_rxbuf == NULL) {
+        return AM_OK;
+    }
+    
+    am_wait_init(&msg_wait);
+    
+    __spi_write_then_read_msg_make(&spi_msg,
+                                   trans,
+                                   p_txbuf,
+                                   n_tx,
+                                   p_rxbuf,
+                                   n_rx,
+                                   __message_complete,
+                                   (void *)&msg_wait);
     
     am_spi_msg_start(p_dev, &spi_msg);
     
@@ -162,4 +186,85 @@ int am_spi_write_then_write (am_spi_device_t *p_dev,
     return spi_msg.status;
 }
 
+#if (AM_SPI_ASYNC_REQ_NUM > 0)
+
+/**
+ * \brief 첽󣬴ڴз䣬ɺͷ
+ */
+struct __spi_async_req {
+    am_spi_message_t   msg;
+    am_spi_transfer_t  trans[2];
+    am_spi_async_cb_t  pfn_cb;
+    void              *p_arg;
+};
+
+/** \brief 첽ڴ */
+AM_MEMPOOL_DEFINE(__g_spi_async_pool,
+                  sizeof(struct __spi_async_req),
+                  AM_SPI_ASYNC_REQ_NUM);
+
+/**
+ * \brief 첽Ϣɣͷ֪ͨûصпµ
+ */
+static void __spi_async_complete (void *p_arg)
+{
+    struct __spi_async_req *p_req  = (struct __spi_async_req *)p_arg;
+    am_spi_async_cb_t       pfn_cb = p_req->pfn_cb;
+    void                   *p_usr  = p_req->p_arg;
+    int                     status = p_req->msg.status;
+
+    am_mempool_free(&__g_spi_async_pool, p_req);
+
+    if (pfn_cb != NULL) {
+        pfn_cb(p_usr, status);
+    }
+}
+
+/**
+ * \brief 첽д
+ */
+int am_spi_write_then_read_async (am_spi_device_t   *p_dev,
+                                  const uint8_t     *p_txbuf,
+                                  size_t             n_tx,
+                                  uint8_t           *p_rxbuf,
+                                  size_t             n_rx,
+                                  am_spi_async_cb_t  pfn_cb,
+                                  void              *p_arg)
+{
+    struct __spi_async_req *p_req;
+    int                     ret;
+
+    if ((p_dev == NULL) || ((p_txbuf == NULL) && (p_rxbuf == NULL))) {
+        return -AM_EINVAL;
+    }
+
+    p_req = (struct __spi_async_req *)am_mempool_alloc(&__g_spi_async_pool);
+
+    if (p_req == NULL) {
+        return -AM_ENOMEM;
+    }
+
+    p_req->pfn_cb = pfn_cb;
+    p_req->p_arg  = p_arg;
+
+    __spi_write_then_read_msg_make(&p_req->msg,
+                                   p_req->trans,
+                                   p_txbuf,
+                                   n_tx,
+                                   p_rxbuf,
+                                   n_rx,
+                                   __spi_async_complete,
+                                   p_req);
+
+    ret = am_spi_msg_start(p_dev, &p_req->msg);
+
+    if (ret != AM_OK) {
+        am_mempool_free(&__g_spi_async_pool, p_req);
+    }
+
+    return ret;
+}
+
+#endif /* (AM_SPI_ASYNC_REQ_NUM > 0) */
+
 /* end of file */
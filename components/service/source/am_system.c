@@ -29,6 +29,13 @@
 volatile static unsigned long __g_systick;
 volatile static unsigned long __g_clkrate;
 
+/* tickless mode: ticks elapsed in hardware but not yet announced */
+static am_tick_t (*__gpfn_elapsed_get) (void *p_arg) = NULL;
+static void      *__gp_elapsed_arg                   = NULL;
+
+/* last value returned in tickless mode, keeps the tick count monotonic */
+static am_tick_t  __g_systick_last;
+
 /*******************************************************************************
   Public Functions
 *******************************************************************************/
@@ -50,10 +57,54 @@ int am_system_module_tick (void)
     return 0;
 }
 
+/******************************************************************************/
+int am_system_module_announce (am_tick_t ticks)
+{
+    int key = am_int_cpu_lock();
+    __g_systick += ticks;
+    am_int_cpu_unlock(key);
+
+    return 0;
+}
+
+/******************************************************************************/
+void am_system_module_tickless_set (am_tick_t (*pfn_elapsed_get) (void *),
+                                    void       *p_arg)
+{
+    int key = am_int_cpu_lock();
+
+    __gpfn_elapsed_get = pfn_elapsed_get;
+    __gp_elapsed_arg   = p_arg;
+    __g_systick_last   = __g_systick;
+
+    am_int_cpu_unlock(key);
+}
+
 /******************************************************************************/
 am_tick_t am_sys_tick_get (void)
 {
-    return __g_systick;
+    am_tick_t tick;
+    int       key;
+
+    if (__gpfn_elapsed_get == NULL) {
+        return __g_systick;
+    }
+
+    key  = am_int_cpu_lock();
+    tick = __g_systick + __gpfn_elapsed_get(__gp_elapsed_arg);
+
+    /*
+     * the counter may have wrapped before its interrupt announced the period,
+     * never let the tick count go backwards
+     */
+    if ((long)(tick - __g_systick_last) < 0) {
+        tick = __g_systick_last;
+    } else {
+        __g_systick_last = tick;
+    }
+    am_int_cpu_unlock(key);
+
+    return tick;
 }
 
 /******************************************************************************/
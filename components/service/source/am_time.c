@@ -16,9 +16,12 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-17  use leveled log macros
  * - 1.00 13-09-04  zen, first implementation
  * \endinternal
  */
+#define AM_LOG_MODULE   AM_LOG_MOD_TIME
+
 #include "ametal.h"
 #include "am_time.h"
 #include "am_softimer.h"
@@ -161,7 +164,7 @@ int am_tm_set (am_tm_t *p_tm)
 
     /* set time to RTC */
     if (am_rtc_time_set(p_clock->rtc_handle, p_tm) != AM_OK) {
-        AM_ERRF(("[am_time]:Save time to RTC failed!\n"));
+        AM_LOGE("[am_time]:Save time to RTC failed!\n");
     }
 
     return AM_OK;
@@ -228,13 +231,13 @@ int am_time_update (void)
         am_tm_to_time(&tm, &timespec.tv_sec);
         timespec.tv_nsec = 0;
 
-        AM_DBG_INFO("Update the time!\n");
+        AM_LOGD("Update the time!\n");
 
         /* set time */
         __timespec_set(&timespec);
 
     } else {
-        AM_DBG_INFO("[am_time]:Restore time from RTC failed!\n");
+        AM_LOGW("[am_time]:Restore time from RTC failed!\n");
         return AM_ERROR;
     }
 
@@ -290,19 +293,19 @@ int am_time_init (void           *rtc_handle,
         am_tm_to_time(&tm, &timespec.tv_sec);
         timespec.tv_nsec = 0;
 
-        AM_DBG_INFO("current time: %d-%02d-%02d %02d:%02d:%02d\n",
-                    tm.tm_year+1900,
-                    tm.tm_mon+1,
-                    tm.tm_mday,
-                    tm.tm_hour,
-                    tm.tm_min,
-                    tm.tm_sec);
+        AM_LOGI("current time: %d-%02d-%02d %02d:%02d:%02d\n",
+                tm.tm_year+1900,
+                tm.tm_mon+1,
+                tm.tm_mday,
+                tm.tm_hour,
+                tm.tm_min,
+                tm.tm_sec);
 
         /* set time */
         __timespec_set(&timespec);
 
     } else {
-        AM_DBG_INFO("[am_time]:Restore time from RTC failed!\n");
+        AM_LOGW("[am_time]:Restore time from RTC failed!\n");
     }
 
     /* TODO: set C library's time */
@@ -0,0 +1,185 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ߾ʱʵ
+ *
+ * תӦļֵ׼ֵΪ 64 λCortex-M0 ޷һζд˱
+ * ݣתʱֻµǰδʹõһݣٸлȡʱŷ仯
+ * ¶ȡŵĶдΪ 32 λʣȡʱжϡ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+#include "ametal.h"
+#include "am_timer.h"
+#include "am_timestamp.h"
+
+/*******************************************************************************
+  Global Variables
+*******************************************************************************/
+
+/** \brief ʱʹõĶʱ */
+static am_timer_handle_t __g_ts_handle = NULL;
+static uint8_t           __g_ts_chan   = 0;
+
+/** \brief Ƶ */
+static uint32_t          __g_ts_freq   = 0;
+
+/** \brief һʱڵļֵ */
+static uint32_t          __g_ts_period = 0;
+
+/** \brief ȡʱתжϹ״̬ */
+static am_bool_t       (*__gpfn_ts_pending) (void *p_arg) = NULL;
+static void             *__gp_ts_pending_arg              = NULL;
+
+/** \brief ׼ֵţλΪǰʹõĻ׼ֵ */
+static volatile uint32_t       __g_ts_seq     = 0;
+
+/** \brief ׼ֵʱһηתʱʱ */
+static volatile am_timestamp_t __g_ts_base[2] = {0, 0};
+
+/*******************************************************************************
+  Local Functions
+*******************************************************************************/
+
+/*  val * mul / divм */
+static uint64_t __ts_scale (uint64_t val, uint32_t mul, uint32_t div)
+{
+    return (val / div) * mul + (val % div) * mul / div;
+}
+
+/*******************************************************************************
+  Public Functions
+*******************************************************************************/
+int am_timestamp_module_init (am_timer_handle_t   handle,
+                              uint8_t             chan,
+                              am_bool_t         (*pfn_pending) (void *),
+                              void               *p_arg)
+{
+    const am_timer_info_t *p_info   = NULL;
+    uint32_t               freq     = 0;
+    uint32_t               rollover = 0;
+
+    if (NULL == handle) {
+        return -AM_EINVAL;
+    }
+
+    p_info = am_timer_info_get(handle);
+
+    if ((!(AM_TIMER_INTERMEDIATE_COUNT & p_info->features)) ||
+        (AM_TIMER_STOP_WHILE_READ & p_info->features)) {
+        return -AM_ENOTSUP;
+    }
+
+    if ((chan >= p_info->chan_num) ||
+        (am_timer_count_freq_get(handle, chan, &freq) != AM_OK) ||
+        (am_timer_rollover_get(handle, chan, &rollover) != AM_OK) ||
+        (freq == 0) ||
+        (rollover == 0)) {
+        return -AM_EINVAL;
+    }
+
+    __g_ts_handle       = NULL;
+    __g_ts_chan         = chan;
+    __g_ts_freq         = freq;
+    __g_ts_period       = rollover + 1;
+    __gpfn_ts_pending   = pfn_pending;
+    __gp_ts_pending_arg = p_arg;
+    __g_ts_base[0]      = 0;
+    __g_ts_base[1]      = 0;
+    __g_ts_seq          = 0;
+    __g_ts_handle       = handle;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_timestamp_module_rollover (void)
+{
+    uint32_t seq = __g_ts_seq;
+
+    /* ȸδʹõһݣлţڼȡľֵ */
+    __g_ts_base[(seq + 1) & 0x01] = __g_ts_base[seq & 0x01] + __g_ts_period;
+
+    __g_ts_seq = seq + 1;
+}
+
+/******************************************************************************/
+am_timestamp_t am_timestamp_get (void)
+{
+    am_timestamp_t base;
+    uint32_t       count;
+    uint32_t       seq;
+
+    if (NULL == __g_ts_handle) {
+        return 0;
+    }
+
+    do {
+        seq  = __g_ts_seq;
+        base = __g_ts_base[seq & 0x01];
+
+        am_timer_count_get(__g_ts_handle, __g_ts_chan, &count);
+
+        /*
+         * ʱѷתжϻδжڼڸȼжУ
+         * ¶ȡֵȷΪתֵһʱ
+         */
+        if ((__gpfn_ts_pending != NULL) &&
+            __gpfn_ts_pending(__gp_ts_pending_arg)) {
+            am_timer_count_get(__g_ts_handle, __g_ts_chan, &count);
+            base += __g_ts_period;
+        }
+
+    /* ȡڼ䷢˷ת¶ȡ */
+    } while (seq != __g_ts_seq);
+
+    return base + count;
+}
+
+/******************************************************************************/
+uint32_t am_timestamp_freq_get (void)
+{
+    return __g_ts_freq;
+}
+
+/******************************************************************************/
+uint64_t am_timestamp_to_ns (am_timestamp_t ts)
+{
+    if (0 == __g_ts_freq) {
+        return 0;
+    }
+
+    return __ts_scale(ts, 1000000000ul, __g_ts_freq);
+}
+
+/******************************************************************************/
+uint64_t am_timestamp_to_us (am_timestamp_t ts)
+{
+    if (0 == __g_ts_freq) {
+        return 0;
+    }
+
+    return __ts_scale(ts, 1000000ul, __g_ts_freq);
+}
+
+/******************************************************************************/
+am_timestamp_t am_timestamp_from_us (uint64_t us)
+{
+    return __ts_scale(us, __g_ts_freq, 1000000ul);
+}
+
+/* end of file */
@@ -16,6 +16,7 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.02 26-10-17  add am_uart_rngbuf_nread_get()
  * - 1.01 15-07-15  bob, add UART flowctrl mode
  * - 1.01 14-12-03  jon, add UART interrupt mode
  * - 1.00 14-11-01  tee, first implementation.
@@ -274,6 +275,17 @@ int am_uart_rngbuf_receive (am_uart_rngbuf_handle_t   handle,
     return len;
 }
 
+/******************************************************************************/
+/**
+ * \brief UART rx readable bytes
+ */
+uint32_t am_uart_rngbuf_nread_get (am_uart_rngbuf_handle_t handle)
+{
+    am_uart_rngbuf_dev_t *p_dev = (am_uart_rngbuf_dev_t *)handle;
+
+    return am_rngbuf_nbytes(&p_dev->rx_rngbuf);
+}
+
 /******************************************************************************/
 /**
  * \brief UART rx trigger cfg
@@ -0,0 +1,205 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʱڴʵ
+ *
+ * ڴһջÿڴͷлǰķλúͽַ
+ * λʱγջָ˱ֻ¼λú͵ʱڵĺڴ顣
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_arena.h"
+#include "am_memheap.h"
+
+/**
+ * \brief ڴͷΪɷĿռ
+ */
+struct am_arena_chunk {
+    struct am_arena_chunk *p_prev;       /**< \brief ǰһڴ         */
+    char                  *p_cur;        /**< \brief лǰķλ         */
+    char                  *p_end;        /**< \brief лǰĽַ         */
+};
+
+/******************************************************************************/
+
+/* Ӷзһ size ֽڿÿռĺڴ飬лڴ */
+static int __arena_chunk_push (am_arena_t arena, size_t size)
+{
+    struct am_arena_chunk *p_chunk;
+
+    if (arena->p_heap == NULL) {
+        return -AM_ENOMEM;
+    }
+
+    if (size < arena->chunk_size) {
+        size = arena->chunk_size;
+    }
+
+    p_chunk = (struct am_arena_chunk *)am_memheap_alloc(
+                                           arena->p_heap,
+                                           sizeof(struct am_arena_chunk) + size);
+    if (p_chunk == NULL) {
+        return -AM_ENOMEM;
+    }
+
+    p_chunk->p_prev = arena->p_chunk;
+    p_chunk->p_cur  = arena->p_cur;
+    p_chunk->p_end  = arena->p_end;
+
+    arena->p_chunk  = p_chunk;
+    arena->p_cur    = (char *)(p_chunk + 1);
+    arena->p_end    = arena->p_cur + size;
+    arena->fallback++;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+
+/* 黹ĺڴ飬ָлǰ״̬ */
+static void __arena_chunk_pop (am_arena_t arena)
+{
+    struct am_arena_chunk *p_chunk = arena->p_chunk;
+
+    arena->p_chunk = p_chunk->p_prev;
+    arena->p_cur   = p_chunk->p_cur;
+    arena->p_end   = p_chunk->p_end;
+
+    am_memheap_free(p_chunk);
+}
+
+/******************************************************************************/
+int am_arena_init (struct am_arena *p_arena, void *p_buf, size_t size)
+{
+    if ((p_arena == NULL) || ((p_buf == NULL) && (size != 0))) {
+        return -AM_EINVAL;
+    }
+
+    p_arena->p_start    = (char *)p_buf;
+    p_arena->p_cur      = (char *)p_buf;
+    p_arena->p_end      = (char *)p_buf + size;
+    p_arena->p_chunk    = NULL;
+    p_arena->p_heap     = NULL;
+    p_arena->chunk_size = 0;
+    p_arena->used_max   = 0;
+    p_arena->fallback   = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_arena_fallback_set (am_arena_t         arena,
+                           struct am_memheap *p_heap,
+                           size_t             chunk_size)
+{
+    if (arena == NULL) {
+        return -AM_EINVAL;
+    }
+
+    arena->p_heap     = p_heap;
+    arena->chunk_size = chunk_size;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void *am_arena_alloc_align (am_arena_t arena, size_t size, size_t align)
+{
+    char *p;
+
+    if ((align == 0) || ((align & (align - 1)) != 0)) {
+        return NULL;
+    }
+
+    /* λʼհָС */
+    if (align < sizeof(void *)) {
+        align = sizeof(void *);
+    }
+    size = AM_ROUND_UP(size, sizeof(void *));
+
+    p = (char *)AM_ROUND_UP((uint32_t)arena->p_cur, align);
+
+    if ((p > arena->p_end) || ((size_t)(arena->p_end - p) < size)) {
+
+        /* ڴʼַָֻ֤С */
+        if (__arena_chunk_push(arena, size + align - sizeof(void *)) != AM_OK) {
+            return NULL;
+        }
+        p = (char *)AM_ROUND_UP((uint32_t)arena->p_cur, align);
+    }
+
+    arena->p_cur = p + size;
+
+    if ((arena->p_chunk == NULL) &&
+        ((size_t)(arena->p_cur - arena->p_start) > arena->used_max)) {
+        arena->used_max = arena->p_cur - arena->p_start;
+    }
+
+    return p;
+}
+
+/******************************************************************************/
+void *am_arena_alloc (am_arena_t arena, size_t size)
+{
+    return am_arena_alloc_align(arena, size, sizeof(void *));
+}
+
+/******************************************************************************/
+am_arena_mark_t am_arena_mark (am_arena_t arena)
+{
+    am_arena_mark_t mark;
+
+    mark.p_cur   = arena->p_cur;
+    mark.p_chunk = arena->p_chunk;
+
+    return mark;
+}
+
+/******************************************************************************/
+void am_arena_reset_to (am_arena_t arena, am_arena_mark_t mark)
+{
+    while ((arena->p_chunk != mark.p_chunk) && (arena->p_chunk != NULL)) {
+        __arena_chunk_pop(arena);
+    }
+
+    arena->p_cur = mark.p_cur;
+}
+
+/******************************************************************************/
+void am_arena_reset (am_arena_t arena)
+{
+    while (arena->p_chunk != NULL) {
+        __arena_chunk_pop(arena);
+    }
+
+    arena->p_cur = arena->p_start;
+}
+
+/******************************************************************************/
+size_t am_arena_high_water_get (am_arena_t arena)
+{
+    return arena->used_max;
+}
+
+/******************************************************************************/
+uint32_t am_arena_fallback_get (am_arena_t arena)
+{
+    return arena->fallback;
+}
+
+/* end of file */
@@ -0,0 +1,227 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ־ʵ
+ *
+ * д뷽жУдʱرжϣÿ־д嶪ȡֻ
+ * һҪжϡ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_binlog.h"
+#include "am_rngbuf.h"
+#include "am_timestamp.h"
+#include "am_int.h"
+
+/** \brief ־ͷȣֽͬڡIDʱ */
+#define __BINLOG_HDR_SIZE    10
+
+/** \brief ־󳤶 */
+#define __BINLOG_REC_MAX     (__BINLOG_HDR_SIZE + 4 * AM_BINLOG_ARGS_MAX)
+
+/** \brief ־Ϣ */
+static struct __binlog {
+    struct am_rngbuf  rb;           /**< \brief ־               */
+    uint32_t          lost;         /**< \brief δ¼Ķʧ       */
+    uint32_t          dropped;      /**< \brief ־ۼƣ   */
+    am_bool_t         init;         /**< \brief Ƿѳʼ             */
+} __g_binlog;
+
+/******************************************************************************/
+
+/* С˸ʽ 32 λ */
+static uint8_t *__binlog_u32_put (uint8_t *p, uint32_t val)
+{
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+    p[2] = (uint8_t)(val >> 16);
+    p[3] = (uint8_t)(val >> 24);
+
+    return p + 4;
+}
+
+/******************************************************************************/
+
+/* һ־س */
+static size_t __binlog_rec_make (uint8_t        *p_rec,
+                                 uint32_t        id,
+                                 uint32_t        ts,
+                                 const uint32_t *p_args,
+                                 unsigned        nargs)
+{
+    uint8_t  *p = p_rec;
+    unsigned  i;
+
+    *p++ = AM_BINLOG_SYNC;
+    *p++ = (uint8_t)nargs;
+    p    = __binlog_u32_put(p, id);
+    p    = __binlog_u32_put(p, ts);
+
+    for (i = 0; i < nargs; i++) {
+        p = __binlog_u32_put(p, p_args[i]);
+    }
+
+    return (size_t)(p - p_rec);
+}
+
+/******************************************************************************/
+
+/* дһ־жϵãռ䲻ʱ */
+static void __binlog_rec_put_locked (uint32_t        id,
+                                     uint32_t        ts,
+                                     const uint32_t *p_args,
+                                     unsigned        nargs)
+{
+    uint8_t rec[__BINLOG_REC_MAX];
+    size_t  len;
+    size_t  need;
+
+    len  = __binlog_rec_make(rec, id, ts, p_args, nargs);
+    need = len;
+
+    /* ֮ǰжʧ־ռ㹻ʱд붪ʧ¼ */
+    if (__g_binlog.lost != 0) {
+        need += __BINLOG_HDR_SIZE + 4;
+    }
+
+    if (am_rngbuf_freebytes(&__g_binlog.rb) < need) {
+        __g_binlog.lost++;
+        __g_binlog.dropped++;
+        return;
+    }
+
+    if (__g_binlog.lost != 0) {
+        uint8_t lost_rec[__BINLOG_HDR_SIZE + 4];
+
+        (void)am_rngbuf_put(&__g_binlog.rb,
+                            (const char *)lost_rec,
+                            __binlog_rec_make(lost_rec,
+                                              AM_BINLOG_ID_LOST,
+                                              ts,
+                                              &__g_binlog.lost,
+                                              1));
+        __g_binlog.lost = 0;
+    }
+
+    (void)am_rngbuf_put(&__g_binlog.rb, (const char *)rec, len);
+}
+
+/******************************************************************************/
+int am_binlog_init (char *p_buf, size_t size)
+{
+    uint32_t freq;
+    int      ret;
+    int      key;
+
+    if ((p_buf == NULL) || (size <= __BINLOG_REC_MAX)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    ret = am_rngbuf_init(&__g_binlog.rb, p_buf, size);
+    if (ret == AM_OK) {
+        __g_binlog.lost    = 0;
+        __g_binlog.dropped = 0;
+        __g_binlog.init    = AM_TRUE;
+
+        freq = am_timestamp_freq_get();
+        __binlog_rec_put_locked(AM_BINLOG_ID_FREQ,
+                                (uint32_t)am_timestamp_get(),
+                                &freq,
+                                1);
+    }
+
+    am_int_cpu_unlock(key);
+
+    return ret;
+}
+
+/******************************************************************************/
+void am_binlog_write (const char     *p_fmt,
+                      const uint32_t *p_args,
+                      unsigned        nargs)
+{
+    int key;
+
+    if (!__g_binlog.init) {
+        return;
+    }
+
+    if (nargs > AM_BINLOG_ARGS_MAX) {
+        nargs = AM_BINLOG_ARGS_MAX;
+    }
+
+    key = am_int_cpu_lock();
+
+    __binlog_rec_put_locked((uint32_t)p_fmt,
+                            (uint32_t)am_timestamp_get(),
+                            p_args,
+                            nargs);
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+size_t am_binlog_read (void *p_buf, size_t size)
+{
+    if (!__g_binlog.init) {
+        return 0;
+    }
+
+    return am_rngbuf_get(&__g_binlog.rb, (char *)p_buf, size);
+}
+
+/******************************************************************************/
+size_t am_binlog_uart_drain (am_uart_handle_t handle)
+{
+    am_rngbuf_span_t span[2];
+    size_t           total = 0;
+    size_t           len;
+
+    if (!__g_binlog.init) {
+        return 0;
+    }
+
+    /* ֱӴӻͣҪ */
+    while ((len = am_rngbuf_read_peek(&__g_binlog.rb, (size_t)-1, span)) != 0) {
+
+        (void)am_uart_poll_send(handle,
+                                (const uint8_t *)span[0].p_buf,
+                                span[0].len);
+
+        if (span[1].len != 0) {
+            (void)am_uart_poll_send(handle,
+                                    (const uint8_t *)span[1].p_buf,
+                                    span[1].len);
+        }
+
+        am_rngbuf_read_release(&__g_binlog.rb, len);
+        total += len;
+    }
+
+    return total;
+}
+
+/******************************************************************************/
+uint32_t am_binlog_dropped_get (void)
+{
+    return __g_binlog.dropped;
+}
+
+/* end of file */
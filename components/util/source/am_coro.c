@@ -0,0 +1,142 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ջЭʵ
+ *
+ * ЭһʽУһЭ̺Э̺
+ * ڵȴ㷵ءڴǰѴӶȡɻصЭ̺
+ * ǰʱҲٴμУᶪʧѡ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  clear the pending flag on completion and timer expiry
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_coro.h"
+#include "am_isr_defer.h"
+
+/******************************************************************************/
+
+/* ЭУڶʱ -AM_EBUSY */
+static int __coro_post (am_coro_t *p_coro)
+{
+    if (p_coro->jobq == NULL) {
+        return am_isr_defer_job_add(&p_coro->job);
+    }
+
+    return am_jobq_post(p_coro->jobq, &p_coro->job);
+}
+
+/******************************************************************************/
+
+/* ЭĴ */
+static void __coro_job (void *p_arg)
+{
+    am_coro_t *p_coro = (am_coro_t *)p_arg;
+
+    if (p_coro->exited) {
+        return;
+    }
+
+    if (p_coro->pfn(p_coro, p_coro->p_arg) == AM_CORO_EXITED) {
+        am_softimer_stop(&p_coro->timer);
+        p_coro->exited = AM_TRUE;
+    }
+}
+
+/******************************************************************************/
+
+/* ʱʱΪڶʱֹͣ */
+static void __coro_timer_cb (void *p_arg)
+{
+    am_coro_t *p_coro = (am_coro_t *)p_arg;
+
+    am_softimer_stop(&p_coro->timer);
+    p_coro->pending = AM_FALSE;
+    am_coro_wake(p_coro);
+}
+
+/******************************************************************************/
+int am_coro_init (am_coro_t        *p_coro,
+                  am_jobq_handle_t  jobq,
+                  am_coro_func_t    pfn,
+                  void             *p_arg,
+                  uint16_t          pri)
+{
+    if ((p_coro == NULL) || (pfn == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    p_coro->jobq    = jobq;
+    p_coro->pfn     = pfn;
+    p_coro->p_arg   = p_arg;
+    p_coro->lc      = 0;
+    p_coro->exited  = AM_TRUE;
+    p_coro->status  = AM_OK;
+    p_coro->result  = AM_OK;
+    p_coro->pending = AM_FALSE;
+
+    am_jobq_job_init(&p_coro->job, __coro_job, p_coro, pri);
+
+    return am_softimer_init(&p_coro->timer, __coro_timer_cb, p_coro);
+}
+
+/******************************************************************************/
+int am_coro_start (am_coro_t *p_coro)
+{
+    int ret;
+
+    if (!p_coro->exited) {
+        return -AM_EBUSY;
+    }
+
+    p_coro->lc      = 0;
+    p_coro->status  = AM_OK;
+    p_coro->pending = AM_FALSE;
+    p_coro->exited  = AM_FALSE;
+
+    ret = __coro_post(p_coro);
+    if (ret != AM_OK) {
+        p_coro->exited = AM_TRUE;
+    }
+
+    return ret;
+}
+
+/******************************************************************************/
+void am_coro_wake (void *p_coro)
+{
+    /* ڶʱ -AM_EBUSYλ֮ϲ */
+    (void)__coro_post((am_coro_t *)p_coro);
+}
+
+/******************************************************************************/
+void am_coro_resume_cb (void *p_coro, int status)
+{
+    /* ȱȴ־Э̿ pending Ϊ AM_FALSE ʱЧ */
+    ((am_coro_t *)p_coro)->result  = status;
+    ((am_coro_t *)p_coro)->pending = AM_FALSE;
+
+    am_coro_wake(p_coro);
+}
+
+/******************************************************************************/
+am_bool_t am_coro_is_exited (am_coro_t *p_coro)
+{
+    return p_coro->exited;
+}
+
+/* end of file */
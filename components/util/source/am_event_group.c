@@ -0,0 +1,173 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ¼־ʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  timeout timer moved from the group to each wait call
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_event_group.h"
+#include "am_wait.h"
+#include "am_int.h"
+
+/**
+ * \brief һεȴĳʱ״̬λڵȴߵջ
+ */
+struct __event_group_waiter {
+    am_softimer_t      timer;      /**< \brief ڳʱʱ  */
+    volatile am_bool_t timeout;    /**< \brief ȴʱ                  */
+};
+
+/******************************************************************************/
+
+/* ʱʱΪڶʱֹͣ */
+static void __event_group_timer_cb (void *p_arg)
+{
+    struct __event_group_waiter *p_waiter;
+
+    p_waiter          = (struct __event_group_waiter *)p_arg;
+    p_waiter->timeout = AM_TRUE;
+
+    am_softimer_stop(&p_waiter->timer);
+}
+
+/******************************************************************************/
+
+/* ¼־Ƿȴ */
+static am_bool_t __event_group_match (uint32_t cur,
+                                      uint32_t bits,
+                                      uint32_t flags)
+{
+    if (flags & AM_EVENT_GROUP_WAIT_ALL) {
+        return (am_bool_t)((cur & bits) == bits);
+    }
+
+    return (am_bool_t)((cur & bits) != 0);
+}
+
+/******************************************************************************/
+int am_event_group_init (am_event_group_t *p_grp)
+{
+    if (p_grp == NULL) {
+        return -AM_EINVAL;
+    }
+
+    p_grp->bits = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+uint32_t am_event_group_set (am_event_group_t *p_grp, uint32_t bits)
+{
+    uint32_t cur;
+    int      key;
+
+    key = am_int_cpu_lock();
+
+    cur         = p_grp->bits | bits;
+    p_grp->bits = cur;
+
+    am_int_cpu_unlock(key);
+
+    return cur;
+}
+
+/******************************************************************************/
+uint32_t am_event_group_clear (am_event_group_t *p_grp, uint32_t bits)
+{
+    uint32_t cur;
+    int      key;
+
+    key = am_int_cpu_lock();
+
+    cur         = p_grp->bits;
+    p_grp->bits = cur & ~bits;
+
+    am_int_cpu_unlock(key);
+
+    return cur;
+}
+
+/******************************************************************************/
+uint32_t am_event_group_get (am_event_group_t *p_grp)
+{
+    return p_grp->bits;
+}
+
+/******************************************************************************/
+int am_event_group_wait (am_event_group_t *p_grp,
+                         uint32_t          bits,
+                         uint32_t          flags,
+                         uint32_t          timeout_ms,
+                         uint32_t         *p_bits)
+{
+    struct __event_group_waiter waiter;
+    uint32_t                    cur;
+    int                         ret = AM_OK;
+    int                         key;
+
+    if ((p_grp == NULL) || (bits == 0)) {
+        return -AM_EINVAL;
+    }
+
+    waiter.timeout = AM_FALSE;
+
+    if (timeout_ms != 0) {
+        am_softimer_init(&waiter.timer, __event_group_timer_cb, &waiter);
+        am_softimer_start(&waiter.timer, timeout_ms);
+    }
+
+    key = am_int_cpu_lock();
+
+    /* жϺ飬֮䲻µλ */
+    while (!__event_group_match(p_grp->bits, bits, flags)) {
+
+        if (waiter.timeout) {
+            ret = -AM_ETIME;
+            break;
+        }
+
+        am_wait_idle();
+
+        /* жϣ CPU ж */
+        am_int_cpu_unlock(key);
+        key = am_int_cpu_lock();
+    }
+
+    cur = p_grp->bits;
+
+    if ((ret == AM_OK) && (flags & AM_EVENT_GROUP_CLEAR)) {
+        p_grp->bits = cur & ~bits;
+    }
+
+    am_int_cpu_unlock(key);
+
+    /* ʱλջϣǰֹͣ */
+    if (timeout_ms != 0) {
+        am_softimer_stop(&waiter.timer);
+    }
+
+    if (p_bits != NULL) {
+        *p_bits = cur;
+    }
+
+    return ret;
+}
+
+/* end of file */
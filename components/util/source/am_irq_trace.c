@@ -0,0 +1,130 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief жϸʵ
+ *
+ * ¼ж˳ʱд룬Ƕ׵жڱϵжд룬дʱرжϡ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_irq_trace.h"
+#include "am_timestamp.h"
+#include "am_vdebug.h"
+#include "am_int.h"
+
+#if (AM_IRQ_TRACE_ENABLE != 0)
+
+/** \brief жϸټ¼ */
+am_irq_trace_t g_am_irq_trace = {
+    AM_IRQ_TRACE_MAGIC,
+    0,
+    AM_IRQ_TRACE_REC_NUM,
+    0,
+    0,
+    {{0}},
+};
+
+/******************************************************************************/
+uint32_t am_irq_trace_enter (void)
+{
+    if (!g_am_irq_trace.enabled) {
+        return 0;
+    }
+
+    return (uint32_t)am_timestamp_get();
+}
+
+/******************************************************************************/
+void am_irq_trace_exit (int inum, uint32_t ts)
+{
+    am_irq_trace_rec_t *p_rec;
+    uint32_t            now;
+    int                 key;
+
+    if (!g_am_irq_trace.enabled) {
+        return;
+    }
+
+    now = (uint32_t)am_timestamp_get();
+
+    key = am_int_cpu_lock();
+
+    p_rec = &g_am_irq_trace.recs[g_am_irq_trace.count % AM_IRQ_TRACE_REC_NUM];
+    g_am_irq_trace.count++;
+
+    p_rec->ts   = ts;
+    p_rec->dur  = now - ts;
+    p_rec->inum = (int16_t)inum;
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+void am_irq_trace_start (void)
+{
+    int key;
+
+    key = am_int_cpu_lock();
+
+    g_am_irq_trace.freq    = am_timestamp_freq_get();
+    g_am_irq_trace.count   = 0;
+    g_am_irq_trace.enabled = 1;
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+void am_irq_trace_stop (void)
+{
+    g_am_irq_trace.enabled = 0;
+}
+
+/******************************************************************************/
+void am_irq_trace_dump (void)
+{
+    const am_irq_trace_rec_t *p_rec;
+    uint32_t                  enabled = g_am_irq_trace.enabled;
+    uint32_t                  count;
+    uint32_t                  i;
+
+    g_am_irq_trace.enabled = 0;
+
+    count = g_am_irq_trace.count;
+    i     = (count > AM_IRQ_TRACE_REC_NUM) ? count - AM_IRQ_TRACE_REC_NUM : 0;
+
+    am_kprintf("#AM_IRQ_TRACE freq=%u count=%u\n",
+               (unsigned int)g_am_irq_trace.freq,
+               (unsigned int)count);
+
+    /* д˳ */
+    for (; i < count; i++) {
+        p_rec = &g_am_irq_trace.recs[i % AM_IRQ_TRACE_REC_NUM];
+        am_kprintf("@%d %u %u\n",
+                   (int)p_rec->inum,
+                   (unsigned int)p_rec->ts,
+                   (unsigned int)p_rec->dur);
+    }
+
+    am_kprintf("#AM_IRQ_TRACE_END\n");
+
+    g_am_irq_trace.enabled = enabled;
+}
+
+#endif /* (AM_IRQ_TRACE_ENABLE != 0) */
+
+/* end of file */
@@ -26,12 +26,15 @@
  *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-17  add counting/payload batch jobs, job_add reports -AM_EBUSY
+ * - 1.01 26-10-17  add am_isr_defer_job_process_budget()
  * - 1.00 15-09-23  tee, first implementation
  * \endinternal
  */
  
 #include "ametal.h"
 #include "am_isr_defer.h"
+#include "am_int.h"
  
 /*******************************************************************************
   Locals
@@ -68,17 +71,19 @@ void am_isr_defer_job_init (am_isr_defer_job_t  *p_job,
 /******************************************************************************/
 int am_isr_defer_job_add (am_isr_defer_job_t *p_job)
 {
+    int ret;
+
     if (__g_isr_defer_handle == NULL) {
         return -AM_EPERM;
     }
     
-    am_jobq_post(__g_isr_defer_handle, p_job);
+    ret = am_jobq_post(__g_isr_defer_handle, p_job);
  
-    if (__gpfn_trigger_cb) {
+    if ((ret == AM_OK) && __gpfn_trigger_cb) {
         __gpfn_trigger_cb(__gp_cb_arg);
     }
  
-    return AM_OK;
+    return ret;
 }
 
 /******************************************************************************/
@@ -87,4 +92,105 @@ int am_isr_defer_job_process (void)
     return am_jobq_process(__g_isr_defer_handle);
 }
 
+/******************************************************************************/
+int am_isr_defer_job_process_budget (const am_jobq_budget_t *p_budget,
+                                     unsigned int           *p_remain)
+{
+    return am_jobq_process_budget(__g_isr_defer_handle, p_budget, p_remain);
+}
+
+/******************************************************************************/
+
+/* ӳĴȡ¼ûĴ */
+static void __isr_defer_batch_job (void *p_arg)
+{
+    am_isr_defer_batch_t *p_batch = (am_isr_defer_batch_t *)p_arg;
+    uint32_t              count;
+    int                   key;
+
+    key = am_int_cpu_lock();
+    count          = p_batch->count;
+    p_batch->count = 0;
+    am_int_cpu_unlock(key);
+
+    /* ϴδʱѶȡЩ¼ */
+    if (count == 0) {
+        return;
+    }
+
+    p_batch->pfn_cb(p_batch->p_arg, count);
+}
+
+/******************************************************************************/
+int am_isr_defer_batch_init (am_isr_defer_batch_t    *p_batch,
+                             am_isr_defer_batch_cb_t  pfn_cb,
+                             void                    *p_arg,
+                             uint16_t                 pri,
+                             void                    *p_buf,
+                             size_t                   elem_size,
+                             size_t                   elem_num)
+{
+    if ((p_batch == NULL) || (pfn_cb == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    p_batch->has_data = (am_bool_t)(p_buf != NULL);
+
+    if (p_batch->has_data &&
+        (am_msgq_init(&p_batch->msgq, p_buf, elem_size, elem_num) != AM_OK)) {
+        return -AM_EINVAL;
+    }
+
+    p_batch->count  = 0;
+    p_batch->pfn_cb = pfn_cb;
+    p_batch->p_arg  = p_arg;
+
+    am_jobq_job_init(&p_batch->job, __isr_defer_batch_job, p_batch, pri);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_isr_defer_batch_post (am_isr_defer_batch_t *p_batch, const void *p_data)
+{
+    int ret = AM_OK;
+    int key;
+
+    if (__g_isr_defer_handle == NULL) {
+        return -AM_EPERM;
+    }
+
+    /* ڶжд룬жϱֻ֤һд뷽 */
+    key = am_int_cpu_lock();
+
+    p_batch->count++;
+
+    if (p_batch->has_data && (p_data != NULL)) {
+        ret = am_msgq_push(&p_batch->msgq, p_data);
+    }
+
+    am_int_cpu_unlock(key);
+
+    /* ڶʱ -AM_EBUSY¼ڸһ */
+    am_isr_defer_job_add(&p_batch->job);
+
+    return ret;
+}
+
+/******************************************************************************/
+int am_isr_defer_batch_read (am_isr_defer_batch_t *p_batch, void *p_data)
+{
+    if (!p_batch->has_data) {
+        return -AM_EAGAIN;
+    }
+
+    return am_msgq_pop(&p_batch->msgq, p_data);
+}
+
+/******************************************************************************/
+uint32_t am_isr_defer_batch_lost_get (am_isr_defer_batch_t *p_batch)
+{
+    return p_batch->has_data ? am_msgq_overflow_get(&p_batch->msgq) : 0;
+}
+
 /* end of file */
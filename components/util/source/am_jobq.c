@@ -21,6 +21,12 @@
  *
  * \internal
  * \par modification history:
+ * - 1.05 26-10-17  charge jobs run by am_jobq_process*() as JOB load again
+ * - 1.04 26-10-17  time budget uses the clock in am_jobq_budget_t; CPU load
+ *                  accounting moved to the callers
+ * - 1.03 26-10-17  add am_jobq_job_is_queued()
+ * - 1.02 26-10-17  add optional CPU load accounting
+ * - 1.01 26-10-17  add am_jobq_process_budget()
  * - 1.00 15-09-18  tee, first implementation
  * \endinternal
  */
@@ -28,6 +34,7 @@
 #include "am_jobq.h"
 #include "am_int.h"
 #include "am_bitops.h"
+#include "am_cpu_load.h"
 
 /*******************************************************************************
   ڲʹú궨
@@ -131,6 +138,8 @@ am_jobq_handle_t am_jobq_queue_init (am_jobq_queue_t     *p_jobq_queue,
     p_jobq_queue->p_heads      = p_heads;
     p_jobq_queue->pri_num      = pri_num;
     p_jobq_queue->p_bitmap_job = p_bitmap_job;
+    p_jobq_queue->flags        = 0;
+    p_jobq_queue->job_num      = 0;
  
     am_int_cpu_unlock(key);
     
@@ -152,6 +161,12 @@ void am_jobq_job_init (am_jobq_job_t  *p_job,
     am_list_head_init(&p_job->node);
 }
 
+/******************************************************************************/
+am_bool_t am_jobq_job_is_queued (am_jobq_job_t *p_job)
+{
+    return (p_job->flags & __JOBQ_JOB_ENQUEUED) ? AM_TRUE : AM_FALSE;
+}
+
 /******************************************************************************/
 int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
 {
@@ -183,6 +198,8 @@ int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
         /* ȼβ */
         am_list_add_tail(&p_job->node, &p_jobq_queue->p_heads[pri]);
 
+        p_jobq_queue->job_num++;
+
         am_int_cpu_unlock(key);
 
         return AM_OK;
@@ -194,79 +211,207 @@ int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
 }
  
 /******************************************************************************/
-int am_jobq_process (am_jobq_queue_t *p_jobq_queue)
+
+/*
+ * ȼֵС pri ȼû򷵻 -1ڹжʱ
+ */
+static int __jobq_pri_find (am_jobq_queue_t *p_jobq_queue, unsigned int pri)
 {
-    int             key;
-    am_pfnvoid_t    func;
-    void           *p_arg;
+    unsigned int grp;
+    unsigned int map;
+
+    if (pri >= p_jobq_queue->pri_num) {
+        return -1;
+    }
+
+    grp = pri >> 5;
+    map = p_jobq_queue->p_bitmap_job[grp] & (~0u << (pri & 0x1F));
+
+    /* ûУҺ */
+    if (map == 0) {
+        if (grp >= 31) {
+            return -1;
+        }
+
+        map = p_jobq_queue->bitmap_grp & (~0u << (grp + 1));
+        if (map == 0) {
+            return -1;
+        }
+
+        grp = __jobq_ffs(map) - 1;
+        map = p_jobq_queue->p_bitmap_job[grp];
+    }
+
+    return (grp << 5) + __jobq_ffs(map) - 1;
+}
+
+/******************************************************************************/
 
-    struct am_list_head *p_q;
+/*
+ * ȡָȼĵһڹжʱ
+ */
+static am_jobq_job_t *__jobq_job_take (am_jobq_queue_t *p_jobq_queue,
+                                       unsigned int     pri)
+{
+    struct am_list_head *p_q = &p_jobq_queue->p_heads[pri];
     am_jobq_job_t       *p_job;
- 
-    if (p_jobq_queue == NULL) {
+
+    /* ȡһ */
+    p_job = am_list_entry(p_q->next, am_jobq_job_t, node);
+
+    /* Ӷɾ */
+    am_list_del_init(p_q->next);
+
+    /* ȼΪգɾӦȼ־λ */
+    if (am_list_empty_careful(p_q)) {
+        __JOBQ_BITMAP_JOB_CLR(p_jobq_queue->p_bitmap_job, pri);
+
+        /* Ѿû */
+        if (p_jobq_queue->p_bitmap_job[pri >> 5] == 0) {
+            __JOBQ_BITMAP_GRP_CLR(p_jobq_queue->bitmap_grp, pri);
+        }
+    }
+
+    p_job->flags &= ~__JOBQ_JOB_ENQUEUED;
+    p_jobq_queue->job_num--;
+
+    return p_job;
+}
+
+/******************************************************************************/
+int am_jobq_process_budget (am_jobq_queue_t        *p_jobq_queue,
+                            const am_jobq_budget_t *p_budget,
+                            unsigned int           *p_remain)
+{
+    int                  key;
+    int                  ret   = AM_OK;
+    unsigned int         count = 0;       /* Ѵ           */
+    unsigned int         cur   = 0;       /* ʱǰȼ     */
+    unsigned int         run   = 0;       /* ǰȼѴĸ */
+    int                  pri;
+    am_pfnvoid_t         func;
+    void                *p_arg;
+    am_jobq_job_t       *p_job;
+    uint32_t             time_start = 0;  /* ʼʱ             */
+#if (AM_CPU_LOAD_ENABLE != 0)
+    int                  load_prev;
+#endif
+
+    if ((p_jobq_queue == NULL) ||
+        ((p_budget != NULL) && (p_budget->max_time != 0) &&
+         (p_budget->pfn_time_get == NULL))) {
         return -AM_EINVAL;
     }
-    
+
     /* ڴ */
     if ((p_jobq_queue->flags & __JOBQ_FLG_RUNNING) != 0) {
         return -AM_EBUSY;
     }
-    
+
     key = am_int_cpu_lock();
-   
+
     p_jobq_queue->flags |= __JOBQ_FLG_RUNNING;
 
     am_int_cpu_unlock(key);
 
-    while(1) {
+#if (AM_CPU_LOAD_ENABLE != 0)
+    load_prev = am_cpu_load_enter(AM_CPU_LOAD_JOB);
+#endif
+
+    if ((p_budget != NULL) && (p_budget->max_time != 0)) {
+        time_start = p_budget->pfn_time_get();
+    }
 
-        unsigned int pri;
+    while (1) {
 
         key = am_int_cpu_lock();
-        
-        /* κ */
-        if (p_jobq_queue->bitmap_grp == 0) {
-            p_jobq_queue->flags &= ~__JOBQ_FLG_RUNNING;
-            am_int_cpu_unlock(key);
-            return AM_OK;
-        }
-        
-        /* ҵȼߵ     */
-        pri = __jobq_ffs(p_jobq_queue->bitmap_grp) - 1;
- 
-        /* ҵȼߵеȼ */
-        pri = __jobq_ffs(p_jobq_queue->p_bitmap_job[pri]) - 1 + (pri << 5);
- 
-        /* Remove the job from the appropriate queue */
-        p_q = &p_jobq_queue->p_heads[pri];
 
-        /* ȡһ */
-        p_job = am_list_entry(p_q->next, am_jobq_job_t, node);
-        
-        /* Ӷɾ */
-        am_list_del_init(p_q->next);
-        
-        /* ȼΪգɾӦȼ־λ */
-        if (am_list_empty_careful(p_q)) {
-            __JOBQ_BITMAP_JOB_CLR(p_jobq_queue->p_bitmap_job, pri);
-            
-            /* Ѿû */
-            if (p_jobq_queue->p_bitmap_job[pri >> 5] == 0) {
-                __JOBQ_BITMAP_GRP_CLR(p_jobq_queue->bitmap_grp, pri);
+        pri = __jobq_pri_find(p_jobq_queue, cur);
+
+        if (p_budget == NULL) {
+
+            /* κ */
+            if (pri < 0) {
+                break;
+            }
+
+        } else {
+
+            /* ޿ɴ񣬴ȼʼµһ */
+            if (((pri < 0) || ((unsigned int)pri > p_budget->pri_limit)) &&
+                (cur != 0)) {
+                cur = 0;
+                run = 0;
+                pri = __jobq_pri_find(p_jobq_queue, 0);
+            }
+
+            /* ߽û */
+            if ((pri < 0) || ((unsigned int)pri > p_budget->pri_limit)) {
+                break;
+            }
+
+            /* Ԥ */
+            if (((p_budget->max_jobs != 0) && (count >= p_budget->max_jobs)) ||
+                ((p_budget->max_time != 0) && (count != 0) &&
+                 (p_budget->pfn_time_get() - time_start >=
+                  p_budget->max_time))) {
+                ret = -AM_EAGAIN;
+                break;
+            }
+
+            /* ǰȼֵһȼ */
+            if (p_budget->pri_quota != 0) {
+                if ((unsigned int)pri != cur) {
+                    cur = pri;
+                    run = 0;
+                }
+                if (++run >= p_budget->pri_quota) {
+                    cur = pri + 1;
+                    run = 0;
+                }
             }
         }
 
-        p_job->flags &= ~__JOBQ_JOB_ENQUEUED;
+        p_job = __jobq_job_take(p_jobq_queue, pri);
 
         func  = p_job->func;
         p_arg = p_job->p_arg;
-        
+
         am_int_cpu_unlock(key);
 
         if (func) {
             func(p_arg);
         }
+
+        count++;
+    }
+
+    /* ڹж״̬ */
+    p_jobq_queue->flags &= ~__JOBQ_FLG_RUNNING;
+
+    if (p_remain != NULL) {
+        *p_remain = p_jobq_queue->job_num;
     }
+
+    am_int_cpu_unlock(key);
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
+
+    return ret;
+}
+
+/******************************************************************************/
+int am_jobq_process (am_jobq_queue_t *p_jobq_queue)
+{
+    return am_jobq_process_budget(p_jobq_queue, NULL, NULL);
+}
+
+/******************************************************************************/
+unsigned int am_jobq_job_num_get (am_jobq_queue_t *p_jobq_queue)
+{
+    return p_jobq_queue->job_num;
 }
 
 /* end of file */
@@ -16,10 +16,26 @@
  *
  * \internal
  * \par modification history:
+ * - 1.06 26-10-17  tag through *_tagged() so wrappers record their caller
+ * - 1.05 26-10-17  keep the minimum block size pointer-aligned
+ * - 1.04 26-10-17  use leveled log macros
+ * - 1.03 26-10-17  add statistics, integrity check and caller tags
+ * - 1.02 26-10-17  add am_memheap_alloc_align()
+ * - 1.01 26-10-17  add TLSF backend
  * - 1.00 16-10-27  tee, copy from amorks
  * \endinternal
  */
 
+/**
+ * \brief ѹʱ־Ĭϲ䡢ͷŹеĵ־
+ */
+#ifndef AM_MEMHEAP_LOG_LEVEL
+#define AM_MEMHEAP_LOG_LEVEL    AM_LOG_LEVEL_WARN
+#endif
+
+#define AM_LOG_MODULE           AM_LOG_MOD_MEMHEAP
+#define AM_LOG_MODULE_LEVEL     AM_MEMHEAP_LOG_LEVEL
+
 #include "ametal.h"
 #include "am_memheap.h"
 #include "am_assert.h"
@@ -35,7 +51,7 @@
 
 #define __MEMHEAP_IS_USED(i)   ((i)->magic & __MEMHEAP_USED)
 
-#define __MEMHEAP_MINALLOC      12
+#define __MEMHEAP_MINALLOC      AM_ROUND_UP(12, __MEM_ALIGN_SIZE)
 
 #define __MEM_ALIGN_SIZE        (sizeof(void *))
 #define __MEMHEAP_SIZE          AM_ROUND_UP(sizeof(struct am_memheap_item), __MEM_ALIGN_SIZE)
@@ -43,7 +59,414 @@
 
 
 void am_memheap_free(void *ptr);
+static void *__memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize);
+
+#if (AM_MEMHEAP_TAG_ENABLE == 1)
+
+#define __MEMHEAP_TAGGED(ptr, tag)  __memheap_tagged((ptr), (tag))
+
+/* set the tag of an allocated block */
+static void *__memheap_tagged (void *ptr, uint32_t tag)
+{
+    if (ptr != NULL) {
+        am_memheap_tag_set(ptr, tag);
+    }
+    return ptr;
+}
+
+#else
+
+#define __MEMHEAP_TAGGED(ptr, tag)  ((void)(tag), (ptr))
+
+#endif /* (AM_MEMHEAP_TAG_ENABLE == 1) */
+
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+
+/*
+ * TLSF (Two-Level Segregated Fit)
+ *
+ * The block layout and the physical block list are the same as first-fit,
+ * only the free list is replaced by segregated free lists. A free block of
+ * size s is placed in list [fl][sl]:
+ *
+ *   s <  __TLSF_SMALL : fl = 0, sl = s / __MEM_ALIGN_SIZE
+ *   s >= __TLSF_SMALL : fl = fls(s) - __TLSF_FL_SHIFT + 1,
+ *                       sl = the next __TLSF_SL_BITS bits after the MSB
+ *
+ * fl_bitmap marks the non-empty first level classes, sl_bitmap[fl] marks the
+ * non-empty lists of each class, so a suitable list is found with two bit
+ * scans instead of a list walk.
+ */
+
+#define __TLSF_SL_BITS      AM_MEMHEAP_TLSF_SL_BITS
+#define __TLSF_SL_NUM       (1u << __TLSF_SL_BITS)
+#define __TLSF_SMALL        (__TLSF_SL_NUM * __MEM_ALIGN_SIZE)
+#define __TLSF_FL_SHIFT     (__TLSF_SL_BITS + ((sizeof(void *) == 8) ? 3 : 2))
+
+/**
+ * \brief TLSF control block, placed at the beginning of the heap memory
+ */
+struct am_memheap_tlsf {
+    uint32_t                 fl_bitmap;     /**< non-empty first level classes */
+    uint32_t                 fl_num;        /**< number of first level classes */
+    uint32_t                *sl_bitmap;     /**< [fl_num] non-empty lists      */
+    struct am_memheap_item **heads;         /**< [fl_num][__TLSF_SL_NUM]       */
+};
+
+/* index of the most significant set bit, x must not be 0 */
+static int __tlsf_fls (uint32_t x)
+{
+    int bit = 0;
+
+    if (x & 0xffff0000) {
+        x >>= 16;
+        bit += 16;
+    }
+    if (x & 0xff00) {
+        x >>= 8;
+        bit += 8;
+    }
+    if (x & 0xf0) {
+        x >>= 4;
+        bit += 4;
+    }
+    if (x & 0xc) {
+        x >>= 2;
+        bit += 2;
+    }
+    if (x & 0x2) {
+        bit += 1;
+    }
+
+    return bit;
+}
+
+/* index of the least significant set bit, x must not be 0 */
+static int __tlsf_ffs (uint32_t x)
+{
+    return __tlsf_fls(x & (~x + 1));
+}
+
+/* get the list which a free block of this size belongs to */
+static void __tlsf_mapping (uint32_t size, uint32_t *p_fl, uint32_t *p_sl)
+{
+    int t;
+
+    if (size < __TLSF_SMALL) {
+        *p_fl = 0;
+        *p_sl = size / __MEM_ALIGN_SIZE;
+    } else {
+        t     = __tlsf_fls(size);
+        *p_fl = t - __TLSF_FL_SHIFT + 1;
+        *p_sl = (size >> (t - __TLSF_SL_BITS)) ^ __TLSF_SL_NUM;
+    }
+}
+
+/* insert a free block to its list */
+static void __tlsf_insert (struct am_memheap_tlsf *tlsf,
+                           struct am_memheap_item *item)
+{
+    struct am_memheap_item **head;
+    uint32_t                 fl, sl;
+
+    __tlsf_mapping(__MEMITEM_SIZE(item), &fl, &sl);
+
+    head = &tlsf->heads[fl * __TLSF_SL_NUM + sl];
+
+    item->prev_free = NULL;
+    item->next_free = *head;
+    if (*head != NULL) {
+        (*head)->prev_free = item;
+    }
+    *head = item;
+
+    tlsf->fl_bitmap     |= 1u << fl;
+    tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+/* remove a free block from its list */
+static void __tlsf_remove (struct am_memheap_tlsf *tlsf,
+                           struct am_memheap_item *item)
+{
+    struct am_memheap_item **head;
+    uint32_t                 fl, sl;
+
+    __tlsf_mapping(__MEMITEM_SIZE(item), &fl, &sl);
+
+    head = &tlsf->heads[fl * __TLSF_SL_NUM + sl];
+
+    if (item->prev_free != NULL) {
+        item->prev_free->next_free = item->next_free;
+    } else {
+        *head = item->next_free;
+    }
+    if (item->next_free != NULL) {
+        item->next_free->prev_free = item->prev_free;
+    }
+    item->next_free = NULL;
+    item->prev_free = NULL;
+
+    if (*head == NULL) {
+        tlsf->sl_bitmap[fl] &= ~(1u << sl);
+        if (tlsf->sl_bitmap[fl] == 0) {
+            tlsf->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+/*
+ * split the tail of a block as a new free block if the remaining space is
+ * large enough, return the new block or NULL
+ */
+static struct am_memheap_item *__tlsf_split (struct am_memheap      *heap,
+                                             struct am_memheap_item *item,
+                                             uint32_t                size)
+{
+    struct am_memheap_item *new_ptr;
+
+    if (__MEMITEM_SIZE(item) < size + __MEMHEAP_SIZE + __MEMHEAP_MINALLOC) {
+        return NULL;
+    }
+
+    new_ptr = (struct am_memheap_item *)
+              (((uint8_t *)item) + size + __MEMHEAP_SIZE);
+
+    new_ptr->magic    = __MEMHEAP_MAGIC;
+    new_ptr->pool_ptr = heap;
+
+    new_ptr->prev    = item;
+    new_ptr->next    = item->next;
+    item->next->prev = new_ptr;
+    item->next       = new_ptr;
+
+    return new_ptr;
+}
+
+/* merge the next neighbor (a free block) into a block */
+static void __tlsf_merge_next (struct am_memheap      *heap,
+                               struct am_memheap_item *item)
+{
+    struct am_memheap_item *next_ptr = item->next;
+
+    __tlsf_remove(heap->tlsf, next_ptr);
+
+    next_ptr->next->prev = item;
+    item->next           = next_ptr->next;
+}
+
+/* update the maximum allocated size */
+static void __tlsf_used_update (struct am_memheap *heap)
+{
+    if (heap->pool_size - heap->available_size > heap->max_used_size) {
+        heap->max_used_size = heap->pool_size - heap->available_size;
+    }
+}
+
+/******************************************************************************/
+static void *__tlsf_alloc (struct am_memheap *heap, uint32_t size)
+{
+    struct am_memheap_tlsf *tlsf = heap->tlsf;
+    struct am_memheap_item *header_ptr;
+    struct am_memheap_item *new_ptr;
+    uint32_t                search = size;
+    uint32_t                fl, sl;
+    uint32_t                map;
+
+    /*
+     * round up to the next list, so that any block in the list found is
+     * large enough
+     */
+    if (search >= __TLSF_SMALL) {
+        search += (1u << (__tlsf_fls(search) - __TLSF_SL_BITS)) - 1;
+    }
+    __tlsf_mapping(search, &fl, &sl);
+
+    if (fl >= tlsf->fl_num) {
+        return NULL;
+    }
+
+    map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (map == 0) {
+
+        /* no block in this class, use the smallest larger class */
+        map = tlsf->fl_bitmap & (~0u << (fl + 1));
+        if (map == 0) {
+            AM_LOGW("memheap: allocate memory failed\n");
+            return NULL;
+        }
+        fl  = __tlsf_ffs(map);
+        map = tlsf->sl_bitmap[fl];
+    }
+    sl = __tlsf_ffs(map);
+
+    header_ptr = tlsf->heads[fl * __TLSF_SL_NUM + sl];
+    __tlsf_remove(tlsf, header_ptr);
+
+    new_ptr = __tlsf_split(heap, header_ptr, size);
+    if (new_ptr != NULL) {
+        __tlsf_insert(tlsf, new_ptr);
+        heap->available_size -= __MEMITEM_SIZE(header_ptr) + __MEMHEAP_SIZE;
+    } else {
+        heap->available_size -= __MEMITEM_SIZE(header_ptr);
+    }
+    __tlsf_used_update(heap);
+
+    header_ptr->magic |= __MEMHEAP_USED;
+
+    return (void *)((uint8_t *)header_ptr + __MEMHEAP_SIZE);
+}
+
+/******************************************************************************/
+static void __tlsf_free (struct am_memheap      *heap,
+                         struct am_memheap_item *header_ptr)
+{
+    header_ptr->magic    &= ~__MEMHEAP_USED;
+    heap->available_size += __MEMITEM_SIZE(header_ptr);
+
+    /* merge with the previous neighbor */
+    if (!__MEMHEAP_IS_USED(header_ptr->prev)) {
+        heap->available_size += __MEMHEAP_SIZE;
+        __tlsf_remove(heap->tlsf, header_ptr->prev);
+
+        (header_ptr->prev)->next = header_ptr->next;
+        (header_ptr->next)->prev = header_ptr->prev;
+
+        header_ptr = header_ptr->prev;
+    }
+
+    /* merge with the next neighbor */
+    if (!__MEMHEAP_IS_USED(header_ptr->next)) {
+        heap->available_size += __MEMHEAP_SIZE;
+        __tlsf_merge_next(heap, header_ptr);
+    }
+
+    __tlsf_insert(heap->tlsf, header_ptr);
+}
+
+/******************************************************************************/
+static void *__tlsf_realloc (struct am_memheap *heap, void *ptr, size_t newsize)
+{
+    struct am_memheap_item *header_ptr;
+    struct am_memheap_item *next_ptr;
+    struct am_memheap_item *new_ptr;
+    uint32_t                oldsize;
+    void                   *new_mem;
+
+    header_ptr = (struct am_memheap_item *)((uint8_t *)ptr - __MEMHEAP_SIZE);
+    oldsize    = __MEMITEM_SIZE(header_ptr);
+
+    if (newsize > oldsize) {
+        next_ptr = header_ptr->next;
+
+        /* expand to the next free block */
+        if (!__MEMHEAP_IS_USED(next_ptr) &&
+            (oldsize + __MEMHEAP_SIZE + __MEMITEM_SIZE(next_ptr) >= newsize)) {
+
+            heap->available_size -= __MEMITEM_SIZE(next_ptr);
+            __tlsf_merge_next(heap, header_ptr);
+
+            new_ptr = __tlsf_split(heap, header_ptr, newsize);
+            if (new_ptr != NULL) {
+                heap->available_size += __MEMITEM_SIZE(new_ptr);
+                __tlsf_insert(heap->tlsf, new_ptr);
+            }
+            __tlsf_used_update(heap);
+
+            return ptr;
+        }
+
+        /* re-allocate a memory block */
+        new_mem = __tlsf_alloc(heap, newsize);
+        if (new_mem != NULL) {
+            memcpy(new_mem, ptr, oldsize);
+            __tlsf_free(heap, header_ptr);
+        }
+
+        return new_mem;
+    }
+
+    /* shrink, return the tail to the heap */
+    new_ptr = __tlsf_split(heap, header_ptr, newsize);
+    if (new_ptr != NULL) {
+        heap->available_size += __MEMITEM_SIZE(new_ptr);
+
+        if (!__MEMHEAP_IS_USED(new_ptr->next)) {
+            heap->available_size += __MEMHEAP_SIZE;
+            __tlsf_merge_next(heap, new_ptr);
+        }
+        __tlsf_insert(heap->tlsf, new_ptr);
+    }
+
+    return ptr;
+}
+
+/******************************************************************************/
+am_err_t am_memheap_tlsf_init(struct am_memheap *memheap,
+                              const char        *name,
+                              void              *start_addr,
+                              uint32_t           size)
+{
+    struct am_memheap_tlsf *tlsf;
+    struct am_memheap_item *item;
+    uint32_t                ctrl_size;
+    uint32_t                fl_num;
+    uint32_t                sl;
+    uint32_t                i;
+
+    am_assert(memheap != NULL);
+
+    size = AM_ROUND_DOWN(size, __MEM_ALIGN_SIZE);
+
+    /* the number of first level classes needed by the whole heap */
+    if (size < __TLSF_SMALL) {
+        return -AM_EINVAL;
+    }
+    __tlsf_mapping(size, &fl_num, &sl);
+    fl_num += 1;
+
+    ctrl_size = AM_ROUND_UP(sizeof(struct am_memheap_tlsf) +
+                            fl_num * sizeof(uint32_t) +
+                            fl_num * __TLSF_SL_NUM * sizeof(void *),
+                            __MEM_ALIGN_SIZE);
+
+    if (size < ctrl_size + 2 * __MEMHEAP_SIZE + __MEMHEAP_MINALLOC) {
+        return -AM_EINVAL;
+    }
+
+    /* build the block list behind the control block */
+    am_memheap_init(memheap,
+                    name,
+                    (uint8_t *)start_addr + ctrl_size,
+                    size - ctrl_size);
+
+    tlsf            = (struct am_memheap_tlsf *)start_addr;
+    tlsf->fl_bitmap = 0;
+    tlsf->fl_num    = fl_num;
+    tlsf->sl_bitmap = (uint32_t *)(tlsf + 1);
+    tlsf->heads     = (struct am_memheap_item **)(tlsf->sl_bitmap + fl_num);
+
+    for (i = 0; i < fl_num; i++) {
+        tlsf->sl_bitmap[i] = 0;
+    }
+    for (i = 0; i < fl_num * __TLSF_SL_NUM; i++) {
+        tlsf->heads[i] = NULL;
+    }
+
+    /* move the whole free block from the first-fit free list */
+    item = memheap->block_list;
+    memheap->free_header.next_free = &memheap->free_header;
+    memheap->free_header.prev_free = &memheap->free_header;
+
+    __tlsf_insert(tlsf, item);
 
+    memheap->tlsf = tlsf;
+
+    return AM_OK;
+}
+
+#endif /* (AM_MEMHEAP_TLSF_ENABLE == 1) */
+
+/******************************************************************************/
 /*
  * The initialized memory pool will be:
  * +-----------------------------------+--------------------------+
@@ -70,6 +493,7 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
     memheap->pool_size      = AM_ROUND_DOWN(size, __MEM_ALIGN_SIZE);
     memheap->available_size = memheap->pool_size - (2 * __MEMHEAP_SIZE);
     memheap->max_used_size  = memheap->pool_size - memheap->available_size;
+    memheap->tlsf           = NULL;
 
     /* initialize the free list header */
     item            = &(memheap->free_header);
@@ -117,14 +541,14 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
     /* not in free list */
     item->next_free = item->prev_free = NULL;
 
-    AM_DBGF(("create memory heap %x (start 0x%08x, size %d)\n",
-              memheap, start_addr, size));
+    AM_LOGD("create memory heap %x (start 0x%08x, size %d)\n",
+             memheap, start_addr, size);
 
     return AM_OK;
 }
 
 /******************************************************************************/
-void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
+static void *__memheap_alloc(struct am_memheap *heap, uint32_t size)
 {
     uint32_t free_size;
     struct am_memheap_item *header_ptr;
@@ -137,7 +561,13 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
         size = __MEMHEAP_MINALLOC;
     }
 
-    AM_DBGF(("allocate %d on heap: 0x%x", size, heap));
+    AM_LOGD("allocate %d on heap: 0x%x", size, heap);
+
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+    if (heap->tlsf != NULL) {
+        return __tlsf_alloc(heap, size);
+    }
+#endif
 
     if (size < heap->available_size) {
 
@@ -169,11 +599,11 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
                 new_ptr = (struct am_memheap_item *)
                           (((uint8_t *)header_ptr) + size + __MEMHEAP_SIZE);
 
-                AM_DBGF(("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
-                          header_ptr,
-                          header_ptr->next,
-                          header_ptr->prev,
-                          new_ptr));
+                AM_LOGD("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
+                         header_ptr,
+                         header_ptr->next,
+                         header_ptr->prev,
+                         new_ptr);
 
                 /* mark the new block as a memory block and freed. */
                 new_ptr->magic = __MEMHEAP_MAGIC;
@@ -198,9 +628,9 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
                 new_ptr->prev_free = heap->free_list;
                 heap->free_list->next_free->prev_free = new_ptr;
                 heap->free_list->next_free            = new_ptr;
-                AM_DBGF(("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
-                         new_ptr->next_free,
-                         new_ptr->prev_free));
+                AM_LOGD("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
+                        new_ptr->next_free,
+                        new_ptr->prev_free);
 
                 /* decrement the available byte count.  */
                 heap->available_size = heap->available_size -
@@ -218,10 +648,10 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
                     heap->max_used_size = heap->pool_size - heap->available_size;
                 }
                 /* remove header_ptr from free list */
-                AM_DBGF(("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
-                         header_ptr,
-                         header_ptr->next_free,
-                         header_ptr->prev_free));
+                AM_LOGD("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
+                        header_ptr,
+                        header_ptr->next_free,
+                        header_ptr->prev_free);
 
                 header_ptr->next_free->prev_free = header_ptr->prev_free;
                 header_ptr->prev_free->next_free = header_ptr->next_free;
@@ -233,21 +663,109 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
             header_ptr->magic    |= __MEMHEAP_USED;
 
             /* Return a memory address to the caller.  */
-            AM_DBGF(("alloc mem: memory[0x%08x], heap[0x%08x], size: %d\n",
-                     (void *)((uint8_t *)header_ptr + __MEMHEAP_SIZE),
-                      header_ptr,
-                      size));
+            AM_LOGD("alloc mem: memory[0x%08x], heap[0x%08x], size: %d\n",
+                    (void *)((uint8_t *)header_ptr + __MEMHEAP_SIZE),
+                     header_ptr,
+                     size);
 
             return (void *)((uint8_t *)header_ptr + __MEMHEAP_SIZE);
         }
     }
 
-    AM_DBGF(("allocate memory: failed\n"));
+    AM_LOGW("memheap: allocate memory failed\n");
 
     /* Return the completion status.  */
     return NULL;
 }
 
+/******************************************************************************/
+/*
+ * Allocate enough space to hold an aligned block, then split the leading gap
+ * as a separate block and give it back, and finally shrink the tail:
+ *
+ * |*|--- gap ---|*|--------- size ---------|------ tail ------|*|
+ *  ^ allocated   ^ new header at align - __MEMHEAP_SIZE
+ *
+ * the gap is either 0 or large enough to be a block, so nothing is wasted
+ * except the new block header. The result is an ordinary block, it can be
+ * released by am_memheap_free().
+ */
+static void *__memheap_alloc_align(struct am_memheap *heap,
+                                   uint32_t           size,
+                                   uint32_t           align)
+{
+    struct am_memheap_item *header_ptr;
+    struct am_memheap_item *new_ptr;
+    uint8_t                *ptr;
+    uint8_t                *align_ptr;
+
+    am_assert(heap != NULL);
+
+    /* align must be a power of 2 */
+    if ((align & (align - 1)) != 0) {
+        return NULL;
+    }
+
+    if (align <= __MEM_ALIGN_SIZE) {
+        return __memheap_alloc(heap, size);
+    }
+
+    size = AM_ROUND_UP(size, __MEM_ALIGN_SIZE);
+    if (size < __MEMHEAP_MINALLOC) {
+        size = __MEMHEAP_MINALLOC;
+    }
+
+    /* the worst case gap is __MEMHEAP_SIZE + __MEMHEAP_MINALLOC + align - 4 */
+    ptr = (uint8_t *)__memheap_alloc(heap,
+                                     size +
+                                     __MEMHEAP_SIZE +
+                                     __MEMHEAP_MINALLOC +
+                                     align -
+                                     __MEM_ALIGN_SIZE);
+    if (ptr == NULL) {
+        return NULL;
+    }
+
+    align_ptr = (uint8_t *)AM_ROUND_UP((uint32_t)ptr, align);
+
+    if (align_ptr != ptr) {
+
+        /* the gap must be able to hold a block */
+        if ((uint32_t)(align_ptr - ptr) < __MEMHEAP_SIZE + __MEMHEAP_MINALLOC) {
+            align_ptr = (uint8_t *)AM_ROUND_UP((uint32_t)ptr +
+                                               __MEMHEAP_SIZE +
+                                               __MEMHEAP_MINALLOC,
+                                               align);
+        }
+
+        header_ptr = (struct am_memheap_item *)(ptr - __MEMHEAP_SIZE);
+        new_ptr    = (struct am_memheap_item *)(align_ptr - __MEMHEAP_SIZE);
+
+        AM_LOGD("align split: block[0x%08x] to new[0x%08x]\n",
+                header_ptr,
+                new_ptr);
+
+        /* the new block is a used memory block */
+        new_ptr->magic    = __MEMHEAP_MAGIC | __MEMHEAP_USED;
+        new_ptr->pool_ptr = heap;
+
+        new_ptr->prev          = header_ptr;
+        new_ptr->next          = header_ptr->next;
+        header_ptr->next->prev = new_ptr;
+        header_ptr->next       = new_ptr;
+
+        new_ptr->next_free = NULL;
+        new_ptr->prev_free = NULL;
+
+        /* give back the gap, it may be merged with the previous neighbor */
+        am_memheap_free(ptr);
+    }
+
+    /* give back the tail */
+    return __memheap_realloc(heap, align_ptr, size);
+}
+
+/******************************************************************************/
 size_t am_memheap_memsize(struct am_memheap *heap, void *ptr)
 {
     struct am_memheap_item *header_ptr;
@@ -260,7 +778,7 @@ size_t am_memheap_memsize(struct am_memheap *heap, void *ptr)
 }
 
 /******************************************************************************/
-void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
+static void *__memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
 {
     size_t oldsize;
     struct am_memheap_item *header_ptr;
@@ -278,8 +796,14 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
     }
 
     if (ptr == NULL) {
-        return am_memheap_alloc(heap, newsize);
+        return __memheap_alloc(heap, newsize);
+    }
+
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+    if (heap->tlsf != NULL) {
+        return __tlsf_realloc(heap, ptr, newsize);
     }
+#endif
 
     /* get memory block header and get the size of memory block */
     header_ptr = (struct am_memheap_item *)
@@ -321,10 +845,10 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
                 }
 
                 /* remove next_ptr from free list */
-                AM_DBGF(("remove block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x",
-                         next_ptr,
-                         next_ptr->next_free,
-                         next_ptr->prev_free));
+                AM_LOGD("remove block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x",
+                        next_ptr,
+                        next_ptr->next_free,
+                        next_ptr->prev_free);
 
                 next_ptr->next_free->prev_free = next_ptr->prev_free;
                 next_ptr->prev_free->next_free = next_ptr->next_free;
@@ -334,10 +858,10 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
                 /* build a new one on the right place */
                 next_ptr = (struct am_memheap_item*)((char*)ptr + newsize);
 
-                AM_DBGF(("new free block: block[0x%08x] nextm[0x%08x] prevm[0x%08x]",
-                         next_ptr,
-                         next_ptr->next,
-                         next_ptr->prev));
+                AM_LOGD("new free block: block[0x%08x] nextm[0x%08x] prevm[0x%08x]",
+                        next_ptr,
+                        next_ptr->next,
+                        next_ptr->prev);
 
                 /* mark the new block as a memory block and freed. */
                 next_ptr->magic = __MEMHEAP_MAGIC;
@@ -355,16 +879,16 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
                 next_ptr->prev_free = heap->free_list;
                 heap->free_list->next_free->prev_free = next_ptr;
                 heap->free_list->next_free            = next_ptr;
-                AM_DBGF(("new ptr: next_free 0x%08x, prev_free 0x%08x",
-                         next_ptr->next_free,
-                         next_ptr->prev_free));
+                AM_LOGD("new ptr: next_free 0x%08x, prev_free 0x%08x",
+                        next_ptr->next_free,
+                        next_ptr->prev_free);
 
                 return ptr;
             }
         }
 
         /* re-allocate a memory block */
-        new_ptr = (void*)am_memheap_alloc(heap, newsize);
+        new_ptr = (void*)__memheap_alloc(heap, newsize);
         if (new_ptr != NULL) {
             memcpy(new_ptr, ptr, oldsize < newsize ? oldsize : newsize);
             am_memheap_free(ptr);
@@ -382,11 +906,11 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
     new_ptr = (struct am_memheap_item *)
               (((uint8_t *)header_ptr) + newsize + __MEMHEAP_SIZE);
 
-    AM_DBGF(("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
-             header_ptr,
-             header_ptr->next,
-             header_ptr->prev,
-             new_ptr));
+    AM_LOGD("split: block[0x%08x] nextm[0x%08x] prevm[0x%08x] to new[0x%08x]\n",
+            header_ptr,
+            header_ptr->next,
+            header_ptr->prev,
+            new_ptr);
 
     /* mark the new block as a memory block and freed. */
     new_ptr->magic = __MEMHEAP_MAGIC;
@@ -407,8 +931,8 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
         free_ptr = new_ptr->next;
         heap->available_size = heap->available_size - __MEMITEM_SIZE(free_ptr);
 
-        AM_DBGF(("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
-                 header_ptr, header_ptr->next_free, header_ptr->prev_free));
+        AM_LOGD("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
+                header_ptr, header_ptr->next_free, header_ptr->prev_free);
 
         free_ptr->next->prev = new_ptr;
         new_ptr->next   = free_ptr->next;
@@ -423,9 +947,9 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
     new_ptr->prev_free = heap->free_list;
     heap->free_list->next_free->prev_free = new_ptr;
     heap->free_list->next_free            = new_ptr;
-    AM_DBGF(("new free ptr: next_free 0x%08x, prev_free 0x%08x\n",
-             new_ptr->next_free,
-             new_ptr->prev_free));
+    AM_LOGD("new free ptr: next_free 0x%08x, prev_free 0x%08x\n",
+            new_ptr->next_free,
+            new_ptr->prev_free);
 
     /* increment the available byte count.  */
     heap->available_size = heap->available_size + __MEMITEM_SIZE(new_ptr);
@@ -450,8 +974,8 @@ void am_memheap_free(void *ptr)
     header_ptr    = (struct am_memheap_item *)
                     ((uint8_t *)ptr - __MEMHEAP_SIZE);
 
-    AM_DBGF(("free memory: memory[0x%08x], block[0x%08x]\n",
-             ptr, header_ptr));
+    AM_LOGD("free memory: memory[0x%08x], block[0x%08x]\n",
+            ptr, header_ptr);
 
     /* check magic */
     am_assert((header_ptr->magic & __MEMHEAP_MASK) == __MEMHEAP_MAGIC);
@@ -459,6 +983,13 @@ void am_memheap_free(void *ptr)
     /* get pool ptr */
     heap = header_ptr->pool_ptr;
 
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+    if (heap->tlsf != NULL) {
+        __tlsf_free(heap, header_ptr);
+        return;
+    }
+#endif
+
     /* Mark the memory as available. */
     header_ptr->magic &= ~__MEMHEAP_USED;
     /* Adjust the available number of bytes. */
@@ -466,7 +997,7 @@ void am_memheap_free(void *ptr)
 
     /* Determine if the block can be merged with the previous neighbor. */
     if (!__MEMHEAP_IS_USED(header_ptr->prev)) {
-        AM_DBGF(("merge: left node 0x%08x\n", header_ptr->prev));
+        AM_LOGD("merge: left node 0x%08x\n", header_ptr->prev);
 
         /* adjust the available number of bytes. */
         heap->available_size = heap->available_size + __MEMHEAP_SIZE;
@@ -489,8 +1020,8 @@ void am_memheap_free(void *ptr)
         /* merge block with next neighbor. */
         new_ptr = header_ptr->next;
 
-        AM_DBGF(("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
-                 new_ptr, new_ptr->next_free, new_ptr->prev_free));
+        AM_LOGD("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
+                new_ptr, new_ptr->next_free, new_ptr->prev_free);
 
         new_ptr->next->prev = header_ptr;
         header_ptr->next    = new_ptr->next;
@@ -507,9 +1038,242 @@ void am_memheap_free(void *ptr)
         heap->free_list->next_free->prev_free = header_ptr;
         heap->free_list->next_free            = header_ptr;
 
-        AM_DBGF(("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
-                 header_ptr->next_free, header_ptr->prev_free));
+        AM_LOGD("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
+                header_ptr->next_free, header_ptr->prev_free);
+    }
+}
+
+/******************************************************************************/
+void *am_memheap_alloc_tagged(struct am_memheap *heap,
+                              uint32_t           size,
+                              uint32_t           tag)
+{
+    return __MEMHEAP_TAGGED(__memheap_alloc(heap, size), tag);
+}
+
+/******************************************************************************/
+void *am_memheap_alloc_align_tagged(struct am_memheap *heap,
+                                    uint32_t           size,
+                                    uint32_t           align,
+                                    uint32_t           tag)
+{
+    return __MEMHEAP_TAGGED(__memheap_alloc_align(heap, size, align), tag);
+}
+
+/******************************************************************************/
+void *am_memheap_realloc_tagged(struct am_memheap *heap,
+                                void              *ptr,
+                                size_t             newsize,
+                                uint32_t           tag)
+{
+    return __MEMHEAP_TAGGED(__memheap_realloc(heap, ptr, newsize), tag);
+}
+
+/******************************************************************************/
+void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
+{
+    return am_memheap_alloc_tagged(heap, size, AM_MEMHEAP_CALLER());
+}
+
+/******************************************************************************/
+void *am_memheap_alloc_align(struct am_memheap *heap,
+                             uint32_t           size,
+                             uint32_t           align)
+{
+    return am_memheap_alloc_align_tagged(heap, size, align, AM_MEMHEAP_CALLER());
+}
+
+/******************************************************************************/
+void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
+{
+    return am_memheap_realloc_tagged(heap, ptr, newsize, AM_MEMHEAP_CALLER());
+}
+
+#if (AM_MEMHEAP_TAG_ENABLE == 1)
+
+/******************************************************************************/
+void am_memheap_tag_set(void *ptr, uint32_t tag)
+{
+    struct am_memheap_item *header_ptr;
+
+    header_ptr = (struct am_memheap_item *)((uint8_t *)ptr - __MEMHEAP_SIZE);
+    am_assert((header_ptr->magic & __MEMHEAP_MASK) == __MEMHEAP_MAGIC);
+
+    header_ptr->tag = tag;
+}
+
+/******************************************************************************/
+uint32_t am_memheap_tag_get(void *ptr)
+{
+    struct am_memheap_item *header_ptr;
+
+    header_ptr = (struct am_memheap_item *)((uint8_t *)ptr - __MEMHEAP_SIZE);
+
+    return header_ptr->tag;
+}
+
+#endif /* (AM_MEMHEAP_TAG_ENABLE == 1) */
+
+/******************************************************************************/
+/*
+ * walk the block list from block_list to the tailer, every block is checked
+ * before it is used:
+ *  - the magic and the pool pointer are right
+ *  - the next block is inside the pool and behind it (or it is the tailer)
+ *  - the next block links back to it
+ */
+static am_err_t __memheap_walk(struct am_memheap    *heap,
+                               am_memheap_walk_cb_t  pfn_cb,
+                               void                 *p_arg)
+{
+    struct am_memheap_item *item = heap->block_list;
+    uint8_t                *end  = (uint8_t *)heap->start_addr + heap->pool_size;
+
+    while (1) {
+        if (((item->magic & __MEMHEAP_MASK) != __MEMHEAP_MAGIC) ||
+            (item->pool_ptr != heap)) {
+            return -AM_EFAULT;
+        }
+
+        /* the tailer links back to the first block */
+        if (item->next == heap->block_list) {
+            return ((uint8_t *)item + __MEMHEAP_SIZE == end) ? AM_OK : -AM_EFAULT;
+        }
+
+        if ((item->next <= item) ||
+            ((uint8_t *)item->next + __MEMHEAP_SIZE > end) ||
+            (item->next->prev != item)) {
+            return -AM_EFAULT;
+        }
+
+        if (pfn_cb(p_arg,
+                   (uint8_t *)item + __MEMHEAP_SIZE,
+                   __MEMITEM_SIZE(item),
+                   (am_bool_t)__MEMHEAP_IS_USED(item),
+#if (AM_MEMHEAP_TAG_ENABLE == 1)
+                   __MEMHEAP_IS_USED(item) ? item->tag : 0) != AM_OK) {
+#else
+                   0) != AM_OK) {
+#endif
+            return AM_OK;
+        }
+
+        item = item->next;
+    }
+}
+
+/* accumulate the statistics of a block */
+static int __memheap_info_cb (void      *p_arg,
+                              void      *ptr,
+                              uint32_t   size,
+                              am_bool_t  used,
+                              uint32_t   tag)
+{
+    am_memheap_info_t *p_info = (am_memheap_info_t *)p_arg;
+
+    (void)ptr;
+    (void)tag;
+
+    if (used) {
+        p_info->used_blocks++;
+    } else {
+        p_info->free_blocks++;
+        if (size > p_info->largest_free) {
+            p_info->largest_free = size;
+        }
     }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_err_t am_memheap_info_get(struct am_memheap *heap, am_memheap_info_t *p_info)
+{
+    am_err_t ret;
+
+    if ((heap == NULL) || (p_info == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    p_info->total_size    = heap->pool_size;
+    p_info->used_size     = heap->pool_size - heap->available_size;
+    p_info->free_size     = heap->available_size;
+    p_info->max_used_size = heap->max_used_size;
+    p_info->largest_free  = 0;
+    p_info->used_blocks   = 0;
+    p_info->free_blocks   = 0;
+    p_info->frag          = 0;
+
+    ret = __memheap_walk(heap, __memheap_info_cb, p_info);
+
+    if (p_info->free_size != 0) {
+        p_info->frag = 100 - p_info->largest_free * 100 / p_info->free_size;
+    }
+
+    return ret;
+}
+
+/* state of the integrity check */
+struct __memheap_check_ctx {
+    uint32_t  free_size;   /* free size found */
+    am_bool_t prev_free;   /* the previous block is free */
+    am_bool_t broken;      /* two free blocks are adjacent */
+};
+
+/* check a block */
+static int __memheap_check_cb (void      *p_arg,
+                               void      *ptr,
+                               uint32_t   size,
+                               am_bool_t  used,
+                               uint32_t   tag)
+{
+    struct __memheap_check_ctx *p_ctx = (struct __memheap_check_ctx *)p_arg;
+
+    (void)ptr;
+    (void)tag;
+
+    if (!used) {
+
+        /* adjacent free blocks should have been merged */
+        if (p_ctx->prev_free) {
+            p_ctx->broken = AM_TRUE;
+            return -AM_EFAULT;
+        }
+        p_ctx->free_size += size;
+    }
+    p_ctx->prev_free = (am_bool_t)!used;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_err_t am_memheap_check(struct am_memheap *heap)
+{
+    struct __memheap_check_ctx ctx = {0, AM_FALSE, AM_FALSE};
+
+    if (heap == NULL) {
+        return -AM_EINVAL;
+    }
+
+    if ((__memheap_walk(heap, __memheap_check_cb, &ctx) != AM_OK) ||
+        (ctx.broken) ||
+        (ctx.free_size != heap->available_size)) {
+        return -AM_EFAULT;
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_err_t am_memheap_foreach(struct am_memheap    *heap,
+                            am_memheap_walk_cb_t  pfn_cb,
+                            void                 *p_arg)
+{
+    if ((heap == NULL) || (pfn_cb == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    return __memheap_walk(heap, pfn_cb, p_arg);
 }
 
 /* end of file */
@@ -0,0 +1,193 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ڴʵ
+ *
+ * ͷŵڴͨ׸ָӳɵδڴ鲻У
+ *  p_next ȡã˾̬ڴʼʹá
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  am_mempool_free() rejects frees of an empty pool.
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_mempool.h"
+#include "am_int.h"
+#include "am_assert.h"
+#include <string.h>
+
+/** \brief ͷڴֵ */
+#define __MEMPOOL_POISON_FREE    0xDD
+
+/** \brief ·ڴֵ */
+#define __MEMPOOL_POISON_ALLOC   0xCD
+
+/******************************************************************************/
+#if (AM_MEMPOOL_POISON_ENABLE == 1)
+
+/* ͷڴݣ׸ָ⣩Ƿ񱻸д */
+static void __mempool_poison_check (am_mempool_t pool, void *p_blk)
+{
+#ifdef AM_DEBUG
+    uint8_t *p = (uint8_t *)p_blk;
+    size_t   i;
+
+    for (i = sizeof(void *); i < pool->blk_size; i++) {
+        am_assert(p[i] == __MEMPOOL_POISON_FREE);
+    }
+#else
+    (void)pool;
+    (void)p_blk;
+#endif
+}
+
+#endif /* (AM_MEMPOOL_POISON_ENABLE == 1) */
+
+/******************************************************************************/
+int am_mempool_init (struct am_mempool *p_pool,
+                     void              *p_buf,
+                     size_t             size,
+                     size_t             blk_size)
+{
+    if ((p_pool == NULL) || (p_buf == NULL) || (blk_size == 0) ||
+        (((uint32_t)p_buf & (sizeof(void *) - 1)) != 0)) {
+        return -AM_EINVAL;
+    }
+
+    blk_size = AM_MEMPOOL_BLK_SIZE(blk_size);
+
+    if (size < blk_size) {
+        return -AM_EINVAL;
+    }
+
+    p_pool->p_free   = NULL;
+    p_pool->p_next   = (char *)p_buf;
+    p_pool->p_start  = (char *)p_buf;
+    p_pool->blk_size = blk_size;
+    p_pool->blk_num  = size / blk_size;
+    p_pool->p_end    = p_pool->p_start + p_pool->blk_num * blk_size;
+    p_pool->used     = 0;
+    p_pool->used_max = 0;
+    p_pool->fail     = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void *am_mempool_alloc (am_mempool_t pool)
+{
+    void      *p_blk;
+    am_bool_t  reused = AM_FALSE;
+    int        key;
+
+    key = am_int_cpu_lock();
+
+    p_blk = pool->p_free;
+
+    if (p_blk != NULL) {
+        pool->p_free = *(void **)p_blk;
+        reused       = AM_TRUE;
+    } else if (pool->p_next < pool->p_end) {
+        p_blk         = pool->p_next;
+        pool->p_next += pool->blk_size;
+    } else {
+        pool->fail++;
+        am_int_cpu_unlock(key);
+        return NULL;
+    }
+
+    pool->used++;
+    if (pool->used > pool->used_max) {
+        pool->used_max = pool->used;
+    }
+
+    am_int_cpu_unlock(key);
+
+#if (AM_MEMPOOL_POISON_ENABLE == 1)
+
+    /* ڴѴȡرжϼɼ */
+    if (reused) {
+        __mempool_poison_check(pool, p_blk);
+    }
+    memset(p_blk, __MEMPOOL_POISON_ALLOC, pool->blk_size);
+#else
+    (void)reused;
+#endif
+
+    return p_blk;
+}
+
+/******************************************************************************/
+int am_mempool_free (am_mempool_t pool, void *p_blk)
+{
+    int key;
+
+    if (((char *)p_blk < pool->p_start) ||
+        ((char *)p_blk >= pool->p_next) ||
+        ((size_t)((char *)p_blk - pool->p_start) % pool->blk_size != 0)) {
+        return -AM_EINVAL;
+    }
+
+#if (AM_MEMPOOL_POISON_ENABLE == 1)
+
+    /* ׸ָظͷʱÿУܸд */
+    memset((char *)p_blk + sizeof(void *),
+           __MEMPOOL_POISON_FREE,
+           pool->blk_size - sizeof(void *));
+#endif
+
+    key = am_int_cpu_lock();
+
+    /* ûѷڴ飬Ȼظͷ */
+    if (pool->used == 0) {
+        am_int_cpu_unlock(key);
+        return -AM_EINVAL;
+    }
+
+    *(void **)p_blk = pool->p_free;
+    pool->p_free    = p_blk;
+    pool->used--;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+uint32_t am_mempool_blk_num_get (am_mempool_t pool)
+{
+    return pool->blk_num;
+}
+
+/******************************************************************************/
+uint32_t am_mempool_used_get (am_mempool_t pool)
+{
+    return pool->used;
+}
+
+/******************************************************************************/
+uint32_t am_mempool_high_water_get (am_mempool_t pool)
+{
+    return pool->used_max;
+}
+
+/******************************************************************************/
+uint32_t am_mempool_fail_get (am_mempool_t pool)
+{
+    return pool->fail;
+}
+
+/* end of file */
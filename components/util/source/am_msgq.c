@@ -0,0 +1,205 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief Ϣʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_msgq.h"
+#include "am_common.h"          /* for min()    */
+#include <string.h>             /* for memcpy() */
+
+/**
+ * \brief ڴ
+ *
+ * ֤ԪݵĶдڸ¶дλ֮ǰɣŵλø֮
+ * Cortex-M Ϊ˳ִУӲָ__memory_changed()  ARMCC 5
+ * __CC_ARM֧֣ARMCC 6armclang __GNUC__ʹࡣ
+ */
+#if defined(__CC_ARM)
+#define __MSGQ_BARRIER()    __memory_changed()
+#elif defined(__GNUC__)
+#define __MSGQ_BARRIER()    __asm volatile ("" : : : "memory")
+#else
+#define __MSGQ_BARRIER()
+#endif
+
+/******************************************************************************/
+
+/* дλü nΧΪ 0 ~ 2 * elem_num - 1 */
+static uint32_t __msgq_pos_add (am_msgq_t mq, uint32_t pos, uint32_t n)
+{
+    pos += n;
+
+    if (pos >= 2 * mq->elem_num) {
+        pos -= 2 * mq->elem_num;
+    }
+
+    return pos;
+}
+
+/******************************************************************************/
+
+/* дλöӦԪ */
+static uint32_t __msgq_slot (am_msgq_t mq, uint32_t pos)
+{
+    return (pos >= mq->elem_num) ? (pos - mq->elem_num) : pos;
+}
+
+/******************************************************************************/
+
+/* Ԫظ */
+static uint32_t __msgq_count (am_msgq_t mq, uint32_t in, uint32_t out)
+{
+    return (in >= out) ? (in - out) : (in + 2 * mq->elem_num - out);
+}
+
+/******************************************************************************/
+int am_msgq_init (struct am_msgq *p_mq,
+                  void           *p_buf,
+                  size_t          elem_size,
+                  size_t          elem_num)
+{
+    if ((p_mq == NULL) || (p_buf == NULL) ||
+        (elem_size == 0) || (elem_num == 0) || (elem_num > 0x3FFFFFFF)) {
+        return -AM_EINVAL;
+    }
+
+    p_mq->p_buf      = (char *)p_buf;
+    p_mq->elem_size  = elem_size;
+    p_mq->elem_num   = elem_num;
+    p_mq->in         = 0;
+    p_mq->out        = 0;
+    p_mq->overflow   = 0;
+    p_mq->high_water = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_msgq_push (am_msgq_t mq, const void *p_elem)
+{
+    uint32_t in    = mq->in;
+    uint32_t count = __msgq_count(mq, in, mq->out);
+
+    if (count >= mq->elem_num) {
+        mq->overflow++;
+        return -AM_ENOSPC;
+    }
+
+    memcpy(mq->p_buf + __msgq_slot(mq, in) * mq->elem_size,
+           p_elem,
+           mq->elem_size);
+
+    /* дɺٸдλãȡܿԪ */
+    __MSGQ_BARRIER();
+
+    mq->in = __msgq_pos_add(mq, in, 1);
+
+    if (count + 1 > mq->high_water) {
+        mq->high_water = count + 1;
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_msgq_pop (am_msgq_t mq, void *p_elem)
+{
+    uint32_t out = mq->out;
+
+    if (out == mq->in) {
+        return -AM_EAGAIN;
+    }
+
+    memcpy(p_elem,
+           mq->p_buf + __msgq_slot(mq, out) * mq->elem_size,
+           mq->elem_size);
+
+    /* ݶȡɺͷſռ䣬д뷽δȡ */
+    __MSGQ_BARRIER();
+
+    mq->out = __msgq_pos_add(mq, out, 1);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+size_t am_msgq_pop_batch (am_msgq_t mq, void *p_elems, size_t max_elem)
+{
+    uint32_t out   = mq->out;
+    uint32_t slot  = __msgq_slot(mq, out);
+    size_t   num;
+    size_t   first;
+
+    num   = min(max_elem, (size_t)__msgq_count(mq, mq->in, out));
+    first = min(num, (size_t)(mq->elem_num - slot));
+
+    memcpy(p_elems, mq->p_buf + slot * mq->elem_size, first * mq->elem_size);
+
+    /* Ƶ洢ռʼȡ */
+    if (num > first) {
+        memcpy((char *)p_elems + first * mq->elem_size,
+               mq->p_buf,
+               (num - first) * mq->elem_size);
+    }
+
+    __MSGQ_BARRIER();
+
+    mq->out = __msgq_pos_add(mq, out, num);
+
+    return num;
+}
+
+/******************************************************************************/
+void am_msgq_flush (am_msgq_t mq)
+{
+    mq->out = mq->in;
+}
+
+/******************************************************************************/
+size_t am_msgq_count (am_msgq_t mq)
+{
+    return __msgq_count(mq, mq->in, mq->out);
+}
+
+/******************************************************************************/
+am_bool_t am_msgq_isempty (am_msgq_t mq)
+{
+    return (am_bool_t)(mq->in == mq->out);
+}
+
+/******************************************************************************/
+am_bool_t am_msgq_isfull (am_msgq_t mq)
+{
+    return (am_bool_t)(__msgq_count(mq, mq->in, mq->out) == mq->elem_num);
+}
+
+/******************************************************************************/
+uint32_t am_msgq_overflow_get (am_msgq_t mq)
+{
+    return mq->overflow;
+}
+
+/******************************************************************************/
+size_t am_msgq_high_water_get (am_msgq_t mq)
+{
+    return mq->high_water;
+}
+
+/* end of file */
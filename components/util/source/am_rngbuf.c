@@ -16,6 +16,8 @@
  *
  * \internal
  * \par modification history
+ * - 1.01 26-10-17  add the zero-copy span API (reserve/commit, peek/release)
+ *                  and the power-of-two index mode
  * - 1.00 15-12-09  tee, add implementation from AWorks
  * \endinternal
  */
@@ -24,13 +26,90 @@
 #include "am_common.h"          /* for min()    */
 #include <string.h>             /* for memcpy() */
 
+#if (AM_RNGBUF_POW2_ENABLE == 1)
+
+/** \brief СΪ 2 ݣʹ */
+#define __RNGBUF_IDX(rb, idx)    ((idx) & ((rb)->size - 1))
+
+#else
+
+/** \brief ƣidx  2 * size - 1 */
+#define __RNGBUF_IDX(rb, idx)    (((idx) >= (rb)->size) ? \
+                                  ((idx) - (rb)->size) : (idx))
+
+#endif /* (AM_RNGBUF_POW2_ENABLE == 1) */
+
+/******************************************************************************/
+
+/* 㻺еֽ */
+static size_t __rngbuf_used (am_rngbuf_t rb, int in, int out)
+{
+    int n = in - out;
+
+#if (AM_RNGBUF_POW2_ENABLE == 1)
+    n &= rb->size - 1;
+#else
+    if (n < 0) {
+        n += rb->size;
+    }
+#endif
+
+    return (n);
+}
+
+/******************************************************************************/
+
+/* 㻺пеֽʼձһֽͿ */
+static size_t __rngbuf_free (am_rngbuf_t rb, int in, int out)
+{
+    int n = out - in - 1;
+
+#if (AM_RNGBUF_POW2_ENABLE == 1)
+    n &= rb->size - 1;
+#else
+    if (n < 0) {
+        n += rb->size;
+    }
+#endif
+
+    return (n);
+}
+
+/******************************************************************************/
+
+/*  start ʼavail Ϊõֽ */
+static size_t __rngbuf_spans (am_rngbuf_t       rb,
+                              int               start,
+                              size_t            avail,
+                              size_t            nbytes,
+                              am_rngbuf_span_t  span[2])
+{
+    size_t first;
+
+    nbytes = min(nbytes, avail);
+    first  = min(nbytes, (size_t)(rb->size - start));
+
+    span[0].p_buf = &rb->buf[start];
+    span[0].len   = first;
+    span[1].p_buf = rb->buf;
+    span[1].len   = nbytes - first;
+
+    return nbytes;
+}
+
 /******************************************************************************/
 int am_rngbuf_init (struct am_rngbuf *p_rb, char *p_buf, size_t size)
 {
     if (size == 0 || p_buf == NULL) {
         return -AM_EINVAL;
     }
-    
+
+#if (AM_RNGBUF_POW2_ENABLE == 1)
+    if ((size & (size - 1)) != 0) {
+        return -AM_EINVAL;
+    }
+#endif
+
     p_rb->in   = 0;
     p_rb->out  = 0;
     p_rb->buf  = p_buf;
@@ -42,20 +121,13 @@ int am_rngbuf_init (struct am_rngbuf *p_rb, char *p_buf, size_t size)
 /******************************************************************************/
 int am_rngbuf_putchar (am_rngbuf_t rb, const char data)
 {
-    int in = rb->in;
+    int in   = rb->in;
+    int next = __RNGBUF_IDX(rb, in + 1);
 
-    if (in != rb->out - 1) {
-        if (in == rb->size - 1) {
-            if (0 != rb->out) {
-                rb->buf[in] = data;
-                rb->in      = 0;
-                return 1;
-            }
-        } else {
-            rb->buf[in] = data;
-            rb->in++;
-            return 1;
-        }
+    if (next != rb->out) {
+        rb->buf[in] = data;
+        rb->in      = next;
+        return 1;
     }
 
     return 0;
@@ -68,7 +140,7 @@ int am_rngbuf_getchar (am_rngbuf_t rb, char *p_data)
 
     if (out != rb->in) {
         *p_data = rb->buf[out];
-        rb->out = ++out >= rb->size ? 0 : out;
+        rb->out = __RNGBUF_IDX(rb, out + 1);
         return 1;
     }
 
@@ -78,96 +150,80 @@ int am_rngbuf_getchar (am_rngbuf_t rb, char *p_data)
 /******************************************************************************/
 size_t am_rngbuf_put (am_rngbuf_t rb, const char *p_buf, size_t nbytes)
 {
-    int out = rb->out;
-    int in;
-    int bytes_put;
-    int bytes_tmp;
-
-    if (out > rb->in) {
-        /* out is ahead of in.  We can fill up to two bytes before out */
-
-        bytes_put = min(nbytes, out - rb->in - 1);
-        memcpy(&rb->buf[rb->in], p_buf, bytes_put);
-        rb->in += bytes_put;
-
-    } else if (out == 0) {
-        /*
-         * out is at the beginning of the buffer.  We can fill till
-         * the next-to-last element
-         */
-
-        bytes_put = min(nbytes, rb->size - rb->in - 1);
-        memcpy(&rb->buf[rb->in], p_buf, bytes_put);
-        rb->in += bytes_put;
-
-    } else {
-        /*
-         * out has wrapped around, and its not 0, so we can fill
-         * at least to the size of the ring buffer.  Do so, then see if
-         * we need to wrap and put more at the beginning of the buffer.
-         */
-
-        bytes_put = min(nbytes, rb->size - rb->in);
-        memcpy(&rb->buf[rb->in], p_buf, bytes_put);
-        in = rb->in + bytes_put;
-
-        if (in == rb->size) {
-            /* We need to wrap, and perhaps put some more chars */
-
-            bytes_tmp = min(nbytes - bytes_put, out - 1);
-            memcpy(rb->buf, p_buf + bytes_put, bytes_tmp);
-            rb->in = bytes_tmp;
-            bytes_put += bytes_tmp;
-        } else {
-            rb->in = in;
-        }
+    int    in = rb->in;
+    size_t first;
+
+    nbytes = min(nbytes, __rngbuf_free(rb, in, rb->out));
+    first  = min(nbytes, (size_t)(rb->size - in));
+
+    memcpy(&rb->buf[in], p_buf, first);
+
+    /* Ƶʼд */
+    if (nbytes > first) {
+        memcpy(rb->buf, p_buf + first, nbytes - first);
     }
 
-    return (bytes_put);
+    rb->in = __RNGBUF_IDX(rb, in + (int)nbytes);
+
+    return nbytes;
 }
 
 /******************************************************************************/
 size_t am_rngbuf_get (am_rngbuf_t rb, char *p_buf, size_t nbytes)
 {
-    int in = rb->in;
-    int out;
-    int bytes_got;
-    int bytes_tmp;
-
-    if (in >= rb->out) {
-        /* in has not wrapped around */
-
-        bytes_got = min(nbytes, in - rb->out);
-        memcpy(p_buf, &rb->buf[rb->out], bytes_got);
-        rb->out += bytes_got;
-
-    } else {
-        /*
-         * in has wrapped around.  Grab chars up to the size of the
-         * buffer, then wrap around if we need to.
-         */
-
-        bytes_got = min(nbytes, rb->size - rb->out);
-        memcpy(p_buf, &rb->buf[rb->out], bytes_got);
-        out = rb->out + bytes_got;
-
-        /*
-         * If out is equal to size, we've read the entire buffer,
-         * and need to wrap now.  If bytes_got < nbytes, copy some more chars
-         * in now.
-         */
-
-        if (out == rb->size) {
-            bytes_tmp = min(nbytes - bytes_got, in);
-            memcpy(p_buf + bytes_got, rb->buf, bytes_tmp);
-            rb->out = bytes_tmp;
-            bytes_got += bytes_tmp;
-        } else {
-            rb->out = out;
-        }
+    int    out = rb->out;
+    size_t first;
+
+    nbytes = min(nbytes, __rngbuf_used(rb, rb->in, out));
+    first  = min(nbytes, (size_t)(rb->size - out));
+
+    memcpy(p_buf, &rb->buf[out], first);
+
+    /* Ƶʼȡ */
+    if (nbytes > first) {
+        memcpy(p_buf + first, rb->buf, nbytes - first);
     }
 
-    return (bytes_got);
+    rb->out = __RNGBUF_IDX(rb, out + (int)nbytes);
+
+    return nbytes;
+}
+
+/******************************************************************************/
+size_t am_rngbuf_write_reserve (am_rngbuf_t       rb,
+                                size_t            nbytes,
+                                am_rngbuf_span_t  span[2])
+{
+    int in = rb->in;
+
+    return __rngbuf_spans(rb, in, __rngbuf_free(rb, in, rb->out), nbytes, span);
+}
+
+/******************************************************************************/
+void am_rngbuf_write_commit (am_rngbuf_t rb, size_t nbytes)
+{
+    int in = rb->in + nbytes;
+
+    /* дɺٸ inȡܿЩ */
+    rb->in = __RNGBUF_IDX(rb, in);
+}
+
+/******************************************************************************/
+size_t am_rngbuf_read_peek (am_rngbuf_t       rb,
+                            size_t            nbytes,
+                            am_rngbuf_span_t  span[2])
+{
+    int out = rb->out;
+
+    return __rngbuf_spans(rb, out, __rngbuf_used(rb, rb->in, out), nbytes, span);
+}
+
+/******************************************************************************/
+void am_rngbuf_read_release (am_rngbuf_t rb, size_t nbytes)
+{
+    int out = rb->out + nbytes;
+
+    rb->out = __RNGBUF_IDX(rb, out);
 }
 
 /******************************************************************************/
@@ -194,25 +250,13 @@ am_bool_t am_rngbuf_isfull (am_rngbuf_t rb)
 /******************************************************************************/
 size_t am_rngbuf_freebytes (am_rngbuf_t rb)
 {
-    int n = rb->out - rb->in - 1;
-
-    if (n < 0) {
-        n += rb->size;
-    }
-
-    return (n);
+    return __rngbuf_free(rb, rb->in, rb->out);
 }
 
 /******************************************************************************/
 size_t am_rngbuf_nbytes (am_rngbuf_t rb)
 {
-    int n = rb->in - rb->out;
-
-    if (n < 0) {
-        n += rb->size;
-    }
-
-    return (n);
+    return __rngbuf_used(rb, rb->in, rb->out);
 }
 
 /******************************************************************************/
@@ -220,23 +264,13 @@ void am_rngbuf_put_ahead (am_rngbuf_t rb, char byte, size_t offset)
 {
     int n = rb->in + offset;
 
-    if (n >= rb->size) {
-        n -= rb->size;
-    }
-
-    *(rb->buf + n) = byte;
+    *(rb->buf + __RNGBUF_IDX(rb, n)) = byte;
 }
 
 /******************************************************************************/
 void am_rngbuf_move_ahead (am_rngbuf_t rb, size_t n)
 {
-    n += rb->in;
-
-    if (n >= rb->size) {
-        n -= rb->size;
-    }
-
-    rb->in = n;
+    am_rngbuf_write_commit(rb, n);
 }
 
 /* end of file */
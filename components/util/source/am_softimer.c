@@ -16,6 +16,9 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.03 26-10-17  wheel backend: announce() unlocks between ticks.
+ * - 1.02 26-10-17  am_softimer_defer_set() refuses queued jobs.
+ * - 1.01 26-10-17  wheel backend: look ahead past the root level for tickless.
  * - 1.00 15-08-03  tee, first implementation.
  * \endinternal
  */
@@ -27,8 +30,14 @@
 /** \brief ʱӲʱƵʣʱƵʲΪ0 */
 static unsigned int __g_hwtimer_freq = 0;
 
-/** \brief ʱͷ */
-static struct am_list_head g_softimer_head;
+/** \brief ޽ģʽ£ȡӲ߹δƽĽ */
+static unsigned int (*__gpfn_elapsed_get) (void *p_arg) = NULL;
+
+/** \brief ޽ģʽ£ʱ֪ͨ */
+static void (*__gpfn_update) (void *p_arg) = NULL;
+
+/** \brief ޽ģʽصĲ */
+static void *__gp_tickless_arg = NULL;
 
 /******************************************************************************/
 static unsigned int __ms_to_ticks (unsigned int ms)
@@ -39,6 +48,56 @@ static unsigned int __ms_to_ticks (unsigned int ms)
     return 0;
 }
 
+/******************************************************************************/
+
+/* ʱʱ䵽ǰжϣֵΪµжֵ */
+static int __softimer_expire (am_softimer_t *p_timer, int old)
+{
+    /*
+     * жӳҵжϣһεҵδʱ-AM_EBUSY
+     * ϲжӳģδʼʱֱӵûص
+     */
+    if ((p_timer->p_job != NULL) &&
+        (am_isr_defer_job_add(p_timer->p_job) != -AM_EPERM)) {
+        return old;
+    }
+
+    if (p_timer->timeout_callback) {
+        /* ִжʱʱж */
+        am_int_cpu_unlock(old);
+        p_timer->timeout_callback(p_timer->p_arg);
+        old = am_int_cpu_lock();
+    }
+
+    return old;
+}
+
+/******************************************************************************/
+
+/* жӳҵжӳеöʱص */
+static void __softimer_defer_job (void *p_arg)
+{
+    am_softimer_t *p_timer = (am_softimer_t *)p_arg;
+
+    /* ҵӺʱѱֹͣ */
+    if (am_list_empty(&p_timer->node)) {
+        return;
+    }
+
+    if (p_timer->timeout_callback) {
+        p_timer->timeout_callback(p_timer->p_arg);
+    }
+}
+
+#if (AM_SOFTIMER_WHEEL_ENABLE == 0)
+
+/*******************************************************************************
+  ֵʵ
+*******************************************************************************/
+
+/** \brief ʱͷ */
+static struct am_list_head g_softimer_head;
+
 /******************************************************************************/
 static void __softimer_add (am_softimer_t *p_timer, unsigned int ticks)
 {
@@ -80,6 +139,12 @@ static void __softimer_remove (am_softimer_t *p_timer)
     am_list_del_init(&p_timer->node);
 }
 
+/******************************************************************************/
+static void __softimer_module_init (void)
+{
+    AM_INIT_LIST_HEAD(&g_softimer_head);
+}
+
 /* ԳʼָƵʵøú  */
 void am_softimer_module_tick (void)
 {
@@ -115,12 +180,7 @@ void am_softimer_module_tick (void)
                 /* ڻصֹͣȽӽ  */
                 __softimer_add(p_timer, p_timer->repeat_ticks);
 
-                if (p_timer->timeout_callback ) {
-                    /* ִжʱʱж */
-                    am_int_cpu_unlock(old);
-                    p_timer->timeout_callback(p_timer->p_arg);
-                    old = am_int_cpu_lock();
-                }
+                old = __softimer_expire(p_timer, old);
 
                 /* һڵ㣬жһ׽ڵʱǷΪ0 */
                 p       = (&g_softimer_head)->next;
@@ -136,6 +196,331 @@ void am_softimer_module_tick (void)
     am_int_cpu_unlock(old);
 }
 
+/******************************************************************************/
+void am_softimer_module_announce (unsigned int ticks)
+{
+    am_softimer_t *p_timer;
+    unsigned int   skip;
+    int            old;
+
+    while (ticks > 0) {
+
+        old = am_int_cpu_lock();
+
+        if (am_list_empty(&g_softimer_head)) {
+            am_int_cpu_unlock(old);
+            return;
+        }
+
+        /* ׽ڵ㵽ǰĽĲʹκζʱڣһԿ۳ */
+        p_timer = am_list_entry((&g_softimer_head)->next, am_softimer_t, node);
+        skip    = min(ticks, p_timer->ticks);
+        if (skip > 0) {
+            skip--;
+        }
+        p_timer->ticks -= skip;
+        ticks          -= skip;
+
+        am_int_cpu_unlock(old);
+
+        /* ʣµһİʽ */
+        am_softimer_module_tick();
+        ticks--;
+    }
+}
+
+/******************************************************************************/
+unsigned int am_softimer_module_next_ticks_get (void)
+{
+    unsigned int   ticks = AM_SOFTIMER_TICKS_INFINITE;
+    am_softimer_t *p_timer;
+    int            old;
+
+    old = am_int_cpu_lock();
+
+    if (!am_list_empty(&g_softimer_head)) {
+        p_timer = am_list_entry((&g_softimer_head)->next, am_softimer_t, node);
+        ticks   = p_timer->ticks > 0 ? p_timer->ticks : 1;
+    }
+
+    am_int_cpu_unlock(old);
+
+    return ticks;
+}
+
+#else
+
+/*******************************************************************************
+  ֲʱʵ
+*******************************************************************************/
+
+#if ((AM_SOFTIMER_WHEEL_ROOT_BITS + \
+      AM_SOFTIMER_WHEEL_LVL_BITS * AM_SOFTIMER_WHEEL_LVL_NUM) >= 32)
+#error "the softimer wheel must cover less than 2^32 ticks"
+#endif
+
+/** \brief λ */
+#define __WHEEL_ROOT_SIZE      (1ul << AM_SOFTIMER_WHEEL_ROOT_BITS)
+#define __WHEEL_ROOT_MASK      (__WHEEL_ROOT_SIZE - 1)
+
+/** \brief ϲÿλ */
+#define __WHEEL_LVL_SIZE       (1ul << AM_SOFTIMER_WHEEL_LVL_BITS)
+#define __WHEEL_LVL_MASK       (__WHEEL_LVL_SIZE - 1)
+
+/** \brief  n 㣨 0 ʼ㣩λڵʱеʼλ */
+#define __WHEEL_LVL_SHIFT(n)   (AM_SOFTIMER_WHEEL_ROOT_BITS + \
+                                (n) * AM_SOFTIMER_WHEEL_LVL_BITS)
+
+/** \brief ʱֱֿӸǵ tick  */
+#define __WHEEL_MAX_TICKS      ((1ul << __WHEEL_LVL_SHIFT(AM_SOFTIMER_WHEEL_LVL_NUM)) - 1)
+
+/** \brief һ tick */
+static unsigned int        __g_wheel_jiffies;
+
+/** \brief ʱеĶʱ */
+static unsigned int        __g_wheel_count;
+
+/** \brief λڶʱڱȦڵ */
+static struct am_list_head __g_wheel_root[__WHEEL_ROOT_SIZE];
+
+/** \brief ϲλתһȦʱӦλĶʱ */
+static struct am_list_head __g_wheel_lvl[AM_SOFTIMER_WHEEL_LVL_NUM][__WHEEL_LVL_SIZE];
+
+/******************************************************************************/
+static void __wheel_insert (am_softimer_t *p_timer)
+{
+    unsigned int         expires = p_timer->ticks;
+    unsigned int         idx     = expires - __g_wheel_jiffies;
+    struct am_list_head *p_slot;
+    int                  i;
+
+    if (idx < __WHEEL_ROOT_SIZE) {
+        p_slot = &__g_wheel_root[expires & __WHEEL_ROOT_MASK];
+    } else {
+
+        /* ǷΧݷ߲󵽴Ĳλʱ¼ */
+        if (idx > __WHEEL_MAX_TICKS) {
+            idx     = __WHEEL_MAX_TICKS;
+            expires = __g_wheel_jiffies + idx;
+        }
+
+        for (i = 0; i < AM_SOFTIMER_WHEEL_LVL_NUM - 1; i++) {
+            if (idx < (1ul << __WHEEL_LVL_SHIFT(i + 1))) {
+                break;
+            }
+        }
+
+        p_slot = &__g_wheel_lvl[i][(expires >> __WHEEL_LVL_SHIFT(i)) &
+                                   __WHEEL_LVL_MASK];
+    }
+
+    am_list_add_tail(&p_timer->node, p_slot);
+}
+
+/******************************************************************************/
+
+/*  lvl  index λеĶʱ²루͵Ĳ㣩 index */
+static unsigned int __wheel_cascade (int lvl, unsigned int index)
+{
+    struct am_list_head  list;
+    am_softimer_t       *p_timer;
+
+    AM_INIT_LIST_HEAD(&list);
+    am_list_splice_init(&__g_wheel_lvl[lvl][index], &list);
+
+    while (!am_list_empty(&list)) {
+        p_timer = am_list_entry(list.next, am_softimer_t, node);
+        am_list_del_init(&p_timer->node);
+        __wheel_insert(p_timer);
+    }
+
+    return index;
+}
+
+/******************************************************************************/
+static void __softimer_add (am_softimer_t *p_timer, unsigned int ticks)
+{
+    /*  ticks ε am_softimer_module_tick() ʱ */
+    p_timer->ticks = __g_wheel_jiffies + ticks - 1;
+
+    __wheel_insert(p_timer);
+    __g_wheel_count++;
+}
+
+/******************************************************************************/
+static void __softimer_remove (am_softimer_t *p_timer)
+{
+    if (am_list_empty(&p_timer->node)) {          /* ڵδ         */
+        return ;
+    }
+
+    am_list_del_init(&p_timer->node);
+    __g_wheel_count--;
+}
+
+/******************************************************************************/
+static void __softimer_module_init (void)
+{
+    int i, j;
+
+    __g_wheel_jiffies = 0;
+    __g_wheel_count   = 0;
+
+    for (i = 0; i < __WHEEL_ROOT_SIZE; i++) {
+        AM_INIT_LIST_HEAD(&__g_wheel_root[i]);
+    }
+
+    for (i = 0; i < AM_SOFTIMER_WHEEL_LVL_NUM; i++) {
+        for (j = 0; j < __WHEEL_LVL_SIZE; j++) {
+            AM_INIT_LIST_HEAD(&__g_wheel_lvl[i][j]);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/* һ tickǰжϣֵΪµжֵ */
+static int __wheel_tick (int old)
+{
+    struct am_list_head  work_list;
+    am_softimer_t       *p_timer;
+    unsigned int         jiffies;
+    unsigned int         index;
+    int                  i;
+
+    jiffies = __g_wheel_jiffies;
+    index   = jiffies & __WHEEL_ROOT_MASK;
+
+    /* תһȦ𼶽ϲӦλĶʱ */
+    if (index == 0) {
+        for (i = 0; i < AM_SOFTIMER_WHEEL_LVL_NUM; i++) {
+            if (__wheel_cascade(i, (jiffies >> __WHEEL_LVL_SHIFT(i)) &
+                                   __WHEEL_LVL_MASK) != 0) {
+                break;
+            }
+        }
+    }
+
+    __g_wheel_jiffies = jiffies + 1;
+
+    /*  tick ڵĶʱƳصֹͣʱӰ */
+    AM_INIT_LIST_HEAD(&work_list);
+    am_list_splice_init(&__g_wheel_root[index], &work_list);
+
+    while (!am_list_empty(&work_list)) {
+
+        p_timer = am_list_entry(work_list.next, am_softimer_t, node);
+        am_list_del_init(&p_timer->node);
+
+        /* ڻصֹͣȽ¼ʱ */
+        p_timer->ticks = jiffies + p_timer->repeat_ticks;
+        __wheel_insert(p_timer);
+
+        old = __softimer_expire(p_timer, old);
+    }
+
+    return old;
+}
+
+/* ԳʼָƵʵøú  */
+void am_softimer_module_tick (void)
+{
+    int old = am_int_cpu_lock();
+
+    old = __wheel_tick(old);
+
+    am_int_cpu_unlock(old);
+}
+
+/******************************************************************************/
+void am_softimer_module_announce (unsigned int ticks)
+{
+    int old;
+
+    while (ticks > 0) {
+
+        old = am_int_cpu_lock();
+
+        /* ûжʱʱвλΪգֱƽ */
+        if (__g_wheel_count == 0) {
+            __g_wheel_jiffies += ticks;
+            am_int_cpu_unlock(old);
+            return;
+        }
+
+        /*
+         * ղλҲҪƵĽֱÿתһȦ
+         * ʣµһİʽжʱ޹
+         */
+        while ((ticks > 1) &&
+               ((__g_wheel_jiffies & __WHEEL_ROOT_MASK) != 0) &&
+               am_list_empty(&__g_wheel_root[__g_wheel_jiffies &
+                                             __WHEEL_ROOT_MASK])) {
+            __g_wheel_jiffies++;
+            ticks--;
+        }
+
+        old = __wheel_tick(old);
+        ticks--;
+
+        am_int_cpu_unlock(old);
+    }
+}
+
+/******************************************************************************/
+unsigned int am_softimer_module_next_ticks_get (void)
+{
+    unsigned int ticks = AM_SOFTIMER_TICKS_INFINITE;
+    unsigned int jiffies;
+    unsigned int step;
+    unsigned int k;
+    int          i;
+    int          old;
+
+    old = am_int_cpu_lock();
+
+    if (__g_wheel_count > 0) {
+
+        /*  k λеĶʱ __g_wheel_jiffies + k  */
+        for (k = 0; k < __WHEEL_ROOT_SIZE; k++) {
+            jiffies = __g_wheel_jiffies + k;
+            if (!am_list_empty(&__g_wheel_root[jiffies & __WHEEL_ROOT_MASK])) {
+                ticks = k + 1;
+                break;
+            }
+        }
+
+        /*
+         *  i Ĳλ 2^__WHEEL_LVL_SHIFT(i) ʱƣڶʱ
+         * ʱ̵ڣֻһȦ
+         */
+        for (i = 0; i < AM_SOFTIMER_WHEEL_LVL_NUM; i++) {
+
+            step    = 1ul << __WHEEL_LVL_SHIFT(i);
+            jiffies = (__g_wheel_jiffies + step - 1) & ~(step - 1);
+
+            for (k = 0; k < __WHEEL_LVL_SIZE; k++, jiffies += step) {
+                if (jiffies - __g_wheel_jiffies + 1 >= ticks) {
+                    break;
+                }
+                if (!am_list_empty(&__g_wheel_lvl[i][(jiffies >>
+                                                      __WHEEL_LVL_SHIFT(i)) &
+                                                     __WHEEL_LVL_MASK])) {
+                    ticks = jiffies - __g_wheel_jiffies + 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    am_int_cpu_unlock(old);
+
+    return ticks;
+}
+
+#endif /* (AM_SOFTIMER_WHEEL_ENABLE == 0) */
+
+/******************************************************************************/
 int am_softimer_module_init (unsigned int clkrate)
 {
     if ((clkrate == 0)) {
@@ -143,10 +528,24 @@ int am_softimer_module_init (unsigned int clkrate)
         return -AM_EINVAL;
     }
 
-    AM_INIT_LIST_HEAD(&g_softimer_head);
+    __softimer_module_init();
     __g_hwtimer_freq = clkrate;
     return 0;
 }
+
+/******************************************************************************/
+void am_softimer_module_tickless_set (unsigned int (*pfn_elapsed_get) (void *),
+                                      void         (*pfn_update) (void *),
+                                      void          *p_arg)
+{
+    int old = am_int_cpu_lock();
+
+    __gpfn_elapsed_get = pfn_elapsed_get;
+    __gpfn_update      = pfn_update;
+    __gp_tickless_arg  = p_arg;
+
+    am_int_cpu_unlock(old);
+}
  
 /******************************************************************************/
 int am_softimer_init (am_softimer_t *p_timer, 
@@ -165,12 +564,43 @@ int am_softimer_init (am_softimer_t *p_timer,
     
     p_timer->timeout_callback = p_func;
     p_timer->p_arg            = p_arg;
+    p_timer->p_job            = NULL;
     
     am_int_cpu_unlock(old);
     
     return AM_OK;
 }
 
+/******************************************************************************/
+int am_softimer_defer_set (am_softimer_t      *p_timer,
+                           am_isr_defer_job_t *p_job,
+                           uint16_t            pri)
+{
+    int old;
+
+    if (p_timer == NULL) {
+        return -AM_EINVAL;
+    }
+
+    old = am_int_cpu_lock();
+
+    /* еҵ³ʼƻУԭҵδʱҲܸ */
+    if (((p_job != NULL) && am_jobq_job_is_queued(p_job)) ||
+        ((p_timer->p_job != NULL) && am_jobq_job_is_queued(p_timer->p_job))) {
+        am_int_cpu_unlock(old);
+        return -AM_EBUSY;
+    }
+
+    if (p_job != NULL) {
+        am_isr_defer_job_init(p_job, __softimer_defer_job, p_timer, pri);
+    }
+    p_timer->p_job = p_job;
+
+    am_int_cpu_unlock(old);
+
+    return AM_OK;
+}
+
 /******************************************************************************/
 void am_softimer_start (am_softimer_t *p_timer, unsigned int ms)
 {
@@ -183,9 +613,19 @@ void am_softimer_start (am_softimer_t *p_timer, unsigned int ms)
     
     p_timer->repeat_ticks = ticks;
     
+    /* ޽ģʽ£ʱʱӵǰʱδƽĽ */
+    if (__gpfn_elapsed_get != NULL) {
+        ticks += __gpfn_elapsed_get(__gp_tickless_arg);
+    }
+
     __softimer_remove(p_timer);
     __softimer_add(p_timer, ticks);
     am_int_cpu_unlock(old);
+
+    /* ֪ͨ޽ģʽǰһλѵʱ */
+    if (__gpfn_update != NULL) {
+        __gpfn_update(__gp_tickless_arg);
+    }
 }
 
 /******************************************************************************/
@@ -0,0 +1,152 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ջʹͳʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  use the startup file symbols with ARMCC 6 (armclang) too
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_stack.h"
+#include "am_softimer.h"
+
+/*******************************************************************************
+  ջķΧ
+*******************************************************************************/
+
+/*
+ * ARMCC 5  ARMCC 6armclang __ARMCC_VERSIONʹͬһļ
+ * armlinkarmclang ͬʱ __GNUC__ж __ARMCC_VERSION
+ */
+#if defined (__ARMCC_VERSION)
+
+/* ļ am_xxx_armcc_startup.s ж */
+extern uint32_t Stack_Mem[];
+extern uint32_t __initial_sp[];
+
+#define __STACK_BASE    (Stack_Mem)
+#define __STACK_TOP     (__initial_sp)
+
+#elif defined (__GNUC__)
+
+/* ӽűж */
+extern uint32_t _sstack[];
+extern uint32_t _estack[];
+
+#define __STACK_BASE    (_sstack)
+#define __STACK_TOP     (_estack)
+
+#else
+#error "am_stack: stack symbols are not defined for this compiler"
+#endif
+
+/*******************************************************************************
+  Local Variables
+*******************************************************************************/
+
+/** \brief Լ */
+static struct __stack_check {
+    am_softimer_t        timer;        /**< \brief 鶨ʱ */
+    size_t               threshold;    /**< \brief ֵֽڣ */
+    size_t               alarmed;      /**< \brief ϴαʱʹ */
+    am_stack_alarm_cb_t  pfn_alarm;    /**< \brief ص */
+    void                *p_arg;        /**< \brief صû */
+    am_bool_t            started;      /**< \brief Ƿѿʼ */
+} __g_stack_check;
+
+/*******************************************************************************
+  Local Functions
+*******************************************************************************/
+
+/* Լ */
+static void __stack_check (void *p_arg)
+{
+    size_t used = am_stack_high_water_get();
+
+    (void)p_arg;
+
+    if ((used >= __g_stack_check.threshold) &&
+        (used > __g_stack_check.alarmed)) {
+        __g_stack_check.alarmed = used;
+        __g_stack_check.pfn_alarm(__g_stack_check.p_arg,
+                                  used,
+                                  am_stack_size_get());
+    }
+}
+
+/*******************************************************************************
+  Public Functions
+*******************************************************************************/
+size_t am_stack_size_get (void)
+{
+    return (size_t)((uint8_t *)__STACK_TOP - (uint8_t *)__STACK_BASE);
+}
+
+/******************************************************************************/
+size_t am_stack_high_water_get (void)
+{
+    const uint32_t *p_word = __STACK_BASE;
+
+    /* ջջϲҵһд */
+    while ((p_word < __STACK_TOP) && (*p_word == AM_STACK_PAINT_PATTERN)) {
+        p_word++;
+    }
+
+    return (size_t)((uint8_t *)__STACK_TOP - (uint8_t *)p_word);
+}
+
+/******************************************************************************/
+int am_stack_check_start (unsigned int         period_ms,
+                          unsigned int         threshold,
+                          am_stack_alarm_cb_t  pfn_alarm,
+                          void                *p_arg)
+{
+    int ret;
+
+    if ((period_ms == 0) || (threshold == 0) || (threshold > 100) ||
+        (pfn_alarm == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    am_stack_check_stop();
+
+    ret = am_softimer_init(&__g_stack_check.timer, __stack_check, NULL);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    __g_stack_check.threshold = am_stack_size_get() * threshold / 100;
+    __g_stack_check.alarmed   = 0;
+    __g_stack_check.pfn_alarm = pfn_alarm;
+    __g_stack_check.p_arg     = p_arg;
+    __g_stack_check.started   = AM_TRUE;
+
+    am_softimer_start(&__g_stack_check.timer, period_ms);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_stack_check_stop (void)
+{
+    if (__g_stack_check.started) {
+        __g_stack_check.started = AM_FALSE;
+        am_softimer_stop(&__g_stack_check.timer);
+    }
+}
+
+/* end of file */
@@ -16,6 +16,10 @@
  *
  * \internal
  * \par Modification history
+ * - 1.04 26-10-17  block policy waits for the TX interrupt in thread mode,
+ *                  am_debug_flush() takes a timeout.
+ * - 1.03 26-10-17  add runtime per-module log mask.
+ * - 1.02 26-10-17  add interrupt-driven buffered output.
  * - 1.01 15-08-05  bob, USART std interface instead register operation.
  * - 1.00 14-12-01  tee, first implementation.
  * \endinternal
@@ -25,6 +29,20 @@
 #include "am_vdebug.h"
 #include "am_uart.h"
 #include "am_koutput.h"
+#include "am_rngbuf.h"
+#include "am_int.h"
+#include "am_delay.h"
+
+/**
+ * \brief Ϣ
+ */
+static struct __dbg_buf {
+    struct am_rngbuf    rb;         /**< \brief ͻ                  */
+    int                 policy;     /**< \brief Ĵʽ          */
+    volatile am_bool_t  tx_busy;    /**< \brief жڷ            */
+    uint32_t            dropped;    /**< \brief ַ              */
+    uint32_t            char_us;    /**< \brief һַʱ䣨us    */
+} __g_dbg_buf;
  
 /**
  * \brief һַ
@@ -59,8 +77,135 @@ static int __dbg_fputs (const char *s, void *fil)
     return (ss - s);
 }
 
+/**
+ * \brief жлȡһ͵ַ
+ */
+static int __dbg_txchar_get (void *p_arg, char *p_outchar)
+{
+    (void)p_arg;
+
+    if (am_rngbuf_getchar(&__g_dbg_buf.rb, p_outchar) == 1) {
+        return AM_OK;
+    }
+
+    /* ѿգжϽر */
+    __g_dbg_buf.tx_busy = AM_FALSE;
+
+    return -AM_EEMPTY;
+}
+
+/**
+ * \brief жϵȴжڳʱжϹر
+ *
+ * ȴַķʱ䡣ѹرжϵԭʹжϲִʱʱ
+ * أɵ߸Ϊѯʽ͡
+ */
+static uint32_t __dbg_buf_wait (uint32_t key)
+{
+    uint32_t us;
+
+    for (us = 0;
+         am_rngbuf_isfull(&__g_dbg_buf.rb) && (us < 2 * __g_dbg_buf.char_us);
+         us++) {
+        am_int_cpu_unlock(key);
+        am_udelay(1);
+        key = am_int_cpu_lock();
+    }
+
+    return key;
+}
+
+/**
+ * \brief һַжϵã*p_key ΪжϢ
+ */
+static void __dbg_buf_putc_locked (const char c, void *fil, uint32_t *p_key)
+{
+    char old;
+
+    if (am_rngbuf_isfull(&__g_dbg_buf.rb)) {
+
+        switch (__g_dbg_buf.policy) {
+
+        case AM_DEBUG_OVERFLOW_BLOCK:
+
+            /* ߳еȴжڳռ䣬ڹжʱѯ */
+            if (0 == am_int_in_isr()) {
+                *p_key = __dbg_buf_wait(*p_key);
+                if (!am_rngbuf_isfull(&__g_dbg_buf.rb)) {
+                    break;
+                }
+            }
+
+            /*
+             * жлȴʱԲѯʽַжڼ
+             * жϲȡݣͻ
+             */
+            (void)am_rngbuf_getchar(&__g_dbg_buf.rb, &old);
+            while (-AM_EAGAIN == am_uart_poll_putchar(fil, old)) {
+            }
+            break;
+
+        case AM_DEBUG_OVERFLOW_DROP_OLDEST:
+            (void)am_rngbuf_getchar(&__g_dbg_buf.rb, &old);
+            __g_dbg_buf.dropped++;
+            break;
+
+        default:
+            __g_dbg_buf.dropped++;
+            return;
+        }
+    }
+
+    (void)am_rngbuf_putchar(&__g_dbg_buf.rb, c);
+}
+
+/**
+ * \brief һַ
+ */
+static int __dbg_buf_fputc (const char c, void *fil)
+{
+    uint32_t key = am_int_cpu_lock();
+
+    /* line feed */
+    if ('\n' == c) {
+        __dbg_buf_putc_locked('\r', fil, &key);
+    }
+    __dbg_buf_putc_locked(c, fil, &key);
+
+    /*
+     * жϿʱ͡жڼжȡ붪ַ
+     * ͬʱ
+     */
+    if (!__g_dbg_buf.tx_busy) {
+        __g_dbg_buf.tx_busy = AM_TRUE;
+        am_uart_tx_startup(fil);
+    }
+
+    am_int_cpu_unlock(key);
+
+    return 1;
+}
+
+/**
+ * \brief һַ
+ */
+static int __dbg_buf_fputs (const char *s, void *fil)
+{
+    const char *ss;
+    char        c;
+
+    for (ss = s; (c = *ss) != '\0'; ss++) {
+        (void)__dbg_buf_fputc(c, fil);
+    }
+
+    return (ss - s);
+}
+
 am_uart_handle_t  g_dbg_handle;
 
+/** \brief ģʱε־Ĭȫ */
+uint8_t g_am_log_mask_off[AM_LOG_MOD_NUM];
+
 /**
  * \brief debugʼ
  */
@@ -76,6 +221,108 @@ void am_debug_init (am_uart_handle_t handle, uint32_t baudrate)
     am_koutput_set ((void *)handle, __dbg_fputc, __dbg_fputs);
 }
 
+/**
+ * \brief debugʼ
+ */
+int am_debug_buffered_init (am_uart_handle_t  handle,
+                            uint32_t          baudrate,
+                            char             *p_buf,
+                            size_t            size,
+                            int               policy)
+{
+    int ret;
+
+    if ((handle == NULL) || (p_buf == NULL) || (baudrate == 0) ||
+        (policy < AM_DEBUG_OVERFLOW_DROP) ||
+        (policy > AM_DEBUG_OVERFLOW_DROP_OLDEST)) {
+        return -AM_EINVAL;
+    }
+
+    ret = am_rngbuf_init(&__g_dbg_buf.rb, p_buf, size);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    __g_dbg_buf.policy  = policy;
+    __g_dbg_buf.tx_busy = AM_FALSE;
+    __g_dbg_buf.dropped = 0;
+    __g_dbg_buf.char_us = 10000000 / baudrate + 1;   /* 10 λֹλ */
+
+    am_debug_init(handle, baudrate);
+
+    am_uart_callback_set(handle,
+                         AM_UART_CALLBACK_TXCHAR_GET,
+                         (void *)__dbg_txchar_get,
+                         NULL);
+
+    ret = am_uart_ioctl(handle, AM_UART_MODE_SET, (void *)AM_UART_MODE_INT);
+    if (ret != AM_OK) {
+        return ret;                  /* ʹòѯʽ */
+    }
+
+    am_koutput_set((void *)handle, __dbg_buf_fputc, __dbg_buf_fputs);
+
+    return AM_OK;
+}
+
+/**
+ * \brief ģʱ־
+ */
+int am_log_mask_set (int module, uint8_t mask)
+{
+    if ((module < 0) || (module >= AM_LOG_MOD_NUM)) {
+        return -AM_EINVAL;
+    }
+
+    g_am_log_mask_off[module] = (uint8_t)~mask;
+
+    return AM_OK;
+}
+
+/**
+ * \brief ȡģʱ־
+ */
+uint8_t am_log_mask_get (int module)
+{
+    if ((module < 0) || (module >= AM_LOG_MOD_NUM)) {
+        return 0;
+    }
+
+    return (uint8_t)~g_am_log_mask_off[module];
+}
+
+/**
+ * \brief ȡַ
+ */
+uint32_t am_debug_dropped_get (void)
+{
+    return __g_dbg_buf.dropped;
+}
+
+/**
+ * \brief ȴеĵϢ
+ */
+int am_debug_flush (uint32_t timeout_ms)
+{
+    uint32_t us = 0;
+
+    while (__g_dbg_buf.tx_busy) {
+        if (us >= 1000) {
+            if (timeout_ms == 1) {
+                return -AM_ETIME;
+            }
+            if (timeout_ms != 0) {
+                timeout_ms--;
+            }
+            us = 0;
+        }
+        am_udelay(10);
+        us += 10;
+    }
+
+    return AM_OK;
+}
+
  
 
 /* end of file */
@@ -14,14 +14,382 @@
  * \file
  * \brief do vprintf jobs
  *
+ * Output is collected in a small chunk buffer and emitted with one f_puts()
+ * call per chunk: runs of literal text are copied as a whole, and converted
+ * fields are formatted straight into the chunk. A '\0' from "%c" would end
+ * the chunk string, so it is emitted with f_putc() instead.
+ *
+ * Decimal conversion divides by the constant 10, which compilers turn into a
+ * multiply by the reciprocal using the high half of a 32x32->64 product.
+ * Cortex-M0 (ARMv6-M) has MULS, but it only returns the low 32 bits, and it
+ * has no divide instruction, so a shift-and-add divide is used there. The
+ * same method is used for 64-bit values on all targets. Hexadecimal and octal
+ * digits use 32-bit shifts once the value fits in 32 bits.
+ *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-17  emit "%c" of '\0' with f_putc(), store integer fields
+ *                  directly into the chunk
+ * - 1.01 26-10-17  chunked output, add flags/precision, hh/h/ll/z, %i/%o/%p
  * - 1.00 15-12-08  tee, first implementation from AWorks
  * \endinternal
  */
 
 #include "am_vdebug.h"
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * \name conversion flags
+ * @{
+ */
+#define __PF_LEFT       0x01    /**< \brief '-' : left justify              */
+#define __PF_ZERO       0x02    /**< \brief '0' : zero padding              */
+#define __PF_PLUS       0x04    /**< \brief '+' : always print the sign     */
+#define __PF_SPACE      0x08    /**< \brief ' ' : space for positive values */
+#define __PF_UPPER      0x10    /**< \brief upper case hexadecimal digits   */
+#define __PF_PREC       0x20    /**< \brief precision is given              */
+#define __PF_NEG        0x40    /**< \brief the value is negative           */
+/** @} */
+
+/** \brief output state */
+struct __pf_out {
+    void   *fil;                                /**< \brief output handle   */
+    int   (*f_putc) (const char  c, void *fil); /**< \brief put a char      */
+    int   (*f_puts) (const char *s, void *fil); /**< \brief put a string    */
+    int     len;                                /**< \brief chars in chunk  */
+    int     res;                                /**< \brief chars output    */
+    int     err;                                /**< \brief output failed   */
+    char    buf[AM_VFPRINTF_CHUNK_SIZE + 1];    /**< \brief chunk buffer    */
+};
+
+/******************************************************************************/
+
+/* emit the chunk buffer */
+static void __pf_flush (struct __pf_out *p_out)
+{
+    int cc;
+
+    if ((p_out->len == 0) || p_out->err) {
+        p_out->len = 0;
+        return;
+    }
+
+    if (p_out->len == 1) {
+        cc = p_out->f_putc(p_out->buf[0], p_out->fil);
+    } else {
+        p_out->buf[p_out->len] = '\0';
+        cc = p_out->f_puts(p_out->buf, p_out->fil);
+    }
+
+    if (cc < 0) {
+        p_out->err = 1;
+    } else {
+        p_out->res += cc;
+    }
+    p_out->len = 0;
+}
+
+/******************************************************************************/
+
+/* emit a char with f_putc(), for '\0' which would end the chunk string */
+static void __pf_putc (struct __pf_out *p_out, char c)
+{
+    int cc;
+
+    __pf_flush(p_out);
+    if (p_out->err) {
+        return;
+    }
+
+    cc = p_out->f_putc(c, p_out->fil);
+    if (cc < 0) {
+        p_out->err = 1;
+    } else {
+        p_out->res += cc;
+    }
+}
+
+/******************************************************************************/
+
+/* copy n chars into the chunk buffer */
+static void __pf_write (struct __pf_out *p_out, const char *s, int n)
+{
+    char *d;
+    int   room;
+
+    while ((n > 0) && !p_out->err) {
+        room = AM_VFPRINTF_CHUNK_SIZE - p_out->len;
+        if (room > n) {
+            room = n;
+        }
+        d           = &p_out->buf[p_out->len];
+        p_out->len += room;
+        n          -= room;
+        while (room-- > 0) {
+            *d++ = *s++;
+        }
+        if (p_out->len == AM_VFPRINTF_CHUNK_SIZE) {
+            __pf_flush(p_out);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/* put n copies of a char into the chunk buffer */
+static void __pf_fill (struct __pf_out *p_out, char c, int n)
+{
+    while ((n-- > 0) && !p_out->err) {
+        p_out->buf[p_out->len++] = c;
+        if (p_out->len == AM_VFPRINTF_CHUNK_SIZE) {
+            __pf_flush(p_out);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/* q = n / 10, *p_rem = n % 10 */
+am_static_inline uint32_t __divu10 (uint32_t n, uint32_t *p_rem)
+{
+    uint32_t q, r;
+
+#if defined(__ARM_ARCH_6M__) || defined(__TARGET_ARCH_6S_M)
+    q  = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q  = q >> 3;
+    r  = n - (((q << 2) + q) << 1);
+    if (r > 9) {
+        q++;
+        r -= 10;
+    }
+#else
+    q = n / 10;
+    r = n - q * 10;
+#endif
+
+    *p_rem = r;
+
+    return q;
+}
+
+/******************************************************************************/
+
+/* q = n / 10, *p_rem = n % 10, without division (64-bit values are rare) */
+static uint64_t __divu10_64 (uint64_t n, uint32_t *p_rem)
+{
+    uint64_t q, r;
+
+    q  = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q += q >> 32;
+    q  = q >> 3;
+    r  = n - (((q << 2) + q) << 1);
+    if (r > 9) {
+        q++;
+        r -= 10;
+    }
+    *p_rem = (uint32_t)r;
+
+    return q;
+}
+
+/******************************************************************************/
+
+/* convert to digits backwards from p_end, return the first digit */
+static char *__pf_utoa (char *p_end, uint64_t val, int base, int flags)
+{
+    const char *digits = (flags & __PF_UPPER) ? "0123456789ABCDEF"
+                                              : "0123456789abcdef";
+    uint32_t    v32;
+    uint32_t    rem;
+    int         shift;
+
+    /* 64-bit steps only while the value does not fit in 32 bits */
+    if (base != 10) {
+        shift = (base == 16) ? 4 : 3;
+        while ((val >> 32) != 0) {
+            *--p_end = digits[(uint32_t)val & (base - 1)];
+            val    >>= shift;
+        }
+        v32 = (uint32_t)val;
+        do {
+            *--p_end = digits[v32 & (base - 1)];
+            v32    >>= shift;
+        } while (v32 != 0);
+        return p_end;
+    }
+
+    while ((val >> 32) != 0) {
+        val      = __divu10_64(val, &rem);
+        *--p_end = (char)('0' + rem);
+    }
+
+    v32 = (uint32_t)val;
+    do {
+        v32      = __divu10(v32, &rem);
+        *--p_end = (char)('0' + rem);
+    } while (v32 != 0);
+
+    return p_end;
+}
+
+/******************************************************************************/
+
+/* emit an integer with sign, precision and width */
+static void __pf_integer (struct __pf_out *p_out,
+                          uint64_t         val,
+                          int              base,
+                          int              flags,
+                          int              width,
+                          int              prec,
+                          const char      *p_prefix)
+{
+    char  s[24];                            /* 22 octal digits at most */
+    char *p = &s[sizeof(s)];
+    int   ndigits;
+    int   nprefix = 0;
+    int   nzero;
+    int   npad;
+    int   total;
+    char  sign = 0;
+
+    if (flags & __PF_NEG) {
+        sign = '-';
+    } else if (flags & __PF_PLUS) {
+        sign = '+';
+    } else if (flags & __PF_SPACE) {
+        sign = ' ';
+    }
+
+    /* "%.0d" prints nothing for 0 */
+    if ((val == 0) && (flags & __PF_PREC) && (prec == 0)) {
+        ndigits = 0;
+    } else {
+        p       = __pf_utoa(p, val, base, flags);
+        ndigits = (int)(&s[sizeof(s)] - p);
+    }
+
+    if (p_prefix != NULL) {
+        nprefix = 2;
+    }
+
+    nzero = (prec > ndigits) ? prec - ndigits : 0;
+    npad  = width - ndigits - nzero - nprefix - (sign ? 1 : 0);
+
+    /* '0' is ignored with '-' or a precision */
+    if ((flags & (__PF_ZERO | __PF_LEFT | __PF_PREC)) == __PF_ZERO) {
+        nzero += (npad > 0) ? npad : 0;
+        npad   = 0;
+    }
+
+    if (npad < 0) {
+        npad = 0;
+    }
+
+    /* the whole field fits in the chunk buffer: store it directly */
+    total = npad + (sign ? 1 : 0) + nprefix + nzero + ndigits;
+    if (total <= AM_VFPRINTF_CHUNK_SIZE - p_out->len) {
+        char *d = &p_out->buf[p_out->len];
+
+        p_out->len += total;
+        if (!(flags & __PF_LEFT)) {
+            for (; npad > 0; npad--) {
+                *d++ = ' ';
+            }
+        }
+        if (sign) {
+            *d++ = sign;
+        }
+        if (p_prefix != NULL) {
+            *d++ = p_prefix[0];
+            *d++ = p_prefix[1];
+        }
+        for (; nzero > 0; nzero--) {
+            *d++ = '0';
+        }
+        for (; ndigits > 0; ndigits--) {
+            *d++ = *p++;
+        }
+        for (; npad > 0; npad--) {
+            *d++ = ' ';
+        }
+        if (p_out->len == AM_VFPRINTF_CHUNK_SIZE) {
+            __pf_flush(p_out);
+        }
+        return;
+    }
+
+    if (!(flags & __PF_LEFT)) {
+        __pf_fill(p_out, ' ', npad);
+    }
+    if (sign) {
+        __pf_fill(p_out, sign, 1);
+    }
+    if (p_prefix != NULL) {
+        __pf_write(p_out, p_prefix, nprefix);
+    }
+    __pf_fill(p_out, '0', nzero);
+    __pf_write(p_out, p, ndigits);
+    if (flags & __PF_LEFT) {
+        __pf_fill(p_out, ' ', npad);
+    }
+}
+
+/******************************************************************************/
+
+/* emit a string with precision and width */
+static void __pf_string (struct __pf_out *p_out,
+                         const char      *s,
+                         int              flags,
+                         int              width,
+                         int              prec)
+{
+    int n = 0;
+
+    if (s == NULL) {
+        s = "(null)";
+    }
+
+    /* the string need not be NUL terminated within the precision */
+    if (flags & __PF_PREC) {
+        while ((n < prec) && (s[n] != '\0')) {
+            n++;
+        }
+    } else {
+        while (s[n] != '\0') {
+            n++;
+        }
+
+        /* long strings are passed to f_puts() without copying */
+        if ((n >= AM_VFPRINTF_CHUNK_SIZE) && (width <= n)) {
+            __pf_flush(p_out);
+            if (!p_out->err) {
+                int cc = p_out->f_puts(s, p_out->fil);
+                if (cc < 0) {
+                    p_out->err = 1;
+                } else {
+                    p_out->res += cc;
+                }
+            }
+            return;
+        }
+    }
+
+    if (!(flags & __PF_LEFT)) {
+        __pf_fill(p_out, ' ', width - n);
+    }
+    __pf_write(p_out, s, n);
+    if (flags & __PF_LEFT) {
+        __pf_fill(p_out, ' ', width - n);
+    }
+}
 
 /**
  * \brief Format a string and output it.
@@ -30,6 +398,9 @@
  * arguments to output the characters.
  * all other vXXXprintf() functions are based on this function.
  *
+ * Supported: flags "-0+ ", width and precision (digits or '*'),
+ * length "hh", "h", "l", "ll", "z", conversions "%d %i %u %o %x %X %c %s %p %%".
+ *
  * \param fil       The handle for f_putc and f_puts functions
  * \param f_putc    Pointer to function to output a char
  * \param f_puts    Pointer to function to output a string
@@ -44,96 +415,212 @@ int am_vfprintf_do (void       *fil,
                     const char *fmt,
                     va_list     args)
 {
-    unsigned char   c, f;
-    int             r;
-    unsigned long   val;
-    char            s[16];
-    int             i, w, res, cc;
+    struct __pf_out  out;
+    const char      *p;
+    unsigned char    c;
+    int              flags, width, prec, lng;
+    int              base;
+    uint64_t         val;
+
+    out.fil    = fil;
+    out.f_putc = f_putc;
+    out.f_puts = f_puts;
+    out.len    = 0;
+    out.res    = 0;
+    out.err    = 0;
 
+    while (!out.err) {
 
-    for (cc = res = 0; cc >= 0; res += cc >= 0 ? cc : 0) {
-        if ((c = *fmt++) == 0) {
+        /* a run of literal text */
+        for (p = fmt; (*p != '\0') && (*p != '%'); p++) {
+        }
+        if (p != fmt) {
+            __pf_write(&out, fmt, (int)(p - fmt));
+            fmt = p;
+        }
+
+        if (*fmt == '\0') {
             break;                      /* End of string */
-        } else if (c != '%') {          /* Non escape cahracter */
-            cc = f_putc(c, fil);
-            continue;
         }
-        w = f = 0;
-        c = *fmt++;
-        if (c == '0') {                 /* Flag: '0' padding */
-            f = 1;
-            c = *fmt++;
+        fmt++;
+
+        /* flags */
+        for (flags = 0; ; fmt++) {
+            if (*fmt == '-') {
+                flags |= __PF_LEFT;
+            } else if (*fmt == '0') {
+                flags |= __PF_ZERO;
+            } else if (*fmt == '+') {
+                flags |= __PF_PLUS;
+            } else if (*fmt == ' ') {
+                flags |= __PF_SPACE;
+            } else {
+                break;
+            }
+        }
+
+        /* width */
+        width = 0;
+        if (*fmt == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= __PF_LEFT;
+                width  = -width;
+            }
+            fmt++;
+        } else {
+            while ((*fmt >= '0') && (*fmt <= '9')) {
+                width = width * 10 + (*fmt++ - '0');
+            }
         }
-        while (c >= '0' && c <= '9') {  /* Precision */
-            w = w * 10 + (c - '0');
-            c = *fmt++;
+
+        /* precision */
+        prec = 0;
+        if (*fmt == '.') {
+            flags |= __PF_PREC;
+            fmt++;
+            if (*fmt == '*') {
+                prec = va_arg(args, int);
+                if (prec < 0) {         /* as if omitted */
+                    flags &= ~__PF_PREC;
+                    prec   = 0;
+                }
+                fmt++;
+            } else {
+                while ((*fmt >= '0') && (*fmt <= '9')) {
+                    prec = prec * 10 + (*fmt++ - '0');
+                }
+            }
         }
-        if (c == 'l') {                 /* Prefix: Size is long int */
-            f |= 2;
-            c  = *fmt++;
+
+        /* length: -2 hh, -1 h, 0 int, 1 l, 2 ll, 3 z */
+        lng = 0;
+        if (*fmt == 'h') {
+            lng = -1;
+            if (*++fmt == 'h') {
+                lng = -2;
+                fmt++;
+            }
+        } else if (*fmt == 'l') {
+            lng = 1;
+            if (*++fmt == 'l') {
+                lng = 2;
+                fmt++;
+            }
+        } else if (*fmt == 'z') {
+            lng = 3;
+            fmt++;
         }
-        if (c == 's') {                 /* Type is string */
-            cc = f_puts(va_arg(args, char *), fil);
+
+        c = (unsigned char)*fmt++;
+
+        switch (c) {
+
+        case 's':                       /* Type is string */
+            __pf_string(&out, va_arg(args, const char *), flags, width, prec);
             continue;
-        }
-        if (c == 'c') {                 /* Type is character */
-            cc = f_putc(va_arg(args, int), fil);
+
+        case 'c':                       /* Type is character */
+            {
+                char ch = (char)va_arg(args, int);
+
+                if (!(flags & __PF_LEFT)) {
+                    __pf_fill(&out, ' ', width - 1);
+                }
+                if (ch != '\0') {
+                    __pf_fill(&out, ch, 1);
+                } else {
+                    __pf_putc(&out, ch);
+                }
+                if (flags & __PF_LEFT) {
+                    __pf_fill(&out, ' ', width - 1);
+                }
+            }
             continue;
-        }
-        if (c == '%') {                 /* Char is '%' */
-            cc = f_putc('%', fil);
+
+        case '%':                       /* Char is '%' */
+            __pf_fill(&out, '%', 1);
             continue;
-        }
-        r = 0;
-        if (c == 'd') {
-            r = 10;             /* Type is signed decimal */
-        } else if (c == 'u') {
-            r = 10;             /* Type is unsigned decimal */
-        } else if (c == 'X') {
-            r = 16;             /* Type is unsigned hexdecimal, upper case */
-        } else if (c == 'x') {
-            r = 0x100 + 16;     /* Type is unsigned hexdecimal, lower case */
-        }else {
-            break;              /* Unknown type */
-        }
-        if (f & 2) {            /* Get the value */
-            val = (unsigned long)va_arg(args, long);
-        } else {
-            val = (c == 'd')
-                ? (unsigned long)(long)va_arg(args, int)
-                : (unsigned long)va_arg(args, unsigned int);
-        }
-        /* Put numeral string */
-        if ((c == 'd') && (val & 0x80000000)) {
-            val = 0 - val;
-            f  |= 4;
-        }
-        i    = sizeof(s) - 1;
-        s[i] = 0;
-        do {
-            c = (unsigned char)(val % (r & 0xff) + '0');
-            if (c > '9') {
-                if (r & 0x100) {
-                    c += 39;
+
+        case 'p':                       /* Type is pointer */
+            val    = (uint64_t)(uintptr_t)va_arg(args, void *);
+            base   = 16;
+            flags &= ~__PF_ZERO;
+            break;
+
+        case 'd':                       /* Type is signed decimal */
+        case 'i':
+            {
+                int64_t sval;
+
+                if (lng == 2) {
+                    sval = va_arg(args, long long);
+                } else if (lng == 1) {
+                    sval = va_arg(args, long);
+                } else if (lng == 3) {
+                    sval = (int64_t)va_arg(args, size_t);
+                } else {
+                    sval = va_arg(args, int);
+                    if (lng == -1) {
+                        sval = (short)sval;
+                    } else if (lng == -2) {
+                        sval = (signed char)sval;
+                    }
+                }
+
+                if (sval < 0) {
+                    flags |= __PF_NEG;
+                    val    = (uint64_t)0 - (uint64_t)sval;
                 } else {
-                    c += 7;
+                    val    = (uint64_t)sval;
                 }
+                base = 10;
             }
-            s[--i] = c;
-            val   /= (r & 0xff);
-        } while (i && val);
-        if (i && (f & 4)) {
-            s[--i] = '-';
+            break;
+
+        case 'u':                       /* Type is unsigned decimal */
+        case 'o':                       /* Type is unsigned octal */
+        case 'x':                       /* Type is unsigned hexdecimal */
+        case 'X':
+            if (lng == 2) {
+                val = va_arg(args, unsigned long long);
+            } else if (lng == 1) {
+                val = va_arg(args, unsigned long);
+            } else if (lng == 3) {
+                val = va_arg(args, size_t);
+            } else {
+                val = va_arg(args, unsigned int);
+                if (lng == -1) {
+                    val = (unsigned short)val;
+                } else if (lng == -2) {
+                    val = (unsigned char)val;
+                }
+            }
+
+            if (c == 'X') {
+                flags |= __PF_UPPER;
+            }
+            flags &= ~(__PF_PLUS | __PF_SPACE);
+            base   = (c == 'o') ? 8 : (c == 'u') ? 10 : 16;
+            break;
+
+        default:
+            base = 0;                   /* Unknown type */
+            break;
         }
-        w = sizeof(s) - 1 - w;
-        while (i && i > w) {
-            s[--i] = (f & 1) ? '0' : ' ';
+
+        if (base == 0) {
+            break;
         }
-        cc = f_puts(&s[i], fil);
+
+        /* the only call, so that it is inlined */
+        __pf_integer(&out, val, base, flags, width, prec,
+                     (c == 'p') ? "0x" : NULL);
     }
 
-    return res;
+    __pf_flush(&out);
+
+    return out.res;
 }
 
 /* end of file */
-
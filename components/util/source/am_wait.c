@@ -16,10 +16,14 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.02 26-10-17  add optional CPU load accounting.
+ * - 1.01 26-10-17  execute the idle function between interrupts while waiting.
  * - 1.00 15-09-01  tee, first implementation.
  * \endinternal
  */
 #include "am_wait.h"
+#include "am_int.h"
+#include "am_cpu_load.h"
 
 
 /******************************************************************************/
@@ -34,6 +38,65 @@
 #define __WAIT_STAT_WAIT_ON          1   /* ȴ״̬            */
 #define __WAIT_STAT_WAIT_ON_TIMEOUT  2   /* ȴ״̬ʱ   */
 
+/* ȴڼִеĿк */
+static am_pfnvoid_t  __g_wait_idle_func = NULL;
+static void         *__g_wait_idle_arg  = NULL;
+
+/******************************************************************************/
+
+/* ȴֵı䣬δıʱִпкжϻ */
+static void __wait_val_poll (am_wait_t *p_wait)
+{
+    int key;
+#if (AM_CPU_LOAD_ENABLE != 0)
+    int load_prev = am_cpu_load_enter(AM_CPU_LOAD_IDLE);
+#endif
+
+    if (__g_wait_idle_func == NULL) {
+        while (p_wait->val == __WAIT_VAL_INIT);
+#if (AM_CPU_LOAD_ENABLE != 0)
+        am_cpu_load_exit(load_prev);
+#endif
+        return;
+    }
+
+    key = am_int_cpu_lock();
+
+    /* жϺټ飬˯ǰжϱ */
+    while (p_wait->val == __WAIT_VAL_INIT) {
+        __g_wait_idle_func(__g_wait_idle_arg);
+
+        /* жϣ CPU ж */
+        am_int_cpu_unlock(key);
+        key = am_int_cpu_lock();
+    }
+
+    am_int_cpu_unlock(key);
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+    am_cpu_load_exit(load_prev);
+#endif
+}
+
+/******************************************************************************/
+void am_wait_idle_set (am_pfnvoid_t pfn_idle, void *p_arg)
+{
+    int key = am_int_cpu_lock();
+
+    __g_wait_idle_func = pfn_idle;
+    __g_wait_idle_arg  = p_arg;
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+void am_wait_idle (void)
+{
+    if (__g_wait_idle_func != NULL) {
+        __g_wait_idle_func(__g_wait_idle_arg);
+    }
+}
+
 /******************************************************************************/
 
 static void __timer_callback (void *p_arg)
@@ -70,7 +133,7 @@ int am_wait_on (am_wait_t *p_wait)
     
     p_wait->stat = __WAIT_STAT_WAIT_ON;
     
-    while(p_wait->val == __WAIT_VAL_INIT);
+    __wait_val_poll(p_wait);
     
     p_wait->val  = __WAIT_VAL_INIT;
     p_wait->stat = __WAIT_STAT_INIT;
@@ -98,7 +161,7 @@ int am_wait_on_timeout(am_wait_t *p_wait, uint32_t timeout_ms)
     
     p_wait->stat = __WAIT_STAT_WAIT_ON_TIMEOUT;
     
-    while(p_wait->val == __WAIT_VAL_INIT);
+    __wait_val_poll(p_wait);
     
     if (p_wait->val == __WAIT_VAL_DONE) {  /* ɹȵź */
         ret = AM_OK;
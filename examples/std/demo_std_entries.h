@@ -197,6 +197,13 @@ void demo_std_key_digitron_entry (int32_t id);
  */
 void demo_std_key_digitron_rngbuf_entry (int32_t id);
 
+/**
+ * \brief 按键例程，使用数码管显示当前按下的按键（按键事件缓存到定长消息队列中）
+ * \param[in] id  数码管编号
+ * \return 无
+ */
+void demo_std_key_digitron_msgq_entry (int32_t id);
+
 /**
  * \brief LED 例程，通过标准接口实现
  * \param[in] led_id LED 编号
@@ -0,0 +1,150 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ̣ʹʵʱʾǰµİ¼浽ϢУ
+ *
+ *  ӦҪʹõλܣָʾٰλܡͬʱ
+ *  ʹõ4 4Ӧİ̶ΪKEY_0KEY_1KEY_2KEY_3
+ *  иʱӦȷϵͳ4ǶӦİΪKEY_0 ~ KEY_4
+ * 
+ *  صͨжϻУˣڰصĴر
+ *  һЩʱϳĴʱԽ¼ΪһԪд붨ϢУ
+ *  main()δֽƴװͽ
+ * 
+ * - 
+ *   1. ں
+ *
+ * - ʵ
+ *   1. һλʾ 0 ~ 4
+ *   2. żʱ˸ʱܲ˸
+ *
+ * \par Դ
+ * \snippet demo_std_key_digitron_msgq.c src_std_key_digitron_msgq
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+/**
+ * \addtogroup demo_if_std_key_digitron_msgq
+ * \copydoc demo_std_key_digitron_msgq.c
+ */
+
+/** [src_std_key_digitron_msgq] */
+#include "ametal.h"
+#include "am_input.h"
+#include "am_delay.h"
+#include "am_vdebug.h"
+#include "am_digitron_disp.h"
+#include "am_msgq.h"
+
+/* ¼ */
+typedef struct __key_event {
+    int key_code;
+    int key_state;
+} __key_event_t;
+
+static __key_event_t  __g_key_buf[32];                 /* ɻ 32 ¼ */
+static struct am_msgq __g_key_msgq;                    /* Ϣʵ    */
+
+static void __digitron_disp_key_code (int id, int code)
+{
+    am_digitron_disp_char_at(id, 0, '0' + code / 10);  /* ʮλ                */
+    am_digitron_disp_char_at(id, 1, '0' + code % 10);  /* λ                */
+ 
+    if ((code & 0x01) == 0) {                          /* żʱ˸    */
+        am_digitron_disp_blink_set(id, 0, AM_TRUE);
+        am_digitron_disp_blink_set(id, 1, AM_TRUE);
+    } else {
+        am_digitron_disp_blink_set(id, 0, AM_FALSE);
+        am_digitron_disp_blink_set(id, 1, AM_FALSE);
+    }
+}
+  
+/* ʵʴ */
+static void __input_key_proc (int id, int key_code, int key_state)
+{
+    switch (key_code) {
+
+    case KEY_0:
+        __digitron_disp_key_code(id, 0);
+        break;
+
+    case KEY_1:
+        __digitron_disp_key_code(id, 1);
+        break;
+
+    case KEY_2:
+        __digitron_disp_key_code(id, 2);
+        break;
+
+    case KEY_3:
+        __digitron_disp_key_code(id, 3);
+        break;
+
+    default :
+        break;
+    }
+}
+
+/* ص */
+static void __input_key_cb (void *p_arg, int key_code, int key_state)
+{
+    __key_event_t event;
+
+    event.key_code  = key_code;
+    event.key_state = key_state;
+
+    if (am_msgq_push(&__g_key_msgq, &event) != AM_OK) {
+
+        /* ¼ */
+        AM_DBG_INFO("Queue full, the key event discard!\r\n");
+    }
+}
+
+/**
+ * \brief 
+ */
+void demo_std_key_digitron_msgq_entry (int32_t id)
+{
+    static am_input_key_handler_t key_handler;
+
+    /* ʼ 8  ASCII  */
+    am_digitron_disp_decode_set(id, am_digitron_seg8_ascii_decode);
+    
+    /* ʼް£ʾ -- */
+    am_digitron_disp_char_at(id, 0, '-');
+    am_digitron_disp_char_at(id, 1, '-');
+
+    am_msgq_init(&__g_key_msgq,
+                 __g_key_buf,
+                 sizeof(__key_event_t),
+                 AM_NELEMENTS(__g_key_buf));
+
+    am_input_key_handler_register(&key_handler, __input_key_cb, NULL);
+
+    AM_FOREVER {
+
+        __key_event_t event;
+
+        if (am_msgq_pop(&__g_key_msgq, &event) == AM_OK) {
+            __input_key_proc(id, event.key_code, event.key_state);
+        }
+    }
+}
+/** [src_std_key_digitron_msgq] */
+
+/* end of file */
@@ -0,0 +1,205 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʱڴarena
+ *
+ * ûṩĴ洢ռ˳䣬ֻƶһָ룬ûпͷܵ
+ * ͷţͨ am_arena_mark() ¼λãɺʹ am_arena_reset_to()
+ * һͷŸλ֮ȫռ䡣Э֡
+ * һδ̵ʱϴջѷ䡣
+ *
+ * 洢ռ䲻ʱԴ am_memheap зڴ䣨
+ * am_arena_fallback_set()ڴڸλʱ黹ѡ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_arena.h"
+ * \endcode
+ *
+ * \par ʾ
+ * \code
+ *  static uint32_t        __g_scratch_mem[64];
+ *  static struct am_arena __g_scratch;
+ *
+ *  am_arena_init(&__g_scratch, __g_scratch_mem, sizeof(__g_scratch_mem));
+ *
+ *  void frame_send (const uint8_t *p_data, size_t len)
+ *  {
+ *      am_arena_mark_t mark  = am_arena_mark(&__g_scratch);
+ *      uint8_t        *p_buf = am_arena_alloc(&__g_scratch, len + 8);
+ *
+ *      if (p_buf != NULL) {
+ *          //  build and send the frame in p_buf
+ *      }
+ *      am_arena_reset_to(&__g_scratch, mark);
+ *  }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_ARENA_H
+#define __AM_ARENA_H
+
+#include "am_common.h"
+#include "am_memheap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_arena
+ * \copydoc am_arena.h
+ * @{
+ */
+
+/** \brief ڴ飨ڲʹã */
+struct am_arena_chunk;
+
+/**
+ * \brief ʱڴṹ
+ */
+struct am_arena {
+    char                  *p_cur;        /**< \brief ǰλ             */
+    char                  *p_end;        /**< \brief ǰڴַ       */
+    char                  *p_start;      /**< \brief 洢ռʼַ         */
+    struct am_arena_chunk *p_chunk;      /**< \brief ĺڴ         */
+    struct am_memheap     *p_heap;       /**< \brief ڴڵĶ       */
+    size_t                 chunk_size;   /**< \brief ڴСС     */
+    size_t                 used_max;     /**< \brief 洢ռʹֵ   */
+    uint32_t               fallback;     /**< \brief ڴĴ     */
+};
+
+/** \brief ʱڴ */
+typedef struct am_arena *am_arena_t;
+
+/**
+ * \brief λñǣ am_arena_mark() ȡ
+ */
+typedef struct am_arena_mark {
+    char                  *p_cur;        /**< \brief λ                 */
+    struct am_arena_chunk *p_chunk;      /**< \brief ڵĺڴ         */
+} am_arena_mark_t;
+
+/**
+ * \brief ʼʱڴ
+ *
+ * \param[in] p_arena : Ҫʼʱڴ
+ * \param[in] p_buf   : 洢ռ
+ * \param[in] size    : 洢ռСֽڣΪ 0ֻʹúڴ飩
+ *
+ * \retval  AM_OK     : ʼ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_arena_init (struct am_arena *p_arena, void *p_buf, size_t size);
+
+/**
+ * \brief ô洢ռ䲻ʱʹõĶ
+ *
+ * \param[in] arena      : ʱڴ
+ * \param[in] p_heap     : ѣNULL ʾʹúڴ飨Ĭϣ
+ * \param[in] chunk_size : ÿδӶзССϴʵʴС
+ *
+ * \retval  AM_OK     : 
+ * \retval -AM_EINVAL : Ч
+ */
+int am_arena_fallback_set (am_arena_t         arena,
+                           struct am_memheap *p_heap,
+                           size_t             chunk_size);
+
+/**
+ * \brief ռ䣬ָС
+ *
+ * \param[in] arena : ʱڴ
+ * \param[in] size  : Сֽڣ
+ *
+ * \return ռ׵ַNULL ռ䲻
+ */
+void *am_arena_alloc (am_arena_t arena, size_t size);
+
+/**
+ * \brief ָ뷽ʽĿռ
+ *
+ * \param[in] arena : ʱڴ
+ * \param[in] size  : Сֽڣ
+ * \param[in] align : ֽΪ 2 
+ *
+ * \return ռ׵ַNULL ռ䲻Ч
+ */
+void *am_arena_alloc_align (am_arena_t arena, size_t size, size_t align);
+
+/**
+ * \brief ȡǰķλ
+ *
+ * \param[in] arena : ʱڴ
+ *
+ * \return λñ
+ */
+am_arena_mark_t am_arena_mark (am_arena_t arena);
+
+/**
+ * \brief ͷűλ֮ȫռ
+ *
+ * ֮ĺڴ黹ѡǱ밴ȡ෴˳ʹãѱ
+ * ͷŵıǲʹá
+ *
+ * \param[in] arena : ʱڴ
+ * \param[in] mark  : am_arena_mark() ȡı
+ *
+ * \return 
+ */
+void am_arena_reset_to (am_arena_t arena, am_arena_mark_t mark);
+
+/**
+ * \brief ͷȫռ
+ *
+ * \param[in] arena : ʱڴ
+ *
+ * \return 
+ */
+void am_arena_reset (am_arena_t arena);
+
+/**
+ * \brief ȡ洢ռʹֵˮλ洢ռСǷ
+ *
+ * \param[in] arena : ʱڴ
+ *
+ * \return ʹֵֽڣ
+ */
+size_t am_arena_high_water_get (am_arena_t arena);
+
+/**
+ * \brief ȡ洢ռ䲻ڴĴ
+ *
+ * \param[in] arena : ʱڴ
+ *
+ * \return ڴĴ
+ */
+uint32_t am_arena_fallback_get (am_arena_t arena);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_ARENA_H */
+
+/* end of file */
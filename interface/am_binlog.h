@@ -0,0 +1,268 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ־ӳٸʽ
+ *
+ *  am_kprintf() ͬ־㲻 MCU ϸʽʽַ .am_binlog_fmt
+ * У־ֻ¼ʽַĵַIDʱԭʼÿ 4 ֽڣ
+ *  tools/binlog/am_binlog_decode.py  ELF ļԭΪı
+ *
+ * ʹ GCC ʱӽű .am_binlog_fmt ηڲص INFO Уַ 0
+ * ʼʽַռ Flash¸öֻһ Flash У
+ * ID Ϊַ Flash еĵַͬԽ
+ *
+ * ƣ
+ * -  AM_BINLOG_ARGS_MAX
+ * - תΪ uint32_t ¼ָ֧ 64 λ
+ * - %s ֻ¼ַַ߽ܻԭ ELF ļеĳַ
+ *
+ * ÿ־ĸʽСˣ
+ * | ֽ |                        |
+ * | ------ | -------------------------- |
+ * | 1      | ֽͬ AM_BINLOG_SYNC    |
+ * | 1      |  n                 |
+ * | 4      | ʽַ ID              |
+ * | 4      | ʱ 32 λam_timestamp_get() |
+ * | 4 * n  |                        |
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_binlog.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  static char __g_binlog_buf[512];
+ *
+ *  am_binlog_init(__g_binlog_buf, sizeof(__g_binlog_buf));
+ *
+ *  AM_BINLOG("adc ch%d = %u mV\n", ch, mv);
+ *
+ *  while (1) {
+ *      am_binlog_uart_drain(uart_handle);   // ʱ
+ *  }
+ * \endcode
+ *
+ * 룺
+ * \code
+ *  python3 tools/binlog/am_binlog_decode.py app.elf binlog.bin
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_BINLOG_H
+#define __AM_BINLOG_H
+
+#include "am_common.h"
+#include "am_uart.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_binlog
+ * \copydoc am_binlog.h
+ * @{
+ */
+
+/** \brief ÿ־ֽͬ */
+#define AM_BINLOG_SYNC          0xA5
+
+/** \brief ÿ־ */
+#define AM_BINLOG_ARGS_MAX      6
+
+/**
+ * \name ¼ IDӦʽַ
+ * @{
+ */
+
+/** \brief ʱƵʼ¼ΪƵʣHzam_binlog_init() ʱд */
+#define AM_BINLOG_ID_FREQ       0xFFFFFFFFul
+
+/** \brief ʧ¼Ϊʱ־ */
+#define AM_BINLOG_ID_LOST       0xFFFFFFFEul
+
+/** @} */
+
+/** \brief ʽַڵĶ */
+#if defined(__CC_ARM) || defined(__GNUC__)
+#define __AM_BINLOG_FMT_SECTION  __attribute__((section(".am_binlog_fmt")))
+#else
+#define __AM_BINLOG_FMT_SECTION
+#endif
+
+/** \brief ¼һ־ڲʹã */
+#define __AM_BINLOG_SITE(fmt, p_args, nargs)                                   \
+    do {                                                                       \
+        static const char __am_binlog_fmt[] __AM_BINLOG_FMT_SECTION = fmt;     \
+        am_binlog_write(__am_binlog_fmt, (p_args), (nargs));                   \
+    } while (0)
+
+/** \brief ¼ n ־ڲʹã */
+#define __AM_BINLOG_N(n, ...)   __AM_BINLOG_CAT(__AM_BINLOG_, n)(__VA_ARGS__)
+#define __AM_BINLOG_CAT(a, b)   __AM_BINLOG_CAT_(a, b)
+#define __AM_BINLOG_CAT_(a, b)  a##b
+
+/** \brief ʽַĲڲʹã */
+#define __AM_BINLOG_NARGS(...) \
+    __AM_BINLOG_NARGS_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0, ~)
+#define __AM_BINLOG_NARGS_(f, a1, a2, a3, a4, a5, a6, n, ...)  n
+
+#define __AM_BINLOG_0(fmt)                                                     \
+    __AM_BINLOG_SITE(fmt, NULL, 0)
+
+#define __AM_BINLOG_1(fmt, a1)                                                 \
+    do {                                                                       \
+        uint32_t __am_binlog_args[1];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 1);                            \
+    } while (0)
+
+#define __AM_BINLOG_2(fmt, a1, a2)                                             \
+    do {                                                                       \
+        uint32_t __am_binlog_args[2];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __am_binlog_args[1] = (uint32_t)(a2);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 2);                            \
+    } while (0)
+
+#define __AM_BINLOG_3(fmt, a1, a2, a3)                                         \
+    do {                                                                       \
+        uint32_t __am_binlog_args[3];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __am_binlog_args[1] = (uint32_t)(a2);                                  \
+        __am_binlog_args[2] = (uint32_t)(a3);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 3);                            \
+    } while (0)
+
+#define __AM_BINLOG_4(fmt, a1, a2, a3, a4)                                     \
+    do {                                                                       \
+        uint32_t __am_binlog_args[4];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __am_binlog_args[1] = (uint32_t)(a2);                                  \
+        __am_binlog_args[2] = (uint32_t)(a3);                                  \
+        __am_binlog_args[3] = (uint32_t)(a4);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 4);                            \
+    } while (0)
+
+#define __AM_BINLOG_5(fmt, a1, a2, a3, a4, a5)                                 \
+    do {                                                                       \
+        uint32_t __am_binlog_args[5];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __am_binlog_args[1] = (uint32_t)(a2);                                  \
+        __am_binlog_args[2] = (uint32_t)(a3);                                  \
+        __am_binlog_args[3] = (uint32_t)(a4);                                  \
+        __am_binlog_args[4] = (uint32_t)(a5);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 5);                            \
+    } while (0)
+
+#define __AM_BINLOG_6(fmt, a1, a2, a3, a4, a5, a6)                             \
+    do {                                                                       \
+        uint32_t __am_binlog_args[6];                                          \
+        __am_binlog_args[0] = (uint32_t)(a1);                                  \
+        __am_binlog_args[1] = (uint32_t)(a2);                                  \
+        __am_binlog_args[2] = (uint32_t)(a3);                                  \
+        __am_binlog_args[3] = (uint32_t)(a4);                                  \
+        __am_binlog_args[4] = (uint32_t)(a5);                                  \
+        __am_binlog_args[5] = (uint32_t)(a6);                                  \
+        __AM_BINLOG_SITE(fmt, __am_binlog_args, 6);                            \
+    } while (0)
+
+/**
+ * \brief ¼һ־
+ *
+ * ÷ am_kprintf() ͬһΪַ
+ * AM_BINLOG_ARGS_MAX 
+ *
+ * \note жʹ
+ * \hideinitializer
+ */
+#define AM_BINLOG(...)  \
+    __AM_BINLOG_N(__AM_BINLOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+
+/**
+ * \brief ʼ־дʱƵʼ¼
+ *
+ * \param[in] p_buf : ־
+ * \param[in] size  : С
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ *
+ * \note Ӧ am_timestamp_module_init() ֮ãƵʼ¼Ϊ 0
+ */
+int am_binlog_init (char *p_buf, size_t size);
+
+/**
+ * \brief дһ־һʹ AM_BINLOG() ꣩
+ *
+ * ռ䲻ʱ־ռ㹻ʱдһʧ¼
+ *
+ * \param[in] p_fmt  : ʽַַΪ ID
+ * \param[in] p_args : 
+ * \param[in] nargs  :  AM_BINLOG_ARGS_MAX
+ *
+ * \return 
+ *
+ * \note жʹ
+ */
+void am_binlog_write (const char     *p_fmt,
+                      const uint32_t *p_args,
+                      unsigned        nargs);
+
+/**
+ * \brief ־ȡ
+ *
+ * \param[out] p_buf : ݵĻ
+ * \param[in]  size  : С
+ *
+ * \return ȡֽ
+ *
+ * \note ֻһȡ am_binlog_uart_drain() ͬʱʹ
+ */
+size_t am_binlog_read (void *p_buf, size_t size);
+
+/**
+ * \brief Բѯʽ־еȫ
+ *
+ * \param[in] handle : ڷ
+ *
+ * \return ͵ֽ
+ *
+ * \note ͨѭʱãֻһȡ
+ */
+size_t am_binlog_uart_drain (am_uart_handle_t handle);
+
+/**
+ * \brief ȡ򻺳־ۼƣ
+ * \return ־
+ */
+uint32_t am_binlog_dropped_get (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_BINLOG_H */
+
+/* end of file */
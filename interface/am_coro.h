@@ -0,0 +1,385 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ջЭ̣protothread am_jobq 
+ *
+ * ͬӿڣam_i2c_read()am_spi_write_then_read() ȣ am_wait_on() 
+ * ȴɣڼ޷Э̰һ豸д˳룬ڵȴ
+ * أɺɻصЭ¼УӵȴִУЭ
+ * 豸˿ڵϽС
+ *
+ * Эûжջÿλִָжһͨĺãˣ
+ * - ԽȴľֲᱣЭ̵ĽṹУʹ static
+ * - Э̺ switch ʵ֣Э̺вʹ switch Խȴ㣬ͬһ
+ *   Ҳȴ㣻
+ * - Э̺еĴУܵͬӿڡ
+ *
+ * Ϊ NULL ʱЭ̼жӳٶУam_isr_deferɸöеĴ
+ *  PendSVС
+ *
+ * 豸ɻصֱʹ am_coro_resume_cb()첽 I2CSPI ӿ轫
+ * AM_I2C_ASYNC_REQ_NUMAM_SPI_ASYNC_REQ_NUM Ϊ 0
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_coro.h"
+ * \endcode
+ *
+ * \par ڶȡһ I2C 
+ * \code
+ *  struct sensor_ctx {
+ *      am_coro_t        coro;
+ *      am_i2c_device_t  dev;
+ *      uint8_t          buf[6];
+ *  };
+ *
+ *  static int __sensor_coro (am_coro_t *p_coro, void *p_arg)
+ *  {
+ *      struct sensor_ctx *p_ctx = (struct sensor_ctx *)p_arg;
+ *
+ *      AM_CORO_BEGIN(p_coro);
+ *
+ *      while (1) {
+ *          AM_CORO_I2C_READ(p_coro, &p_ctx->dev, 0x00, p_ctx->buf, 6);
+ *          if (AM_CORO_STATUS(p_coro) == AM_OK) {
+ *              //  process p_ctx->buf
+ *          }
+ *          AM_CORO_DELAY(p_coro, 100);
+ *      }
+ *
+ *      AM_CORO_END(p_coro);
+ *  }
+ *
+ *  static struct sensor_ctx __g_sensor;
+ *
+ *  am_coro_init(&__g_sensor.coro, NULL, __sensor_coro, &__g_sensor, 0);
+ *  am_coro_start(&__g_sensor.coro);
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  AM_CORO_AWAIT() and AM_CORO_DELAY() ignore unrelated wake-ups
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_CORO_H
+#define __AM_CORO_H
+
+#include "am_common.h"
+#include "am_jobq.h"
+#include "am_softimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_coro
+ * \copydoc am_coro.h
+ * @{
+ */
+
+/**
+ * \name Э̺ķֵ
+ * @{
+ */
+
+#define AM_CORO_WAITING    0     /**< \brief Эڵȴ㷵أȴ  */
+#define AM_CORO_EXITED     1     /**< \brief Эѽ                    */
+
+/** @} */
+
+/** \brief Э */
+typedef struct am_coro am_coro_t;
+
+/**
+ * \brief Э̺
+ *
+ * \param[in] p_coro : Э
+ * \param[in] p_arg  : am_coro_init() õû
+ *
+ * \return AM_CORO_WAITING  AM_CORO_EXITEDЭ̺귵أû账
+ */
+typedef int (*am_coro_func_t) (am_coro_t *p_coro, void *p_arg);
+
+/**
+ * \brief Э̽ṹ
+ */
+struct am_coro {
+    am_jobq_job_t      job;      /**< \brief Э̵                 */
+    am_jobq_handle_t   jobq;     /**< \brief УNULL Ϊжӳٶ  */
+    am_coro_func_t     pfn;      /**< \brief Э̺                       */
+    void              *p_arg;    /**< \brief Э̺û             */
+    am_softimer_t      timer;    /**< \brief ʱʹõʱ           */
+    uint16_t           lc;       /**< \brief ִָеλãкţ         */
+    am_bool_t          exited;   /**< \brief ЭǷѽ                 */
+    int                status;   /**< \brief һεȴĽ         */
+    volatile int       result;   /**< \brief ɻصĽ             */
+    volatile am_bool_t pending;  /**< \brief ڵȴɻصʱ     */
+};
+
+/**
+ * \brief ʼЭ
+ *
+ * \param[in] p_coro : Э
+ * \param[in] jobq   : Э̵УNULL Ϊжӳٶ
+ * \param[in] pfn    : Э̺
+ * \param[in] p_arg  : Э̺û
+ * \param[in] pri    : Эڶеȼ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_coro_init (am_coro_t        *p_coro,
+                  am_jobq_handle_t  jobq,
+                  am_coro_func_t    pfn,
+                  void             *p_arg,
+                  uint16_t          pri);
+
+/**
+ * \brief Э̣ͷʼִУ
+ *
+ * \param[in] p_coro : Э
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EBUSY  : ЭУδ
+ * \retval -AM_EPERM  : в
+ */
+int am_coro_start (am_coro_t *p_coro);
+
+/**
+ * \brief Э̣ʹһ
+ *
+ *  am_pfnvoid_t ֱͬΪ UART մʱȻص
+ * жеãЭڶʱظ롣
+ *
+ * \param[in] p_coro : Э̣am_coro_t *
+ *
+ * \return 
+ */
+void am_coro_wake (void *p_coro);
+
+/**
+ * \brief 豸ɻص¼ AM_CORO_AWAIT() ĵȴЭ
+ *
+ * 첽 I2C/SPI ӿڵɻصADC ɻصֱͬʹá
+ * жеá
+ *
+ * \param[in] p_coro : Э̣am_coro_t *
+ * \param[in] status : 
+ *
+ * \return 
+ */
+void am_coro_resume_cb (void *p_coro, int status);
+
+/**
+ * \brief ЭǷѽ
+ *
+ * \param[in] p_coro : Э
+ *
+ * \retval AM_TRUE  : ѽδ
+ * \retval AM_FALSE : 
+ */
+am_bool_t am_coro_is_exited (am_coro_t *p_coro);
+
+/**
+ * \name Э̺
+ *
+ * ֻЭ̺ʹã p_coro ΪЭ̺Ĳ
+ * @{
+ */
+
+/** \brief Э̺ʼλЭ̺ʼ */
+#define AM_CORO_BEGIN(p_coro)       switch ((p_coro)->lc) { case 0:
+
+/** \brief Э̺λЭ̺ĩβ */
+#define AM_CORO_END(p_coro)         } (p_coro)->lc = 0; return AM_CORO_EXITED
+
+/** \brief Э */
+#define AM_CORO_EXIT(p_coro)                                                   \
+    do {                                                                       \
+        (p_coro)->lc = 0;                                                      \
+        return AM_CORO_EXITED;                                                 \
+    } while (0)
+
+/** \brief һεȴĽAM_OK 򸺵Ĵ룩 */
+#define AM_CORO_STATUS(p_coro)      ((p_coro)->status)
+
+/** \brief óекִ */
+#define AM_CORO_YIELD(p_coro)                                                  \
+    do {                                                                       \
+        (p_coro)->lc = __LINE__;                                               \
+        am_coro_wake(p_coro);                                                  \
+        return AM_CORO_WAITING;                                                \
+        case __LINE__:;                                                        \
+    } while (0)
+
+/**
+ * \brief ȴ
+ *
+ * ʱأжϡصȵ am_coro_wake() Ѻ¼顣
+ */
+#define AM_CORO_WAIT_UNTIL(p_coro, cond)                                       \
+    do {                                                                       \
+        (p_coro)->lc = __LINE__;                                               \
+        case __LINE__:                                                         \
+        if (!(cond)) {                                                         \
+            return AM_CORO_WAITING;                                            \
+        }                                                                      \
+    } while (0)
+
+/**
+ * \brief һ첽ȴ
+ *
+ * start ΪıʽɻصΪ am_coro_resume_cb()Ϊ p_coro
+ * start  AM_OK ʱȴɻصAM_CORO_STATUS() ΪصĽ
+ * 򲻵ȴAM_CORO_STATUS() Ϊ start صĴ롣
+ *
+ * ǰλ pendingɻص㣬ȴڼԭĻѣ
+ * am_coro_wake()ֻʹЭٴηأɻص start ǰʱȴ
+ */
+#define AM_CORO_AWAIT(p_coro, start)                                           \
+    do {                                                                       \
+        (p_coro)->lc      = __LINE__;                                          \
+        (p_coro)->pending = AM_TRUE;                                           \
+        (p_coro)->status  = (start);                                           \
+        if ((p_coro)->status == AM_OK) {                                       \
+        case __LINE__:                                                         \
+            if ((p_coro)->pending) {                                           \
+                return AM_CORO_WAITING;                                        \
+            }                                                                  \
+            (p_coro)->status = (p_coro)->result;                               \
+        } else {                                                               \
+            (p_coro)->pending = AM_FALSE;                                      \
+        }                                                                      \
+    } while (0)
+
+/**
+ * \brief ʱ ms 
+ *
+ *  AM_CORO_AWAIT() ͬʱǰԭĻѲʹЭִ̼С
+ */
+#define AM_CORO_DELAY(p_coro, ms)                                              \
+    do {                                                                       \
+        (p_coro)->lc      = __LINE__;                                          \
+        (p_coro)->pending = AM_TRUE;                                           \
+        am_softimer_start(&(p_coro)->timer, (ms));                             \
+        case __LINE__:                                                         \
+        if ((p_coro)->pending) {                                               \
+            return AM_CORO_WAITING;                                            \
+        }                                                                      \
+    } while (0)
+
+/** @} */
+
+/**
+ * \name ɵȴ豸
+ *
+ * ʹʱӦ豸ͷļ AM_CORO_STATUS() ȡ
+ * @{
+ */
+
+/**
+ * \brief  I2C ӻȡݣ am_i2c_read_async()
+ */
+#define AM_CORO_I2C_READ(p_coro, p_dev, sub_addr, p_buf, nbytes)               \
+    AM_CORO_AWAIT(p_coro, am_i2c_read_async((p_dev),                           \
+                                            (sub_addr),                        \
+                                            (p_buf),                           \
+                                            (nbytes),                          \
+                                            am_coro_resume_cb,                 \
+                                            (p_coro)))
+
+/**
+ * \brief  I2C ӻдݣ am_i2c_write_async()
+ */
+#define AM_CORO_I2C_WRITE(p_coro, p_dev, sub_addr, p_buf, nbytes)              \
+    AM_CORO_AWAIT(p_coro, am_i2c_write_async((p_dev),                          \
+                                             (sub_addr),                       \
+                                             (p_buf),                          \
+                                             (nbytes),                         \
+                                             am_coro_resume_cb,                \
+                                             (p_coro)))
+
+/**
+ * \brief SPI д am_spi_write_then_read_async()
+ */
+#define AM_CORO_SPI_WRITE_THEN_READ(p_coro,                                    \
+                                    p_dev,                                     \
+                                    p_txbuf,                                   \
+                                    n_tx,                                      \
+                                    p_rxbuf,                                   \
+                                    n_rx)                                      \
+    AM_CORO_AWAIT(p_coro, am_spi_write_then_read_async((p_dev),                \
+                                                       (p_txbuf),              \
+                                                       (n_tx),                 \
+                                                       (p_rxbuf),              \
+                                                       (n_rx),                 \
+                                                       am_coro_resume_cb,      \
+                                                       (p_coro)))
+
+/**
+ * \brief ȡ ADC תҶ룩 am_adc_start()
+ *
+ * p_desc Ϊ am_adc_buf_desc_t ͵Ļڵȴڼ䱣Ч
+ * Э̵ĽṹУ
+ */
+#define AM_CORO_ADC_READ(p_coro, handle, chan, p_desc, p_val, length)          \
+    AM_CORO_AWAIT(p_coro, (am_adc_mkbufdesc((p_desc),                          \
+                                            (p_val),                           \
+                                            (length),                          \
+                                            am_coro_resume_cb,                 \
+                                            (p_coro)),                         \
+                           am_adc_start((handle),                              \
+                                        (chan),                                \
+                                        (p_desc),                              \
+                                        1,                                     \
+                                        1,                                     \
+                                        AM_ADC_DATA_ALIGN_RIGHT,               \
+                                        NULL,                                  \
+                                        NULL)))
+
+/**
+ * \brief  UART ջȡ nbytes ֽݣݲʱȴ
+ *
+ * ʹ UART ĽմЭ̣Ḳǽմãȴرս
+ * AM_CORO_STATUS() Ϊ am_uart_rngbuf_receive() ķֵ
+ */
+#define AM_CORO_UART_RNGBUF_RECEIVE(p_coro, handle, p_buf, nbytes)             \
+    do {                                                                       \
+        am_uart_rngbuf_rx_trigger_cfg((handle),                                \
+                                      (nbytes),                                \
+                                      am_coro_wake,                            \
+                                      (p_coro));                               \
+        am_uart_rngbuf_rx_trigger_enable(handle);                              \
+        AM_CORO_WAIT_UNTIL(p_coro,                                             \
+                           am_uart_rngbuf_nread_get(handle) >= (nbytes));      \
+        am_uart_rngbuf_rx_trigger_disable(handle);                             \
+        (p_coro)->status = am_uart_rngbuf_receive((handle), (p_buf), (nbytes));\
+    } while (0)
+
+/** @} */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_CORO_H */
+
+/* end of file */
@@ -0,0 +1,171 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief CPU ͳ
+ *
+ *  AM_CPU_LOAD_ENABLE Ϊ 1 CPU ʱ䱻Ϊ¼࣬ÿл
+ * ʱ am_timestamp_get()Ӳʱʱǲͳƣ͸ʱͬ׼ȷ
+ * - жϣam_exc_eint_handler()SysTick_Handler()
+ * - am_jobq_process()am_jobq_process_budget() еʱ䣬
+ *          PendSV_Handler()жӳ񣩻ѭеã
+ *         PendSV_Handler() вĴͬΪ
+ * - Уam_wait_on()am_wait_on_timeout() ĵȴ am_mdelay() ʱ
+ * - ѭʱ䡣
+ *
+ * Ƕʱȴڼ䷢жϣڲÿ AM_CPU_LOAD_PERIOD_MS
+ * 뱣һθʱ䣬am_cpu_load_get() ɸڣڣ
+ * ڸռı
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_cpu_load.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  am_cpu_load_t load;
+ *
+ *  am_cpu_load_init();
+ *
+ *  while (1) {
+ *      // ...
+ *      if (am_cpu_load_get(1000, &load) == AM_OK) {
+ *          am_kprintf("busy %u.%u%%\r\n", load.busy / 10, load.busy % 10);
+ *      }
+ *  }
+ * \endcode
+ *
+ * \note ʱʱӦ am_timestamp_module_init() ֮ʼ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.02 26-10-17  am_jobq charges jobs as JOB again, also from the main loop
+ * - 1.01 26-10-17  PendSV is charged as JOB, am_jobq no longer calls this service
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_CPU_LOAD_H
+#define __AM_CPU_LOAD_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_cpu_load
+ * \copydoc am_cpu_load.h
+ * @{
+ */
+
+/** \brief Ƿʹ CPU ͳƣʱĬϲʹܣлûж⿪ */
+#ifndef AM_CPU_LOAD_ENABLE
+#define AM_CPU_LOAD_ENABLE      0
+#endif
+
+/** \brief ͳڣmsڵ */
+#ifndef AM_CPU_LOAD_PERIOD_MS
+#define AM_CPU_LOAD_PERIOD_MS   100
+#endif
+
+/** \brief ڸΪ AM_CPU_LOAD_PERIOD_MS * ֵ */
+#ifndef AM_CPU_LOAD_HIST_NUM
+#define AM_CPU_LOAD_HIST_NUM    10
+#endif
+
+/**
+ * \name CPU ʱ
+ * @{
+ */
+#define AM_CPU_LOAD_MAIN    0    /**< \brief ѭ */
+#define AM_CPU_LOAD_IRQ     1    /**< \brief ж */
+#define AM_CPU_LOAD_JOB     2    /**< \brief е */
+#define AM_CPU_LOAD_IDLE    3    /**< \brief Уȴʱ */
+#define AM_CPU_LOAD_NUM     4    /**< \brief  */
+/** @} */
+
+/**
+ * \brief CPU 
+ */
+typedef struct am_cpu_load {
+
+    /** \brief ʵͳƵʱ䳤ȣms */
+    uint32_t window_ms;
+
+    /** \brief ռıǧֱȣΪ± */
+    uint16_t permille[AM_CPU_LOAD_NUM];
+
+    /** \brief ǿʱռıǧֱȣ */
+    uint16_t busy;
+
+} am_cpu_load_t;
+
+#if (AM_CPU_LOAD_ENABLE != 0)
+
+/**
+ * \brief ʼ CPU ͳƣͳƵݲʼͳ
+ *
+ * \retval  AM_OK   : ɹ
+ * \retval -AM_EPERM : ʱ
+ */
+int am_cpu_load_init (void);
+
+/**
+ * \brief ĳһ
+ *
+ *  am_cpu_load_exit() ɶԵãǶ
+ *
+ * \param[in] type :  #AM_CPU_LOAD_IRQ
+ *
+ * \return ǰΪ am_cpu_load_exit() Ĳ
+ */
+int am_cpu_load_enter (int type);
+
+/**
+ * \brief ˳ǰ𣬻صǰ
+ *
+ * \param[in] prev : am_cpu_load_enter() ķֵ
+ *
+ * \return 
+ */
+void am_cpu_load_exit (int prev);
+
+/**
+ * \brief ȡһʱ CPU 
+ *
+ * \param[in]  window_ms : ڳȣmsͳȡ
+ *                         ʱԱȫڼ
+ * \param[out] p_load    : ڻȡ CPU 
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EAGAIN : δһͳ
+ */
+int am_cpu_load_get (uint32_t window_ms, am_cpu_load_t *p_load);
+
+#endif /* (AM_CPU_LOAD_ENABLE != 0) */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_CPU_LOAD_H */
+
+/* end of file */
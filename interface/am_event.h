@@ -25,8 +25,17 @@
  * 2. ¼־ AM_EVENT_PROC_FLAG_CAT_ONLY event typeе
  *    event handler Ҳִһ顣
  *
+ * ¼ַ
+ * Ĭ am_event_raise() ִ¼AM_EVENT_QUEUE_SIZE Ϊ 0 ʱ
+ * Ϊзַģʽam_event_raise() ֻ¼Ужʱ̶ж
+ * ӳҵִ¼жд¼ʱжִС
+ * ģʽ±¼ʱرжϣִڼעᡢע
+ *
  * \internal
  * \par modification history:
+ * - 1.03 26-10-17 am_event_raise_copy() size limit applies to queued mode only.
+ * - 1.02 26-10-17 add registration generation to am_event_handler_t.
+ * - 1.01 26-10-17 add queued dispatch, traverse handlers with interrupts enabled.
  * - 1.00 17-05-12 tee, first implementation.
  * \endinternal
  */
@@ -66,6 +75,30 @@ extern "C" {
 
 /** @} */
 
+/**
+ * \brief ¼еĴСɻ¼
+ *
+ * Ϊ 0 ʱ am_event_raise() ַ¼ĬϣΪ 0 ʱΪзַģʽ
+ * ʼжӳģ飨am_isr_deferڹ̵Ԥжúꡣ
+ */
+#ifndef AM_EVENT_QUEUE_SIZE
+#define AM_EVENT_QUEUE_SIZE          0
+#endif
+
+/**
+ * \brief зַģʽ£am_event_raise_copy() ɸƵ¼ݵֽ
+ */
+#ifndef AM_EVENT_QUEUE_DATA_SIZE
+#define AM_EVENT_QUEUE_DATA_SIZE     8
+#endif
+
+/**
+ * \brief зַģʽ£ַ¼жӳҵȼ
+ */
+#ifndef AM_EVENT_QUEUE_JOB_PRI
+#define AM_EVENT_QUEUE_JOB_PRI       0
+#endif
+
 /** \breif event_category ṹ */
 struct am_event_category;
 typedef struct am_event_category am_event_category_t;
@@ -99,6 +132,7 @@ struct am_event_handler {
     am_event_function_t     *pfn_proc;  /**< \brief   */
     void                    *p_data;    /**< \brief ¼˽      */
     struct am_event_handler *p_next;    /**< \brief ָһ¼  */
+    uint32_t                 gen;       /**< \brief עʱĴڲʹã */
 };
 
 /** \brief ʼ¼ */
@@ -112,6 +146,7 @@ void am_event_handler_init (am_event_handler_t  *p_handler,
     p_handler->pfn_proc = pfn_proc;
     p_handler->p_data   = p_data;
     p_handler->p_next   = NULL;
+    p_handler->gen      = 0;
 }
 
 
@@ -152,9 +187,39 @@ int am_event_handler_unregister (am_event_type_t     *p_event,
  * \param flags        ־, 0  AM_EVENT_PROC_FLAG_*
  *
  * \return ׼
+ *
+ * \note зַģʽ¼ԺִУp_evt_data ¼ǰ뱣
+ *       Чλջʱʹ am_event_raise_copy()ʱ
+ *       -AM_ENOSPC¼
  */
 int am_event_raise (am_event_type_t *p_event, void *p_evt_data, int flags);
 
+/**
+ * \brief һ¼¼
+ *
+ *  am_event_raise() ͬзַģʽ½¼ݸƵУ¼
+ * õݵĸλջϵַģʽ²ơ
+ *
+ * \param p_event      ¼
+ * \param p_evt_data   ¼
+ * \param size         ¼ݵֽзַģʽ²ܳ
+ *                       AM_EVENT_QUEUE_DATA_SIZE
+ * \param flags        ־, 0  AM_EVENT_PROC_FLAG_*
+ *
+ * \return ׼
+ */
+int am_event_raise_copy (am_event_type_t *p_event,
+                         const void      *p_evt_data,
+                         size_t           size,
+                         int              flags);
+
+/**
+ * \brief ȡзַģʽ¼
+ *
+ * \return ¼ַģʽΪ 0
+ */
+uint32_t am_event_queue_overflow_get (void);
+
 /**
  * \brief ¼ṹ嶨壬¼¼
  *
@@ -0,0 +1,178 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ¼־
+ *
+ * ¼־Ϊһ 32 λı־ÿһλӦһ¼ SPI DMA ɡ
+ * GPIO źţжʹ am_event_group_set() λȴʹ
+ * am_event_group_wait() ȴһλȫλͬʱȴ¼ɡ
+ *
+ *  am_wait ͬȴڼڹж״ִ̬ am_wait_idle_set() õĿ
+ * квٴεȴҲܴУ am_wait_idle_set()
+ *
+ * ʱ״̬ÿεȴУ¼鱾ֻ¼־ʹ
+ * AM_EVENT_GROUP_CLEAR ʱȴɹλ֮ĵȴ߲ٿɼ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_event_group.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  #define __EVT_SPI_DONE    (1u << 0)
+ *  #define __EVT_DEV_READY   (1u << 1)
+ *
+ *  static am_event_group_t __g_evt;
+ *
+ *  static void __spi_done_cb (void *p_arg, int status)
+ *  {
+ *      am_event_group_set(&__g_evt, __EVT_SPI_DONE);
+ *  }
+ *
+ *  static void __ready_pin_isr (void *p_arg)
+ *  {
+ *      am_event_group_set(&__g_evt, __EVT_DEV_READY);
+ *  }
+ *
+ *  uint32_t bits;
+ *
+ *  am_event_group_init(&__g_evt);
+ *  //  start the SPI transfer
+ *  if (am_event_group_wait(&__g_evt,
+ *                          __EVT_SPI_DONE | __EVT_DEV_READY,
+ *                          AM_EVENT_GROUP_WAIT_ALL | AM_EVENT_GROUP_CLEAR,
+ *                          100,
+ *                          &bits) == AM_OK) {
+ *      //  both events occurred
+ *  }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.02 26-10-17  the idle hook must not wait; drop the nested waiter claim
+ * - 1.01 26-10-17  per-call timeout state, allowing nested waiters
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_EVENT_GROUP_H
+#define __AM_EVENT_GROUP_H
+
+#include "am_common.h"
+#include "am_softimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_event_group
+ * \copydoc am_event_group.h
+ * @{
+ */
+
+/**
+ * \name ȴѡʹ | 
+ * @{
+ */
+
+#define AM_EVENT_GROUP_WAIT_ANY    0x00  /**< \brief ȴһλλĬϣ */
+#define AM_EVENT_GROUP_WAIT_ALL    0x01  /**< \brief ȴȫλλ           */
+#define AM_EVENT_GROUP_CLEAR       0x02  /**< \brief ȴɹȴλ   */
+
+/** @} */
+
+/**
+ * \brief ¼־飬ӦóӦֱӲýṹԱ
+ */
+typedef struct am_event_group {
+    volatile uint32_t  bits;       /**< \brief ¼־                  */
+} am_event_group_t;
+
+/**
+ * \brief ʼ¼־飬ȫλ
+ *
+ * \param[in] p_grp : ¼־
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_event_group_init (am_event_group_t *p_grp);
+
+/**
+ * \brief λ¼־
+ *
+ * \param[in] p_grp : ¼־
+ * \param[in] bits  : Ҫλλ
+ *
+ * \return λ¼־
+ *
+ * \note же
+ */
+uint32_t am_event_group_set (am_event_group_t *p_grp, uint32_t bits);
+
+/**
+ * \brief ¼־
+ *
+ * \param[in] p_grp : ¼־
+ * \param[in] bits  : Ҫλ
+ *
+ * \return ǰ¼־
+ *
+ * \note же
+ */
+uint32_t am_event_group_clear (am_event_group_t *p_grp, uint32_t bits);
+
+/**
+ * \brief ȡǰ¼־ȴ
+ *
+ * \param[in] p_grp : ¼־
+ *
+ * \return ¼־
+ */
+uint32_t am_event_group_get (am_event_group_t *p_grp);
+
+/**
+ * \brief ȴ¼־
+ *
+ * \param[in]  p_grp      : ¼־
+ * \param[in]  bits       : ȴλΪ 0
+ * \param[in]  flags      : ȴѡ AM_EVENT_GROUP_WAIT_ALL
+ * \param[in]  timeout_ms : ʱʱ䣨λmsΪ 0 ʱһֱȴ
+ * \param[out] p_bits     : ȴʱ¼־֮ǰҪʱΪ NULL
+ *
+ * \retval  AM_OK     : ȴɹ
+ * \retval -AM_ETIME  : ȴʱ
+ * \retval -AM_EINVAL : Ч
+ *
+ * \note жеãҲڵȴĿке
+ */
+int am_event_group_wait (am_event_group_t *p_grp,
+                         uint32_t          bits,
+                         uint32_t          flags,
+                         uint32_t          timeout_ms,
+                         uint32_t         *p_bits);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_EVENT_GROUP_H */
+
+/* end of file */
@@ -37,6 +37,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.04 26-10-17  add asynchronous read/write.
  * - 1.03 15-12-08  cyl, delete the am_i2c_connect.
  * - 1.02 15-10-27  tee, add the concept of message.
  * - 1.01 15-08-19  tee, modified some interface.
@@ -454,6 +455,70 @@ int am_i2c_read(am_i2c_device_t *p_dev,
                 uint32_t         sub_addr,
                 uint8_t         *p_buf, 
                 uint32_t         nbytes);
+
+/**
+ * \brief 첽дͬʱе
+ *
+ * 첽дϢʹڲĶڴذ䣬ÿԼռ 60 ֽڡΪ 0
+ * ʱṩ첽дӿڡڹ̵Ԥжúꡣ
+ */
+#ifndef AM_I2C_ASYNC_REQ_NUM
+#define AM_I2C_ASYNC_REQ_NUM    0
+#endif
+
+#if (AM_I2C_ASYNC_REQ_NUM > 0)
+
+/**
+ * \brief 첽дɻص
+ *
+ * \param[in] p_arg  : û
+ * \param[in] status : дAM_OK ʾɹ
+ */
+typedef void (*am_i2c_async_cb_t) (void *p_arg, int status);
+
+/**
+ * \brief I2C첽дݣأʱûص
+ *
+ * \param[in] p_dev    : ָӻ豸ϢĽṹָ
+ * \param[in] sub_addr : ӻ豸ӵַ
+ * \param[in] p_buf    : ָݻ棬ǰ뱣Ч
+ * \param[in] nbytes   : ݻ泤
+ * \param[in] pfn_cb   : ɻصͨжеãΪ NULL
+ * \param[in] p_arg    : صû
+ *
+ * \retval  AM_OK      : 
+ * \retval -AM_ENOMEM  : ڽеѴ AM_I2C_ASYNC_REQ_NUM 
+ * \retval         : ʧܣصᱻ
+ */
+int am_i2c_write_async(am_i2c_device_t   *p_dev,
+                       uint32_t           sub_addr,
+                       const uint8_t     *p_buf,
+                       uint32_t           nbytes,
+                       am_i2c_async_cb_t  pfn_cb,
+                       void              *p_arg);
+
+/**
+ * \brief I2C첽ݣأʱûص
+ *
+ * \param[in] p_dev    : ָӻ豸ϢĽṹָ
+ * \param[in] sub_addr : ӻ豸ӵַ
+ * \param[in] p_buf    : ָݻ棬ǰ뱣Ч
+ * \param[in] nbytes   : ݻ泤
+ * \param[in] pfn_cb   : ɻصͨжеãΪ NULL
+ * \param[in] p_arg    : صû
+ *
+ * \retval  AM_OK      : 
+ * \retval -AM_ENOMEM  : ڽеѴ AM_I2C_ASYNC_REQ_NUM 
+ * \retval         : ʧܣصᱻ
+ */
+int am_i2c_read_async(am_i2c_device_t   *p_dev,
+                      uint32_t           sub_addr,
+                      uint8_t           *p_buf,
+                      uint32_t           nbytes,
+                      am_i2c_async_cb_t  pfn_cb,
+                      void              *p_arg);
+
+#endif /* (AM_I2C_ASYNC_REQ_NUM > 0) */
 /** 
  * @}
  */
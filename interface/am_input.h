@@ -51,6 +51,7 @@
  *
  * \internal
  * \par modification history
+ * - 1.01 26-10-17  am_input_key_report() returns the event raise result.
  * - 1.00 17-05-15  tee, first implementation.
  * \endinternal
  */
@@ -106,7 +107,12 @@ typedef struct am_input_key_handler {
  * \param[in] key_code   : 
  * \param[in] key_state  : ״̬AM_INPUT_KEY_STATE_PRESSED
  *
- * \return ׼
+ * \retval  AM_OK     : ϱɹзַģʽΪѼ¼У
+ * \retval -AM_ENOSPC : ¼¼зַģʽ
+ *                      AM_EVENT_QUEUE_SIZE
+ * \retval -AM_EINVAL : AM_EVENT_QUEUE_DATA_SIZE Сڰ¼ݵĴС
+ *
+ * \note 1.01 ֮ǰǷ AM_OK
  */
 int am_input_key_report (int key_code, int key_state);
 
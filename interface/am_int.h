@@ -16,6 +16,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add am_int_in_isr().
  * - 1.00 14-12-04  hbt, first implementation.
  * \endinternal
  */
@@ -117,6 +118,17 @@ uint32_t am_int_cpu_lock(void);
  */
 void am_int_cpu_unlock(uint32_t key);
 
+/**
+ * \brief жϵǰǷжϣ쳣
+ *
+ * жвܵȴжɵĲȴڷжڳɾݴ
+ * Ϊѯʽ
+ *
+ * \retval 0   : ߳ģʽ
+ * \retval 0 : жϴУֵΪǰ쳣
+ */
+uint32_t am_int_in_isr(void);
+
 /**
  * @} 
  */
@@ -0,0 +1,149 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief жϸ
+ *
+ *  AM_IRQ_TRACE_ENABLE Ϊ 1 am_exc_eint_handler()SysTick_Handler()
+ * PendSV_Handler() ж˳ʱ¼жϺšʱ䣨am_timestamp_get() ĵ
+ * 32 λͳʱ䣬д RAM еĻμ¼󸲸ļ¼
+ *
+ * ¼ַͨʽȡ
+ * tools/irq_trace/am_irq_trace_perfetto.py תΪ Chrome/Perfetto ļ
+ *  ui.perfetto.dev  chrome://tracing д򿪣
+ * - am_irq_trace_dump() ıʽԴڣ洮ɣ
+ * - ֱӶȡ g_am_irq_trace ڴ棨sizeof(g_am_irq_trace) ֽڣ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_irq_trace.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  am_irq_trace_start();
+ *  //  run under real load
+ *  am_irq_trace_stop();
+ *  am_irq_trace_dump();
+ * \endcode
+ *
+ * \note Ӧ am_timestamp_module_init() ֮ʼ¼ʱΪ 0
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_IRQ_TRACE_H
+#define __AM_IRQ_TRACE_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_irq_trace
+ * \copydoc am_irq_trace.h
+ * @{
+ */
+
+/** \brief Ƿʹжϸ٣ʱĬϲʹܣжϴûж⿪ */
+#ifndef AM_IRQ_TRACE_ENABLE
+#define AM_IRQ_TRACE_ENABLE     0
+#endif
+
+/** \brief ¼ӦΪ 2 ݣжȡ಻Ҫ */
+#ifndef AM_IRQ_TRACE_REC_NUM
+#define AM_IRQ_TRACE_REC_NUM    128
+#endif
+
+/** \brief g_am_irq_trace ıʶڴתв */
+#define AM_IRQ_TRACE_MAGIC      0x51525449ul
+
+/**
+ * \name ں쳣жϺţͬ CMSIS
+ * @{
+ */
+#define AM_IRQ_TRACE_INUM_PENDSV    (-2)    /**< \brief PendSV  */
+#define AM_IRQ_TRACE_INUM_SYSTICK   (-1)    /**< \brief SysTick */
+/** @} */
+
+/** \brief һжϼ¼ */
+typedef struct am_irq_trace_rec {
+    uint32_t  ts;           /**< \brief ʱ䣨ʱ 32 λ      */
+    uint32_t  dur;          /**< \brief ʱ䣨Ƕ׵жϣ        */
+    int16_t   inum;         /**< \brief жϺ                          */
+    uint16_t  reserved;     /**< \brief                             */
+} am_irq_trace_rec_t;
+
+/** \brief жϸټ¼ڴ沼̶ֹ߽ */
+typedef struct am_irq_trace {
+    uint32_t            magic;      /**< \brief AM_IRQ_TRACE_MAGIC          */
+    uint32_t            freq;       /**< \brief ʱƵʣHz            */
+    uint32_t            rec_num;    /**< \brief ¼                    */
+    volatile uint32_t   count;      /**< \brief дļ¼            */
+    volatile uint32_t   enabled;    /**< \brief Ƿڼ¼                */
+    am_irq_trace_rec_t  recs[AM_IRQ_TRACE_REC_NUM]; /**< \brief μ¼   */
+} am_irq_trace_t;
+
+/** \brief жϸټ¼ */
+extern am_irq_trace_t g_am_irq_trace;
+
+/**
+ * \brief жϽʱãжϴã
+ * \return ʱ
+ */
+uint32_t am_irq_trace_enter (void);
+
+/**
+ * \brief ж˳ʱãдһ¼жϴã
+ *
+ * \param[in] inum : жϺ
+ * \param[in] ts   : am_irq_trace_enter() ķֵ
+ *
+ * \return 
+ */
+void am_irq_trace_exit (int inum, uint32_t ts);
+
+/**
+ * \brief ռ¼ʼ¼
+ * \return 
+ */
+void am_irq_trace_start (void);
+
+/**
+ * \brief ֹͣ¼
+ * \return 
+ */
+void am_irq_trace_stop (void);
+
+/**
+ * \brief ıʽ¼Դڣam_kprintf()ڼͣ¼
+ * \return 
+ */
+void am_irq_trace_dump (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_IRQ_TRACE_H */
+
+/* end of file */
@@ -32,6 +32,8 @@
  *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-17  add counting/payload batch jobs, job_add reports -AM_EBUSY
+ * - 1.01 26-10-17  add am_isr_defer_job_process_budget()
  * - 1.00 15-09-17  tee, first implementation
  * \endinternal
  */
@@ -46,6 +48,7 @@
  */
 #include "am_list.h"
 #include "am_jobq.h"
+#include "am_msgq.h"
 #include <string.h>
 
 /** \brief жӳ */
@@ -116,6 +119,23 @@ void am_isr_defer_init (am_isr_defer_add_cb_t pfn_cb, void *p_arg);
  */
 int am_isr_defer_job_process (void);
 
+/**
+ * \brief Ԥ㴦жӳ
+ *
+ * Ԥأʣ´δӳʱռô
+ * ѭιݽòС
+ *
+ * \param[in]  p_budget : Ԥ㣬 am_jobq_budget_tNULL ʾ
+ * \param[out] p_remain : ʣΪ NULL
+ *
+ * \retval AM_OK      ߽ڵȫ
+ * \retval -AM_EAGAIN : Ԥ꣬δ
+ * \retval -AM_EBUSY  : ط
+ * \retval -AM_EINVAL : isr deferģδʼ
+ */
+int am_isr_defer_job_process_budget (const am_jobq_budget_t *p_budget,
+                                     unsigned int           *p_remain);
+
 /**
  * \brief ʼһӳ
  *
@@ -150,6 +170,92 @@ void am_isr_defer_job_init (am_isr_defer_job_t  *p_job,
  */
 int am_isr_defer_job_add (am_isr_defer_job_t *p_job);
 
+/**
+ * \brief ӳĴ
+ *
+ * \param[in] p_arg : û
+ * \param[in] count : ϴδ¼򻺳
+ *                    ¼Ϊ 0
+ */
+typedef void (*am_isr_defer_batch_cb_t) (void *p_arg, uint32_t count);
+
+/**
+ * \brief ӳ
+ *
+ * ͨӳڴǰٴӻʧܣ-AM_EBUSYǰη¼ֻ
+ * õһδӳ¼¼ĴΪÿ¼һ
+ * ݣһεõ¼ GPIO ء벶񡢴ڴƵ
+ * жϡӦóӦֱӲṹԱ
+ */
+typedef struct am_isr_defer_batch {
+    am_isr_defer_job_t       job;     /**< \brief ӳ                   */
+    volatile uint32_t        count;   /**< \brief δ¼         */
+    struct am_msgq           msgq;    /**< \brief ¼                   */
+    am_bool_t                has_data;/**< \brief Ƿ񱣴¼           */
+    am_isr_defer_batch_cb_t  pfn_cb;  /**< \brief                    */
+    void                    *p_arg;   /**< \brief û         */
+} am_isr_defer_batch_t;
+
+/**
+ * \brief ʼӳ
+ *
+ * \param[in] p_batch   : ӳ񣬱Ϊȫֱ̬
+ * \param[in] pfn_cb    : 
+ * \param[in] p_arg     : û
+ * \param[in] pri       : ȼ
+ * \param[in] p_buf     : ¼ݻСΪ elem_size * elem_num
+ *                        Ϊ NULL ʱֻ¼¼
+ * \param[in] elem_size : ÿ¼ݵĴСֽڣ
+ * \param[in] elem_num  : ౣ¼ݸ
+ *
+ * \retval AM_OK      ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_isr_defer_batch_init (am_isr_defer_batch_t    *p_batch,
+                             am_isr_defer_batch_cb_t  pfn_cb,
+                             void                    *p_arg,
+                             uint16_t                 pri,
+                             void                    *p_buf,
+                             size_t                   elem_size,
+                             size_t                   elem_num);
+
+/**
+ * \brief ¼һ¼ڱҪʱӵжӳٹ
+ *
+ * ͨжеãڲͬȼжеá
+ *
+ * \param[in] p_batch : ӳ
+ * \param[in] p_data  : ¼ݣСΪ elem_sizeֻ¼ʱΪ NULL
+ *
+ * \retval AM_OK      ¼ɹ
+ * \retval -AM_ENOSPC : Ѽ¼ݻݱ
+ * \retval -AM_EPERM  : isr deferģδȷʼʹ
+ */
+int am_isr_defer_batch_post (am_isr_defer_batch_t *p_batch, const void *p_data);
+
+/**
+ * \brief ڴжȡһ¼
+ *
+ * \param[in]  p_batch : ӳ
+ * \param[out] p_data  : ȡ¼ݣСΪ elem_size
+ *
+ * \retval AM_OK      ȡɹ
+ * \retval -AM_EAGAIN : û¼
+ *
+ * \note ֻڴеáȡ·¼ҲܱȡЩ
+ *       ¼Ĵһδ
+ */
+int am_isr_defer_batch_read (am_isr_defer_batch_t *p_batch, void *p_data);
+
+/**
+ * \brief ȡݻ¼ݸ
+ *
+ * \param[in] p_batch : ӳ
+ *
+ * \return ĸ
+ */
+uint32_t am_isr_defer_batch_lost_get (am_isr_defer_batch_t *p_batch);
+
 /** @}  */
 
 #ifdef __cplusplus
@@ -30,6 +30,9 @@
  *
  * \internal
  * \par modification history:
+ * - 1.03 26-10-17  processing time budget uses a caller-supplied clock
+ * - 1.02 26-10-17  add am_jobq_job_is_queued()
+ * - 1.01 26-10-17  add am_jobq_process_budget()
  * - 1.00 15-09-17  tee, first implementation
  * \endinternal
  */
@@ -65,6 +68,9 @@ typedef struct am_jobq_queue {
  
     /** \brief еһЩ״̬־      */
     uint32_t              flags;
+
+    /** \brief е            */
+    unsigned int          job_num;
 } am_jobq_queue_t;
 
 /**
@@ -145,6 +151,16 @@ void am_jobq_job_init (am_jobq_job_t  *p_job,
                        am_pfnvoid_t    func,
                        void           *p_arg,
                        uint16_t        pri);
+
+/**
+ * \brief жǷڶУӵδ
+ *
+ * \param[in] p_job : ָָ
+ *
+ * \retval AM_TRUE  : ڶУʱ³ʼ
+ * \retval AM_FALSE : ڶ
+ */
+am_bool_t am_jobq_job_is_queued (am_jobq_job_t *p_job);
  
 /**
  * \brief һӵ
@@ -172,6 +188,76 @@ int am_jobq_post (am_jobq_handle_t handle, am_jobq_job_t *p_job);
  */
 int am_jobq_process (am_jobq_handle_t handle);
 
+/**
+ * \brief еδԤ
+ *
+ * ͬʱЧһ꼴ֹͣδڶУ
+ * ´δʱÿδٴһпɴ񣩡
+ */
+typedef struct am_jobq_budget {
+
+    /** \brief ദ0 ʾ */
+    unsigned int  max_jobs;
+
+    /**
+     * \brief ʱ䣬λ pfn_time_get() ķֵͬ0 ʾ
+     *
+     * ÿɺ飬ʵʱܳһĺʱ
+     */
+    uint32_t      max_time;
+
+    /**
+     * \brief ȡǰʱĺmax_time Ϊ 0 ʱṩ
+     *
+     * вļʱɵṩʱӣʱĵ 32 λϵͳ
+     * ġֵ 32 λ޷ƣζ֮Ϊʱ䡣
+     */
+    uint32_t    (*pfn_time_get) (void);
+
+    /**
+     * \brief ȼ߽磬ֻȼֵڸֵ
+     *
+     * Ϊ pri_num - 1 ֵʾƣֻʣȼ͵ʱֹͣ
+     * Щʱѭ
+     */
+    unsigned int  pri_limit;
+
+    /**
+     * \brief ÿȼÿദ0 ʾϸȼ
+     *
+     * Ϊ 0 ʱȼǰȼ pri_quota ֵһ
+     * Ľϵȼ͵ȼ֮ٻصߵȼƵ
+     * 񲻻һֱռôʱ䣬ϸȼҪȴһ֡
+     */
+    unsigned int  pri_quota;
+} am_jobq_budget_t;
+
+/**
+ * \brief Ԥ㴦һ
+ *
+ * \param[in]  handle   : еı׼
+ * \param[in]  p_budget : Ԥ㣬NULL ʾƣ am_jobq_process() ͬ
+ * \param[out] p_remain : ضʣȼ߽񣩣
+ *                        Ϊ NULL
+ *
+ * \retval AM_OK      ߽ڵȫ
+ * \retval -AM_EAGAIN : Ԥ߽꣬δ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EBUSY  : ǰڴ
+ */
+int am_jobq_process_budget (am_jobq_handle_t        handle,
+                            const am_jobq_budget_t *p_budget,
+                            unsigned int           *p_remain);
+
+/**
+ * \brief ȡе
+ *
+ * \param[in] handle : еı׼
+ *
+ * \return 
+ */
+unsigned int am_jobq_job_num_get (am_jobq_handle_t handle);
+
 /**
  * \brief ʵָʹõȼ
  *
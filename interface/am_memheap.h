@@ -14,8 +14,17 @@
  * \file
  * \brief ѹ
  *
+ * Ĭʹ״䣨first-fit㷨ʱ˳ҿʱƬ̶
+ * йءʹ am_memheap_tlsf_init() ʼĶʹ䣨TLSF㷨
+ * Сּп飬䡢ͷŵĺʱȷޣпĿ޹ء
+ *
  * \internal
  * \par modification history:
+ * - 1.05 26-10-17  add *_tagged() entries and AM_MEMHEAP_CALLER()
+ * - 1.04 26-10-17  document the footprint of am_memheap_alloc_align()
+ * - 1.03 26-10-17  add statistics, integrity check and caller tags
+ * - 1.02 26-10-17  add am_memheap_alloc_align()
+ * - 1.01 26-10-17  add TLSF backend
  * - 1.00 16-10-27  tee, copy from amorks
  * \endinternal
  */
@@ -35,6 +44,60 @@ extern "C" {
  * @{
  */
 
+/**
+ * \brief Ƿ֧ TLSF 㷨
+ *
+ * Ϊ 1 ʱʹ am_memheap_tlsf_init() ʼѣϵͳҲʹ TLSF 㷨
+ * ̵Ԥжúꡣ
+ */
+#ifndef AM_MEMHEAP_TLSF_ENABLE
+#define AM_MEMHEAP_TLSF_ENABLE        0
+#endif
+
+/**
+ * \brief TLSF 㷨ÿһּжּĿλ1 ~ 5
+ *
+ * ּĿΪ 2^AM_MEMHEAP_TLSF_SL_BITSԽּԽϸڲƬԽ٣
+ * ƿռõĿռԽ󡣿ƿλڶѿռʼԼռ
+ * (4 + 4 * 2^AM_MEMHEAP_TLSF_SL_BITS) * һּ ֽڣһּԼΪ
+ * log2(ѴС) - AM_MEMHEAP_TLSF_SL_BITS - 1 8KB ĶĬԼռ 340 ֽڡ
+ */
+#ifndef AM_MEMHEAP_TLSF_SL_BITS
+#define AM_MEMHEAP_TLSF_SL_BITS       3
+#endif
+
+/**
+ * \brief Ƿ¼ÿڴĵ߱
+ *
+ * Ϊ 1 ʱÿڴͷ 4 ֽڣʱԶ¼ߵķصַʹ
+ * am_memheap_tag_set() ΪԶıǣͨ am_memheap_foreach() ͳ
+ * ڴʹûй©ڹ̵Ԥжúꡣ
+ */
+#ifndef AM_MEMHEAP_TAG_ENABLE
+#define AM_MEMHEAP_TAG_ENABLE         0
+#endif
+
+/**
+ * \brief ǰķصַΪ *_tagged() ӿڵĵ߱
+ *
+ * װӿڵĺ am_mem_alloc()ӦԴΪǵ *_tagged() ӿڣ
+ * ¼ĲǷװĵߣǷװδʹ
+ * AM_MEMHEAP_TAG_ENABLE ʱΪ 0
+ *
+ * __return_address()  ARMCC 5__CC_ARM֧֣ARMCC 6armclang
+ * __CC_ARM  __GNUC__ʹ __builtin_return_address()
+ */
+#if (AM_MEMHEAP_TAG_ENABLE == 1) && defined(__CC_ARM)
+#define AM_MEMHEAP_CALLER()           ((uint32_t)__return_address())
+#elif (AM_MEMHEAP_TAG_ENABLE == 1) && defined(__GNUC__)
+#define AM_MEMHEAP_CALLER()           ((uint32_t)__builtin_return_address(0))
+#else
+#define AM_MEMHEAP_CALLER()           0
+#endif
+
+/** \brief TLSF ƿ飨ڲʹã */
+struct am_memheap_tlsf;
+
 /**
  * \brief memory item on the memory heap
  */
@@ -48,6 +111,10 @@ typedef struct am_memheap_item
 
     struct am_memheap_item *next_free;       /**< next free memheap item   */
     struct am_memheap_item *prev_free;       /**< prev free memheap item   */
+
+#if (AM_MEMHEAP_TAG_ENABLE == 1)
+    uint32_t                tag;             /**< caller tag               */
+#endif
 } am_memheap_item_t;
 
 /**
@@ -66,9 +133,43 @@ typedef struct am_memheap
 
     struct am_memheap_item *free_list;          /**< free block list */
     struct am_memheap_item  free_header;        /**< free block list header */
- 
+
+    struct am_memheap_tlsf *tlsf;               /**< TLSF control, NULL for first-fit */
+
 } am_memheap_t;
 
+/**
+ * \brief ѵͳϢ
+ */
+typedef struct am_memheap_info {
+    uint32_t  total_size;     /**< \brief ѵܴСֽ               */
+    uint32_t  used_size;      /**< \brief ѷĴСͷ             */
+    uint32_t  free_size;      /**< \brief еĴСͷ             */
+    uint32_t  max_used_size;  /**< \brief ѷСֵ                 */
+    uint32_t  largest_free;   /**< \brief пĴСһη */
+    uint32_t  used_blocks;    /**< \brief ѷڴ                 */
+    uint32_t  free_blocks;    /**< \brief п                         */
+    uint32_t  frag;           /**< \brief Ƭʣ%
+                                           100 - largest_free * 100 / free_size */
+} am_memheap_info_t;
+
+/**
+ * \brief ڴĻص
+ *
+ * \param[in] p_arg : û
+ * \param[in] ptr   : ڴ׵ַͷ
+ * \param[in] size  : ڴĴС
+ * \param[in] used  : Ƿѷ
+ * \param[in] tag   : ߱ǣδʹ AM_MEMHEAP_TAG_ENABLE ʱΪ 0
+ *
+ * \return  AM_OK ֵ
+ */
+typedef int (*am_memheap_walk_cb_t) (void      *p_arg,
+                                     void      *ptr,
+                                     uint32_t   size,
+                                     am_bool_t  used,
+                                     uint32_t   tag);
+
 /**
  * \brief ʼһѹ
  *
@@ -84,6 +185,31 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
                          const char        *name,
                          void              *start_addr,
                          uint32_t           size);
+
+#if (AM_MEMHEAP_TLSF_ENABLE == 1)
+
+/**
+ * \brief ʼһʹ TLSF 㷨Ķѹ
+ *
+ * ʼ⣬öѵʹ÷ am_memheap_init() ʼĶȫͬʱ
+ * СȡڵĶּ˿Զռÿռ䣻䡢ͷšС
+ * ĺʱȷޣ am_memheap_realloc() Ҫƶݵ
+ *
+ * \param[in] memheap    ָʼĶѹ
+ * \param[in] name       : ѹ
+ * \param[in] start_addr : öѹڴռʼַ
+ * \param[in] size       : öѹڴռĴСֽʼ
+ *                         һ TLSF ƿ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : ռ̫С
+ */
+am_err_t am_memheap_tlsf_init(struct am_memheap *memheap,
+                              const char        *name,
+                              void              *start_addr,
+                              uint32_t           size);
+
+#endif /* (AM_MEMHEAP_TLSF_ENABLE == 1) */
  
 /**
  * \brief Ӷзռ
@@ -95,6 +221,29 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
  */
 void *am_memheap_alloc(struct am_memheap *heap, uint32_t size);
 
+/**
+ * \brief Ӷзָ뷽ʽĿռ
+ *
+ * ڿпа߽з֣ǰĿռΪп飬ҪⱣԭʼ
+ * ַռΪͷ + sizeָСȡзֺʣ಻һС
+ * ͷ + 12 ֽڣβԹÿУԭȾ am_memheap_alloc() 
+ * ʽÿζռ align + һָĿռ䡣Ŀռֱʹ
+ * am_memheap_free() ͷţʹ am_memheap_realloc() Сʱܲٱֶ롣
+ * ռõĲ tools/host_bench/memheap_align_footprint.c
+ *
+ * \param[in] heap   ָѹ
+ * \param[in] size   : ռĴС
+ * \param[in] align  : ֽΪ 2 ݣָСʱ
+ *                     am_memheap_alloc() ͬ
+ *
+ * \return ռ׵ַNULLʧ
+ *
+ * \note ʱҪ size + align + ͷС + 8 ֽڵпռ
+ */
+void *am_memheap_alloc_align(struct am_memheap *heap,
+                             uint32_t           size,
+                             uint32_t           align);
+
 /**
  * \brief ȡռĴС
  *
@@ -121,6 +270,29 @@ size_t am_memheap_memsize(struct am_memheap *heap, void *ptr);
  */
 void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize);
 
+/**
+ * \name ָ߱ǵķӿ
+ *
+ *  am_memheap_alloc()am_memheap_alloc_align()am_memheap_realloc() ͬ
+ *  tag Ϊڴĵ߱ǣװӿڵĺ
+ * AM_MEMHEAP_CALLER()δʹ AM_MEMHEAP_TAG_ENABLE ʱ tag
+ * @{
+ */
+void *am_memheap_alloc_tagged(struct am_memheap *heap,
+                              uint32_t           size,
+                              uint32_t           tag);
+
+void *am_memheap_alloc_align_tagged(struct am_memheap *heap,
+                                    uint32_t           size,
+                                    uint32_t           align,
+                                    uint32_t           tag);
+
+void *am_memheap_realloc_tagged(struct am_memheap *heap,
+                                void              *ptr,
+                                size_t             newsize,
+                                uint32_t           tag);
+/** @} */
+
 /**
  * \brief ͷŶ̬Ķڴ
  * \param[in] ptr : Ŀռ׵ַ
@@ -128,6 +300,78 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize);
  */
 void am_memheap_free(void *ptr);
 
+/**
+ * \brief ȡѵͳϢ
+ *
+ * һڴʱڴȣѭԵá
+ *
+ * \param[in]  heap   ָѹ
+ * \param[out] p_info : ͳϢ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EFAULT : ڴ𻵣ͳϢ
+ *
+ * \note 䡢ͷŲɲ
+ */
+am_err_t am_memheap_info_get(struct am_memheap *heap, am_memheap_info_t *p_info);
+
+/**
+ * \brief ѵ
+ *
+ * ÿڴͷħĶѡǰӣڵĿпǷѺϲԼ
+ * пռǷ available_size һ£ڷԽдȵµĶ𻵡
+ *
+ * \param[in] heap ָѹ
+ *
+ * \retval  AM_OK     : 
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EFAULT : 
+ *
+ * \note 䡢ͷŲɲ
+ */
+am_err_t am_memheap_check(struct am_memheap *heap);
+
+/**
+ * \brief еڴ飨ַ˳
+ *
+ * \param[in] heap   ָѹ
+ * \param[in] pfn_cb : صصвɷͷڴ
+ * \param[in] p_arg  : صû
+ *
+ * \retval  AM_OK     : ɻصҪ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EFAULT : ڴ
+ */
+am_err_t am_memheap_foreach(struct am_memheap    *heap,
+                            am_memheap_walk_cb_t  pfn_cb,
+                            void                 *p_arg);
+
+#if (AM_MEMHEAP_TAG_ENABLE == 1)
+
+/**
+ * \brief ڴĵ߱
+ *
+ * ĬϱΪʱߵķصַڷΪģŵԶֵ
+ *
+ * \param[in] ptr : Ŀռ׵ַ
+ * \param[in] tag : 
+ *
+ * \return 
+ */
+void am_memheap_tag_set(void *ptr, uint32_t tag);
+
+/**
+ * \brief ȡڴĵ߱
+ *
+ * \param[in] ptr : Ŀռ׵ַ
+ *
+ * \return 
+ */
+uint32_t am_memheap_tag_get(void *ptr);
+
+#endif /* (AM_MEMHEAP_TAG_ENABLE == 1) */
+
 /** @}  am_if_memheap */
 
 #ifdef __cplusplus
@@ -0,0 +1,207 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ڴ
+ *
+ * ڴɴСͬڴɣڴ䡢Ϣ¼¼ȴС̶
+ *  am_memheap ȣڴûжͷͷŵĺʱ̶
+ * ҿжеá
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_mempool.h"
+ * \endcode
+ *
+ * \par ʾ
+ * \code
+ *  // һڴأ 8  my_msg_t Сڴ
+ *  AM_MEMPOOL_DEFINE(__g_msg_pool, sizeof(my_msg_t), 8);
+ *
+ *  my_msg_t *p_msg = am_mempool_alloc(&__g_msg_pool);
+ *  if (p_msg != NULL) {
+ *      //  use p_msg
+ *      am_mempool_free(&__g_msg_pool, p_msg);
+ *  }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  document -AM_EINVAL for a repeated free.
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_MEMPOOL_H
+#define __AM_MEMPOOL_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_mempool
+ * \copydoc am_mempool.h
+ * @{
+ */
+
+/**
+ * \brief 
+ *
+ * Ϊ 1 ʱڴͷź 0xDD 䣬ʱǷ񱻸дͷźԱ
+ * д룩 0xCD 䣨ڷʹδʼݣͬʱ
+ * AM_DEBUG ʹ am_assert()ڹ̵Ԥжúꡣ
+ */
+#ifndef AM_MEMPOOL_POISON_ENABLE
+#define AM_MEMPOOL_POISON_ENABLE    0
+#endif
+
+/**
+ * \brief ڴʵռõĴСָС룬ٿԴһָ
+ */
+#define AM_MEMPOOL_BLK_SIZE(size) \
+    (((size) < sizeof(void *)) ? sizeof(void *) : AM_ROUND_UP(size, sizeof(void *)))
+
+/**
+ * \brief ڴعṹ
+ */
+struct am_mempool {
+    void      *p_free;      /**< \brief ͷŵڴ               */
+    char      *p_next;      /**< \brief һδڴ         */
+    char      *p_start;     /**< \brief ڴʼַ                   */
+    char      *p_end;       /**< \brief ڴؽַ                   */
+    size_t     blk_size;    /**< \brief ڴС                       */
+    uint32_t   blk_num;     /**< \brief ڴ                       */
+    uint32_t   used;        /**< \brief ѷڴ               */
+    uint32_t   used_max;    /**< \brief ѷڴֵ         */
+    uint32_t   fail;        /**< \brief ڴľʧܵĴ     */
+};
+
+/** \brief ڴ */
+typedef struct am_mempool *am_mempool_t;
+
+/**
+ * \brief һ̬ڴأ洢ռ䣩ʼʹ
+ *
+ * \param[in] pool     : ڴƣڴΪ static struct am_mempool pool
+ * \param[in] blk_size : ڴС
+ * \param[in] blk_num  : ڴΪ 0
+ *
+ * \hideinitializer
+ */
+#define AM_MEMPOOL_DEFINE(pool, blk_size, blk_num)                             \
+    static void *pool##_mem[AM_MEMPOOL_BLK_SIZE(blk_size) /                    \
+                            sizeof(void *) * (blk_num)];                       \
+    static struct am_mempool pool = {                                          \
+        NULL,                                                                  \
+        (char *)pool##_mem,                                                    \
+        (char *)pool##_mem,                                                    \
+        (char *)pool##_mem + sizeof(pool##_mem),                               \
+        AM_MEMPOOL_BLK_SIZE(blk_size),                                         \
+        (blk_num),                                                             \
+        0,                                                                     \
+        0,                                                                     \
+        0                                                                      \
+    }
+
+/**
+ * \brief ʼڴ
+ *
+ * \param[in] p_pool   : Ҫʼڴ
+ * \param[in] p_buf    : ڴش洢ռ䣬谴ָС
+ * \param[in] size     : 洢ռСֽڣ
+ * \param[in] blk_size : ڴСʵռ AM_MEMPOOL_BLK_SIZE(blk_size) ֽ
+ *
+ * \retval  AM_OK     : ʼ
+ * \retval -AM_EINVAL : ʼʧܣЧ洢ռ䲻һڴ
+ */
+int am_mempool_init (struct am_mempool *p_pool,
+                     void              *p_buf,
+                     size_t             size,
+                     size_t             blk_size);
+
+/**
+ * \brief һڴ
+ *
+ * \param[in] pool : ڴ
+ *
+ * \return ڴ׵ַNULL ڴѺľ
+ *
+ * \note же
+ */
+void *am_mempool_alloc (am_mempool_t pool);
+
+/**
+ * \brief ͷڴ
+ *
+ * \param[in] pool  : ڴ
+ * \param[in] p_blk :  am_mempool_alloc() ڴ
+ *
+ * \retval  AM_OK     : ͷųɹ
+ * \retval -AM_EINVAL : ڴ鲻ڸڴأڴûѷڴ
+ *                      ظͷţ
+ *
+ * \note жеáΪ֤ͷŵĺʱ̶ҿڴ
+ *       δͷʱظͷ޷
+ */
+int am_mempool_free (am_mempool_t pool, void *p_blk);
+
+/**
+ * \brief ȡڴ
+ *
+ * \param[in] pool : ڴ
+ *
+ * \return ڴ
+ */
+uint32_t am_mempool_blk_num_get (am_mempool_t pool);
+
+/**
+ * \brief ȡѷڴ
+ *
+ * \param[in] pool : ڴ
+ *
+ * \return ѷڴ
+ */
+uint32_t am_mempool_used_get (am_mempool_t pool);
+
+/**
+ * \brief ȡѷڴֵˮλڴǷ
+ *
+ * \param[in] pool : ڴ
+ *
+ * \return ѷڴֵ
+ */
+uint32_t am_mempool_high_water_get (am_mempool_t pool);
+
+/**
+ * \brief ȡڴľʧܵĴ
+ *
+ * \param[in] pool : ڴ
+ *
+ * \return ʧܵĴ
+ */
+uint32_t am_mempool_fail_get (am_mempool_t pool);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_MEMPOOL_H */
+
+/* end of file */
@@ -0,0 +1,211 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief Ϣ
+ *
+ * ÿԪأϢĴС̶жѭ֮䴫ݰ¼
+ * ֵADC תȽṹݣ⾭λֽڴȡ½
+ *
+ * н֧һд뷽һȡд뷽ΪжϣȡΪѭд뷽
+ * ֻ޸дλãȡֻ޸Ķȡλã˶дرжϡжд뷽
+ * ȡʹл⡣
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_msgq.h"
+ * \endcode
+ *
+ * \par ʾ:ڲصл沶ֵ
+ * \code
+ *  static uint32_t       __g_cap_buf[16];
+ *  static struct am_msgq __g_cap_msgq;
+ *
+ *  static void __cap_callback (void *p_arg, unsigned int count)
+ *  {
+ *      am_msgq_push(&__g_cap_msgq, &count);   // жд룬ʱ
+ *  }
+ *
+ *  am_msgq_init(&__g_cap_msgq, __g_cap_buf, sizeof(uint32_t), 16);
+ *
+ *  while (1) {
+ *      uint32_t count[4];
+ *      size_t   n = am_msgq_pop_batch(&__g_cap_msgq, count, 4);
+ *      //  process count[0] ~ count[n - 1]
+ *  }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_MSGQ_H
+#define __AM_MSGQ_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_msgq
+ * \copydoc am_msgq.h
+ * @{
+ */
+
+/**
+ * \brief Ϣйṹ
+ *
+ * дλõķΧΪ 0 ~ 2 * elem_num - 1 elem_num ʱʱ
+ * пգȫ elem_num Ԫؿռʹá
+ */
+struct am_msgq {
+    char              *p_buf;       /**< \brief Ԫش洢ռ               */
+    size_t             elem_size;   /**< \brief ԪشСֽڣ           */
+    uint32_t           elem_num;    /**< \brief Ԫظ       */
+    volatile uint32_t  in;          /**< \brief дλãд뷽޸     */
+    volatile uint32_t  out;         /**< \brief ȡλãȡ޸     */
+    uint32_t           overflow;    /**< \brief Ԫظ     */
+    uint32_t           high_water;  /**< \brief Ԫظֵ     */
+};
+
+/** \brief Ϣ */
+typedef struct am_msgq *am_msgq_t;
+
+/**
+ * \brief ʼϢ
+ *
+ * \param[in] p_mq      : ҪʼϢ
+ * \param[in] p_buf     : Ԫش洢ռ䣬СΪ elem_size * elem_num ֽ
+ * \param[in] elem_size : ԪشСֽڣ
+ * \param[in] elem_num  : Ԫظ
+ *
+ * \retval  AM_OK     : ʼ
+ * \retval -AM_EINVAL : ʼʧܣЧ
+ */
+int am_msgq_init (struct am_msgq *p_mq,
+                  void           *p_buf,
+                  size_t          elem_size,
+                  size_t          elem_num);
+
+/**
+ * \brief дһԪ
+ *
+ * \param[in] mq     : ҪϢ
+ * \param[in] p_elem : ҪдԪأСΪ elem_size
+ *
+ * \retval  AM_OK      : дɹ
+ * \retval -AM_ENOSPC  : Ԫر 1
+ *
+ * \note ֻд뷽
+ */
+int am_msgq_push (am_msgq_t mq, const void *p_elem);
+
+/**
+ * \brief ȡһԪ
+ *
+ * \param[in]  mq     : ҪϢ
+ * \param[out] p_elem : ȡԪأСΪ elem_size
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EAGAIN : Ϊ
+ *
+ * \note ֻڶȡ
+ */
+int am_msgq_pop (am_msgq_t mq, void *p_elem);
+
+/**
+ * \brief ȡԪ
+ *
+ * \param[in]  mq       : ҪϢ
+ * \param[out] p_elems  : ŶȡԪأСΪ elem_size * max_elem
+ * \param[in]  max_elem : ȡԪظ
+ *
+ * \return ʵʶȡԪظ
+ *
+ * \note ֻڶȡ
+ */
+size_t am_msgq_pop_batch (am_msgq_t mq, void *p_elems, size_t max_elem);
+
+/**
+ * \brief ϢУδȡԪأ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \return 
+ *
+ * \note ֻڶȡ
+ */
+void am_msgq_flush (am_msgq_t mq);
+
+/**
+ * \brief ȡϢеԪظ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \return Ԫظ
+ */
+size_t am_msgq_count (am_msgq_t mq);
+
+/**
+ * \brief ϢǷΪ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \retval AM_TRUE  : 
+ * \retval AM_FALSE : ǿ
+ */
+am_bool_t am_msgq_isempty (am_msgq_t mq);
+
+/**
+ * \brief ϢǷ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \retval AM_TRUE  : 
+ * \retval AM_FALSE : δ
+ */
+am_bool_t am_msgq_isfull (am_msgq_t mq);
+
+/**
+ * \brief ȡԪظ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \return Ԫظ
+ */
+uint32_t am_msgq_overflow_get (am_msgq_t mq);
+
+/**
+ * \brief ȡԪظֵˮλǷ
+ *
+ * \param[in] mq : ҪϢ
+ *
+ * \return Ԫظֵ
+ */
+size_t am_msgq_high_water_get (am_msgq_t mq);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_MSGQ_H */
+
+/* end of file */
@@ -0,0 +1,282 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ⷢ/ķ
+ *
+ * ߴĻݻݣһδ󷢲
+ * ָÿߵĶУݡü
+ * ÿߴͷţȫͷź󻺳Զ黹أ
+ * ߺʱɡ
+ *
+ *  am_event ȣ
+ * - ԼУѭЭ̡жӳҵӶжȡݣ
+ *   ߲ȴߴ
+ * - ÿжĶȣĶֻʧԼݣ
+ * - ĶڳʼʱԾ̬ʱ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_pubsub.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  typedef struct { int16_t temp; uint16_t humi; } sample_t;
+ *
+ *  // ߣʾ 2־ 8
+ *  static void            *__g_disp_q[2], *__g_log_q[8];
+ *  static am_pubsub_sub_t  __g_disp, __g_log;
+ *  static am_pubsub_sub_t *const __g_env_subs[] = {&__g_disp, &__g_log};
+ *
+ *  // ⣺4 ݻ
+ *  static uint32_t           __g_env_pool[AM_PUBSUB_POOL_SIZE(sizeof(sample_t), 4) / 4];
+ *  static am_pubsub_topic_t  __g_env;
+ *
+ *  am_pubsub_sub_init(&__g_disp, __g_disp_q, 2, NULL, NULL);
+ *  am_pubsub_sub_init(&__g_log,  __g_log_q,  8, NULL, NULL);
+ *  am_pubsub_topic_init(&__g_env, "env", sizeof(sample_t),
+ *                       __g_env_pool, sizeof(__g_env_pool),
+ *                       __g_env_subs, AM_NELEMENTS(__g_env_subs));
+ *
+ *  // 
+ *  sample_t *p = am_pubsub_buf_alloc(&__g_env);
+ *  if (p != NULL) {
+ *      p->temp = 2500;
+ *      p->humi = 4000;
+ *      am_pubsub_publish(&__g_env, p);
+ *  }
+ *
+ *  // 
+ *  sample_t *p_sample;
+ *  while ((p_sample = am_pubsub_receive(&__g_log)) != NULL) {
+ *      //  log p_sample
+ *      am_pubsub_release(p_sample);
+ *  }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_PUBSUB_H
+#define __AM_PUBSUB_H
+
+#include "am_common.h"
+#include "am_mempool.h"
+#include "am_msgq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_pubsub
+ * \copydoc am_pubsub.h
+ * @{
+ */
+
+/**
+ * \brief ݻͷĴСڲʹãΪ 8 ı
+ */
+#define AM_PUBSUB_BUF_HDR_SIZE    AM_ROUND_UP(sizeof(void *) + sizeof(uint32_t), 8)
+
+/**
+ * \brief ⻺洢ռĴСֽڣ
+ *
+ * \param[in] payload_size : ݴСֽڣ
+ * \param[in] buf_num      : 
+ *
+ * \hideinitializer
+ */
+#define AM_PUBSUB_POOL_SIZE(payload_size, buf_num)                             \
+    (AM_MEMPOOL_BLK_SIZE(AM_ROUND_UP((payload_size), 8) +                      \
+                         AM_PUBSUB_BUF_HDR_SIZE) * (buf_num))
+
+/**
+ * \brief յʱ֪ͨ
+ *
+ *  am_pubsub_publish() еãܴжУͨڻѶߣ
+ * am_isr_defer_job_add()am_coro_wake()
+ *
+ * \param[in] p_arg : û
+ */
+typedef void (*am_pubsub_notify_t) (void *p_arg);
+
+/**
+ * \brief 
+ */
+typedef struct am_pubsub_sub {
+    struct am_msgq      queue;      /**< \brief յݻָ룩  */
+    am_pubsub_notify_t  pfn_notify; /**< \brief յʱ֪ͨ      */
+    void               *p_arg;      /**< \brief ֪ͨû        */
+} am_pubsub_sub_t;
+
+/**
+ * \brief 
+ */
+typedef struct am_pubsub_topic {
+    const char             *p_name;      /**< \brief                  */
+    struct am_mempool       pool;        /**< \brief ݻ           */
+    size_t                  payload_size;/**< \brief ݴС               */
+    am_pubsub_sub_t *const *pp_subs;     /**< \brief ߱               */
+    size_t                  sub_num;     /**< \brief ߸             */
+    uint32_t                seq;         /**< \brief ѷݸ       */
+    struct am_pubsub_topic *p_next;      /**< \brief һ⣨ڲʹã */
+} am_pubsub_topic_t;
+
+/**
+ * \brief ʼ
+ *
+ * \param[in] p_sub      : 
+ * \param[in] p_queue    : д洢ռ䣬ɴ depth ָ
+ * \param[in] depth      : ȣʱ·ݶԸö߶ʧ
+ * \param[in] pfn_notify : յʱ֪ͨҪʱΪ NULL
+ * \param[in] p_arg      : ֪ͨû
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ *
+ * \note ڶ߼ʼ֮ǰʼ
+ */
+int am_pubsub_sub_init (am_pubsub_sub_t    *p_sub,
+                        void              **p_queue,
+                        size_t              depth,
+                        am_pubsub_notify_t  pfn_notify,
+                        void               *p_arg);
+
+/**
+ * \brief ʼ⣬бʹ am_pubsub_topic_find() ң
+ *
+ * \param[in] p_topic      : 
+ * \param[in] p_name       : 
+ * \param[in] payload_size : ݴСֽڣ
+ * \param[in] p_pool       : ش洢ռ䣬ָС룬 8 ֽڶʱ
+ *                           ݻҲ 8 ֽڶ
+ * \param[in] pool_size    : ش洢ռС AM_PUBSUB_POOL_SIZE()
+ * \param[in] pp_subs      : ߱һֱЧ
+ * \param[in] sub_num      : ߸
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч洢ռ䲻һ
+ */
+int am_pubsub_topic_init (am_pubsub_topic_t       *p_topic,
+                          const char              *p_name,
+                          size_t                   payload_size,
+                          void                    *p_pool,
+                          size_t                   pool_size,
+                          am_pubsub_sub_t *const  *pp_subs,
+                          size_t                   sub_num);
+
+/**
+ * \brief 
+ *
+ * \param[in] p_name : 
+ *
+ * \return ⣬NULL ʾδҵ
+ */
+am_pubsub_topic_t *am_pubsub_topic_find (const char *p_name);
+
+/**
+ * \brief Ļһݻ
+ *
+ * \param[in] p_topic : 
+ *
+ * \return ݻСΪݴСNULL ʾ
+ *
+ * \note же
+ */
+void *am_pubsub_buf_alloc (am_pubsub_topic_t *p_topic);
+
+/**
+ * \brief 
+ *
+ * ݻÿߵĶУ֮󷢲߲ٷʸûûж
+ * գȫʱ黹
+ *
+ * \param[in] p_topic   : 
+ * \param[in] p_payload : am_pubsub_buf_alloc() ݻ
+ *
+ * \return յݵĶ߸ֵΪ루-AM_EINVAL
+ *
+ * \note же
+ */
+int am_pubsub_publish (am_pubsub_topic_t *p_topic, void *p_payload);
+
+/**
+ * \brief ߶ȡһ
+ *
+ * \param[in] p_sub : 
+ *
+ * \return ݻNULL ʾΪա am_pubsub_release()
+ *
+ * \note ÿֻһжȡ
+ */
+void *am_pubsub_receive (am_pubsub_sub_t *p_sub);
+
+/**
+ * \brief ͷݻüһΪ 0 ʱ黹أ
+ *
+ * Ҳڷ߷һ롢δĻ
+ *
+ * \param[in] p_payload : ݻ
+ *
+ * \return 
+ *
+ * \note же
+ */
+void am_pubsub_release (void *p_payload);
+
+/**
+ * \brief ݻü
+ *
+ * ߽ٽģ鴦ʱʹãÿεöҪӦһ
+ * am_pubsub_release()
+ *
+ * \param[in] p_payload : ݻ
+ *
+ * \return 
+ */
+void am_pubsub_ref (void *p_payload);
+
+/**
+ * \brief ȡݻ
+ *
+ * \param[in] p_payload : ݻ
+ *
+ * \return 
+ */
+am_pubsub_topic_t *am_pubsub_topic_get (const void *p_payload);
+
+/**
+ * \brief ȡʧݸ
+ *
+ * \param[in] p_sub : 
+ *
+ * \return ʧݸ
+ */
+uint32_t am_pubsub_sub_lost_get (am_pubsub_sub_t *p_sub);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_PUBSUB_H */
+
+/* end of file */
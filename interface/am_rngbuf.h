@@ -15,6 +15,7 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add the zero-copy span API and AM_RNGBUF_POW2_ENABLE
  * - 1.00 15-12-09  tee, add implementation from AWorks
  * \endinternal
  */
@@ -32,6 +33,16 @@ extern "C" {
  * \copydoc am_rngbuf.h
  * @{
  */
+
+/**
+ * \brief СΪ 2 ģʽ
+ *
+ * Ϊ 1 ʱлλĴСΪ 2 ݣдλõĻʹ㣬
+ * ҪȽϺͷ֧ڹ̵Ԥжúꡣ
+ */
+#ifndef AM_RNGBUF_POW2_ENABLE
+#define AM_RNGBUF_POW2_ENABLE    0
+#endif
  
 /**
  * \brief λṹ
@@ -47,6 +58,14 @@ struct am_rngbuf {
 /** \brief λ */
 typedef struct am_rngbuf *am_rngbuf_t;
 
+/**
+ * \brief λеһ
+ */
+typedef struct am_rngbuf_span {
+    char   *p_buf;  /**< \brief ʼַ */
+    size_t  len;    /**< \brief 򳤶ȣΪ 0 ʱЧ */
+} am_rngbuf_span_t;
+
 /**
  * \brief ʼλ
  *
@@ -56,7 +75,8 @@ typedef struct am_rngbuf *am_rngbuf_t;
  *                      ʵʻλôСΪ size - 1
  *                    
  * \retval  AM_OK     : ʼ
- * \retval -AM_EINVAL : ʼʧܣЧ
+ * \retval -AM_EINVAL : ʼʧܣЧAM_RNGBUF_POW2_ENABLE Ϊ 1 ʱ
+ *                      size Ϊ 2 ݣ
  *
  * \warning رע⣬ռʹбһֽڿռ䣬λʵʿôСΪ
  *          \b size - \b 1
@@ -107,6 +127,64 @@ size_t am_rngbuf_put (am_rngbuf_t rb, const char *p_buf, size_t nbytes);
  */
 size_t am_rngbuf_get (am_rngbuf_t rb, char *p_buf, size_t nbytes);
 
+/**
+ * \brief Ԥд㿽д룩
+ *
+ * ȡ nbytes ֽڵֱд루 DMA д룩Щ
+ * ٵ am_rngbuf_write_commit() ύпռڻĩβʱΪ
+ * Ϊ span[0]span[1]
+ *
+ * \param[in]  rb     : ҪĻλ
+ * \param[in]  nbytes : ֽ
+ * \param[out] span   : ȡ򣬳Ϊ 0 ʾЧ
+ *
+ * \return Ԥֽspan[0].len + span[1].len
+ *
+ * \note Ԥı仺״̬ am_rngbuf_put() һֻд뷽
+ */
+size_t am_rngbuf_write_reserve (am_rngbuf_t       rb,
+                                size_t            nbytes,
+                                am_rngbuf_span_t  span[2]);
+
+/**
+ * \brief ύдԤ
+ *
+ * \param[in] rb     : ҪĻλ
+ * \param[in] nbytes : ύֽܳ am_rngbuf_write_reserve() ķֵ
+ *
+ * \return 
+ */
+void am_rngbuf_write_commit (am_rngbuf_t rb, size_t nbytes);
+
+/**
+ * \brief 鿴ɶȡ㿽ȡ
+ *
+ * ȡ nbytes ֽڵֱӴ DMA ͣЩ
+ * еݺٵ am_rngbuf_read_release() ͷšڻĩβʱ
+ * ΪΪ span[0]span[1]
+ *
+ * \param[in]  rb     : ҪĻλ
+ * \param[in]  nbytes : ֽ
+ * \param[out] span   : ȡ򣬳Ϊ 0 ʾЧ
+ *
+ * \return ɶȡֽspan[0].len + span[1].len
+ *
+ * \note 鿴ı仺״̬ am_rngbuf_get() һֻڶȡ
+ */
+size_t am_rngbuf_read_peek (am_rngbuf_t       rb,
+                            size_t            nbytes,
+                            am_rngbuf_span_t  span[2]);
+
+/**
+ * \brief ͷѴ
+ *
+ * \param[in] rb     : ҪĻλ
+ * \param[in] nbytes : ͷŵֽܳ am_rngbuf_read_peek() ķֵ
+ *
+ * \return 
+ */
+void am_rngbuf_read_release (am_rngbuf_t rb, size_t nbytes);
+
 /**
  * \brief ջλ
  *
@@ -18,6 +18,8 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.02 26-10-17  am_softimer_defer_set() may return -AM_EBUSY.
+ * - 1.01 26-10-17  next_ticks_get() looks past the wheel root level.
  * - 1.00 15-07-31  tee,  first implementation.
  * \endinternal
  */
@@ -32,6 +34,7 @@ extern "C" {
 #include "am_common.h"
 #include "am_list.h"
 #include "am_timer.h"
+#include "am_isr_defer.h"
 
 
 /**
@@ -40,15 +43,67 @@ extern "C" {
  * @{
  */
 
+/**
+ * \brief ʱʽѡ
+ *
+ * - 0 : ֵĬϣRAM ռ٣ʱʱ
+ *       ʱжʱ䣩еĶʱĿȣ
+ * - 1 : ֲʱֹ֡ͣΪ O(1)ڴ̯ O(1)Ҫ
+ *       Ĳλͷ AM_SOFTIMER_WHEEL_ROOT_BITS ã
+ *
+ * ַʽӿȫһ£ڹ̵Ԥжúѡʵַʽ
+ */
+#ifndef AM_SOFTIMER_WHEEL_ENABLE
+#define AM_SOFTIMER_WHEEL_ENABLE      0
+#endif
+
+/**
+ * \brief ʱֵ 0 㣨㣩λλλΪ 2^AM_SOFTIMER_WHEEL_ROOT_BITS
+ */
+#ifndef AM_SOFTIMER_WHEEL_ROOT_BITS
+#define AM_SOFTIMER_WHEEL_ROOT_BITS   5
+#endif
+
+/**
+ * \brief ʱϲÿλλλΪ 2^AM_SOFTIMER_WHEEL_LVL_BITS
+ */
+#ifndef AM_SOFTIMER_WHEEL_LVL_BITS
+#define AM_SOFTIMER_WHEEL_LVL_BITS    4
+#endif
+
+/**
+ * \brief ʱϲĲ
+ *
+ * ʱֱֿӸǵĶʱΧΪ
+ * 2^(AM_SOFTIMER_WHEEL_ROOT_BITS + AM_SOFTIMER_WHEEL_LVL_BITS * AM_SOFTIMER_WHEEL_LVL_NUM)
+ *  tickĬΪ 2^21  tick1KHz ʱԼ 35 ӣ÷ΧĶʱ
+ * ȷ߲һλʱ¼㣬ȷڡ
+ *
+ * Ĭ¹ 32 + 16 * 4 = 96 ͷ
+ */
+#ifndef AM_SOFTIMER_WHEEL_LVL_NUM
+#define AM_SOFTIMER_WHEEL_LVL_NUM     4
+#endif
+
+/**
+ * \brief am_softimer_module_next_ticks_get() ķֵʾûеĶʱ
+ */
+#define AM_SOFTIMER_TICKS_INFINITE    0xFFFFFFFFu
+
 /**
  * \brief ʱṹ壬˱ҪϢ
  */
 struct am_softimer {
     struct am_list_head node;          /**< \brief γṹ           */
-    unsigned int        ticks;         /**< \brief ʣʱtickֵ             */
+
+    /**
+     * \brief ֵʽΪʣʱtickֵʱַʽΪʱ̵tickֵ
+     */
+    unsigned int        ticks;
     unsigned int        repeat_ticks;  /**< \brief ظʱtick     */
     void (*timeout_callback)( void *); /**< \brief ʱʱ䵽ص         */
     void               *p_arg;         /**< \brief صĲ             */
+    am_isr_defer_job_t *p_job;         /**< \brief ǿʱжӳлص     */
 };
 
 typedef struct am_softimer am_softimer_t;
@@ -67,6 +122,50 @@ int am_softimer_module_init (unsigned int clkrate);
  * \brief ʱ밴ճʼʱģʱָƵʵøú
  */
 void am_softimer_module_tick (void);
+
+/**
+ * \brief һƽģ޽ģticklessģʽ
+ *
+ * Ч ticks  am_softimer_module_tick() ͬڵĶʱ
+ * ڵȺ˳δ
+ *
+ * \param[in] ticks : ƽĽ
+ *
+ * \return 
+ */
+void am_softimer_module_announce (unsigned int ticks);
+
+/**
+ * \brief ȡһҪʱжٸ
+ *
+ * ޽ģʽ£ӲʱֻڷصĽ֮жϣڼ
+ * am_softimer_module_tick()
+ *
+ * \return С 1ûеĶʱʱ
+ *         #AM_SOFTIMER_TICKS_INFINITE
+ *
+ * \note ʱַʽ£֮Ķʱֻܾȷڲλʱֵ̣
+ *       СʵʵڵĽ
+ */
+unsigned int am_softimer_module_next_ticks_get (void);
+
+/**
+ * \brief ޽ģticklessģʽʹõĻص
+ *
+ * \param[in] pfn_elapsed_get : ȡӲʱѾ߹δͨ
+ *                              am_softimer_module_announce() ƽĽ
+ *                              ʱʱὫֵ붨ʱʱ
+ * \param[in] pfn_update      : һʱãԱ㰴ǰһӲ
+ *                              ʱжϵʱ
+ * \param[in] p_arg           : صĲ
+ *
+ * \return 
+ *
+ * \note صΪ NULLͨɰ弶޽ģ
+ */
+void am_softimer_module_tickless_set (unsigned int (*pfn_elapsed_get) (void *p_arg),
+                                      void         (*pfn_update) (void *p_arg),
+                                      void          *p_arg);
     
 /**
  * \brief ʼһʱ
@@ -82,6 +181,33 @@ void am_softimer_module_tick (void);
 int am_softimer_init(am_softimer_t *p_timer, am_pfnvoid_t p_func, void *p_arg);
 
 
+/**
+ * \brief ʱĻصжӳִ
+ *
+ * Ĭ£ʱʱ䵽Ļصֱ am_softimer_module_tick() УͨΪ
+ * ϵͳδжϣִУصʱϳʱƳжϵӦú󣬶ʱ
+ * ʱ䵽ʱ p_job ӵжӳٶУصڴжӳҵʱִУ
+ * δжϵִʱص޹ء
+ *
+ * \param[in] p_timer : ָһʱָ룬ʹ am_softimer_init()
+ *                      ʼ
+ * \param[in] p_job   : صʹõжӳҵɱģʼΪ NULL ʱ
+ *                      ָΪ am_softimer_module_tick() ֱӻص
+ * \param[in] pri     : жӳҵȼ
+ *
+ * \retval AM_OK      : óɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EBUSY  : p_job ʱǰʹõҵжӳٶлδ
+ *                      䴦󣨻ֹͣʱȴ䴦
+ *
+ * \note һεĻصδִʱʱʱٴεκϲΪһλص
+ *       жӳģδʼʱ am_softimer_module_tick() ֱӻص
+ *       ʱֹͣӵδҵٵûص
+ */
+int am_softimer_defer_set (am_softimer_t      *p_timer,
+                           am_isr_defer_job_t *p_job,
+                           uint16_t            pri);
+
 /**
  * \brief һʱ
  * \param[in] p_timer : ָһʱָ
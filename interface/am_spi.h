@@ -15,6 +15,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.02 26-10-17  add asynchronous write then read.
  * - 1.01 15-08-17  tee, modified some interface. 
  * - 1.00 14-11-01  jon, first implementation.
  * \endinternal
@@ -491,6 +492,52 @@ int am_spi_write_then_write (am_spi_device_t *p_dev,
                              const uint8_t   *p_txbuf1,
                              size_t           n_tx1);
 
+/**
+ * \brief 첽дͬʱе
+ *
+ * 첽ϢʹڲĶڴذ䡣Ϊ 0 ʱṩ첽ӿڡ
+ * ڹ̵Ԥжúꡣ
+ */
+#ifndef AM_SPI_ASYNC_REQ_NUM
+#define AM_SPI_ASYNC_REQ_NUM    0
+#endif
+
+#if (AM_SPI_ASYNC_REQ_NUM > 0)
+
+/**
+ * \brief 첽ɻص
+ *
+ * \param[in] p_arg  : û
+ * \param[in] status : AM_OK ʾɹ
+ */
+typedef void (*am_spi_async_cb_t) (void *p_arg, int status);
+
+/**
+ * \brief 첽дأʱûص
+ *
+ * \param[in]  p_dev   : SPIӻ豸
+ * \param[in]  p_txbuf : ݷͻǰ뱣Ч
+ * \param[in]  n_tx    : Ҫ͵ֽڸ
+ * \param[out] p_rxbuf : ݽջǰ뱣Ч
+ * \param[in]  n_rx    : Ҫյֽڸ
+ * \param[in]  pfn_cb  : ɻصͨжеãΪ NULL
+ * \param[in]  p_arg   : صû
+ *
+ * \retval AM_OK      : 
+ * \retval -AM_EINVAL : 
+ * \retval -AM_ENOMEM : ڽеѴ AM_SPI_ASYNC_REQ_NUM 
+ * \retval        : ʧܣصᱻ
+ */
+int am_spi_write_then_read_async (am_spi_device_t   *p_dev,
+                                  const uint8_t     *p_txbuf,
+                                  size_t             n_tx,
+                                  uint8_t           *p_rxbuf,
+                                  size_t             n_rx,
+                                  am_spi_async_cb_t  pfn_cb,
+                                  void              *p_arg);
+
+#endif /* (AM_SPI_ASYNC_REQ_NUM > 0) */
+
 /** 
  * @} 
  */
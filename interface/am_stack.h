@@ -0,0 +1,124 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ջʹͳ
+ *
+ * ڽ main() ֮ǰ #AM_STACK_PAINT_PATTERN ջж
+ *  MSPջϲҵһдּɵõջﵽ
+ * ˮλջķΧļӽűṩ
+ * - ARMCCļе Stack_Mem  __initial_sp
+ * - GCCӽűе _sstack  _estack
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_stack.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ *  static void __stack_alarm (void *p_arg, size_t used, size_t size)
+ *  {
+ *      am_kprintf("stack %u/%u\r\n", used, size);
+ *  }
+ *
+ *  am_stack_check_start(100, 75, __stack_alarm, NULL);
+ * \endcode
+ *
+ * \note ջǡֵֻͬᱻδʹãͳֵСʵֵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_STACK_H
+#define __AM_STACK_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_stack
+ * \copydoc am_stack.h
+ * @{
+ */
+
+/** \brief ջֵһ */
+#define AM_STACK_PAINT_PATTERN    0xA5A5A5A5ul
+
+/**
+ * \brief ջʹص
+ *
+ * \param[in] p_arg : û
+ * \param[in] used  : ջʹֵֽڣ size ʱջѾ
+ * \param[in] size  : ջСֽڣ
+ *
+ * \return 
+ */
+typedef void (*am_stack_alarm_cb_t) (void *p_arg, size_t used, size_t size);
+
+/**
+ * \brief ȡջС
+ * \return ջСֽڣ
+ */
+size_t am_stack_size_get (void);
+
+/**
+ * \brief ȡջʹֵˮλ
+ *
+ * \return ջʹֵֽڣջСʱջѾ
+ */
+size_t am_stack_high_water_get (void);
+
+/**
+ * \brief ʼԼջʹ
+ *
+ * ÿ period_ms һΣջʹֵﵽջС threshold% 
+ * ÿֵʱһ pfn_alarmصʱжϣִС
+ *
+ * \param[in] period_ms : ڣms
+ * \param[in] threshold : ֵջСİٷֱȣ1 ~ 100
+ * \param[in] pfn_alarm : ص
+ * \param[in] p_arg     : صû
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EPERM  : ʱ
+ */
+int am_stack_check_start (unsigned int         period_ms,
+                          unsigned int         threshold,
+                          am_stack_alarm_cb_t  pfn_alarm,
+                          void                *p_arg);
+
+/**
+ * \brief ֹͣԼջʹ
+ * \return 
+ */
+void am_stack_check_stop (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_STACK_H */
+
+/* end of file */
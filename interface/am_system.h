@@ -68,6 +68,31 @@ int am_system_module_init (unsigned long clkrate);
  */
 int am_system_module_tick (void);
 
+/**
+ * \brief һƽģ޽ģticklessģʽ
+ *
+ * Ч ticks  am_system_module_tick() ͬ
+ *
+ * \param[in] ticks : ƽĽ
+ * \retval AM_OK    : ƽɹ
+ */
+int am_system_module_announce (am_tick_t ticks);
+
+/**
+ * \brief ޽ģticklessģʽ»ȡδƽĺ
+ *
+ * ޽ģʽ£ӲʱܺܳʱŲһжϣøú
+ * am_sys_tick_get() ӲʱѾ߹δͨ
+ * am_system_module_announce() ƽĽֵ֤ȷԡ
+ *
+ * \param[in] pfn_elapsed_get : ȡδƽĺΪ NULL ʱָģʽ
+ * \param[in] p_arg           : Ĳ
+ *
+ * \return 
+ */
+void am_system_module_tickless_set (am_tick_t (*pfn_elapsed_get) (void *p_arg),
+                                    void       *p_arg);
+
 /**
  * \brief ȡϵͳʱӽƵ
  *
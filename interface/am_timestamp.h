@@ -0,0 +1,143 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ߾ʱ׼ӿ
+ *
+ * ʱΪ 64 λĵֵƵӲʱļƵͬ
+ * SYSTICK ΪϵͳʱƵʣɶʱǰֵͷת϶ɣʵӦ
+ * вam_sys_tick_get() ֻнľȣʱڲִʱ䡢
+ * жӳٵȡ
+ *
+ * am_timestamp_get() ȡʱжϣжϺѭеá
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_timestamp.h"
+ * \endcode
+ *
+ * \par ʾ:ִʱ
+ * \code
+ *  am_timestamp_t ts;
+ *
+ *  ts = am_timestamp_get();
+ *  //  do something
+ *  ts = am_timestamp_get() - ts;
+ *  am_kprintf("time=%d us\n", (uint32_t)am_timestamp_to_us(ts));
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_TIMESTAMP_H
+#define __AM_TIMESTAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_common.h"
+#include "am_timer.h"
+
+/**
+ * \addtogroup am_if_timestamp
+ * \copydoc am_timestamp.h
+ * @{
+ */
+
+/** \brief ʱ */
+typedef uint64_t am_timestamp_t;
+
+/**
+ * \brief ʱģʼ
+ *
+ * ʱѰԶطʽ˺ʱÿתһΣÿʱڣ
+ * һ am_timestamp_module_rollover()ͨڸöʱĻصеá
+ *
+ * \param[in] handle      : ʱ׼
+ * \param[in] chan        : ʹõĶʱͨ
+ * \param[in] pfn_pending : ȡʱѷת am_timestamp_module_rollover()
+ *                          δãжϹ𣩵״̬ڹжڼڸ
+ *                          ȼжжȡʱΪ NULL ʱЩ
+ *                          ʱһʱ
+ * \param[in] p_arg       : pfn_pending Ĳ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_ENOTSUP: ʱܶȡǰֵ
+ */
+int am_timestamp_module_init (am_timer_handle_t   handle,
+                              uint8_t             chan,
+                              am_bool_t         (*pfn_pending) (void *p_arg),
+                              void               *p_arg);
+
+/**
+ * \brief ʱתһΣڶʱÿʱڽʱ
+ */
+void am_timestamp_module_rollover (void);
+
+/**
+ * \brief ȡǰʱ
+ *
+ * \return ǰʱģδʼʱ 0
+ */
+am_timestamp_t am_timestamp_get (void);
+
+/**
+ * \brief ȡʱļƵ
+ *
+ * \return ƵʣHzģδʼʱ 0
+ */
+uint32_t am_timestamp_freq_get (void);
+
+/**
+ * \brief ʱʱĲֵתΪ
+ *
+ * \param[in] ts : ʱ
+ *
+ * \return 
+ */
+uint64_t am_timestamp_to_ns (am_timestamp_t ts);
+
+/**
+ * \brief ʱʱĲֵתΪ΢
+ *
+ * \param[in] ts : ʱ
+ *
+ * \return ΢
+ */
+uint64_t am_timestamp_to_us (am_timestamp_t ts);
+
+/**
+ * \brief ΢תΪʱֵ
+ *
+ * \param[in] us : ΢
+ *
+ * \return ʱֵ
+ */
+am_timestamp_t am_timestamp_from_us (uint64_t us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_TIMESTAMP_H */
+
+/* end of file */
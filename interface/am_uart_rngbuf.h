@@ -19,6 +19,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.01 26-10-17  add am_uart_rngbuf_nread_get()
  * - 1.00 14-11-01  tee, first implementation.
  * \endinternal
  */
@@ -218,6 +219,18 @@ int am_uart_rngbuf_receive(am_uart_rngbuf_handle_t  handle,
                            uint8_t                 *p_rxbuf,
                            uint32_t                 nbytes);
 
+/**
+ * \brief ȡջпɶݵĸ
+ *
+ *  AM_UART_RNGBUF_NREAD ָͬڱʽʹãϽմ
+ * жǷ㹻
+ *
+ * \param[in] handle : UARTring bufferжģʽ׼
+ *
+ * \return ɶݵĸ
+ */
+uint32_t am_uart_rngbuf_nread_get(am_uart_rngbuf_handle_t handle);
+
 /**
  * \brief UARTմ
  *
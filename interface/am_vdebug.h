@@ -27,6 +27,10 @@
  *
  * \internal
  * \par modification history:
+ * - 1.04 26-10-17  am_debug_flush() takes a timeout
+ * - 1.03 26-10-17  add leveled per-module log macros
+ * - 1.02 26-10-17  am_vfprintf_do() emits output in chunks
+ * - 1.01 26-10-17  add interrupt-driven buffered output
  * - 1.00 15-01-16  tee, first implementation
  * \endinternal
  */
@@ -49,15 +53,123 @@ extern "C" {
  */
 
 /**
- * \brief AM_VDEBUG, AM_DBG_INFO() 꽫Ϣ
- *        AM_DBG_INFO()ʵΪ
+ * \name ־
+ * @{
+ */
+#define AM_LOG_LEVEL_NONE      0    /**< \brief ־ */
+#define AM_LOG_LEVEL_ERROR     1    /**< \brief        */
+#define AM_LOG_LEVEL_WARN      2    /**< \brief        */
+#define AM_LOG_LEVEL_INFO      3    /**< \brief Ϣ       */
+#define AM_LOG_LEVEL_DEBUG     4    /**< \brief        */
+/** @} */
+
+/**
+ * \name ־ģ飬ʱģ־
+ * @{
+ */
+#define AM_LOG_MOD_APP         0    /**< \brief ӦãĬϣ   */
+#define AM_LOG_MOD_MEMHEAP     1    /**< \brief am_memheap     */
+#define AM_LOG_MOD_FTL         2    /**< \brief am_ftl         */
+#define AM_LOG_MOD_TIME        3    /**< \brief am_time        */
+#define AM_LOG_MOD_DRV         4    /**< \brief        */
+#define AM_LOG_MOD_SOC         5    /**< \brief Ƭ   */
+#define AM_LOG_MOD_USER        8    /**< \brief ûģʼֵ */
+#define AM_LOG_MOD_NUM         16   /**< \brief ģ       */
+/** @} */
+
+/**
+ * \brief ʱȫ־𣬸ڸü־루ʽַ
+ *
+ * Ĭ϶ AM_VDEBUG ʱΪ AM_LOG_LEVEL_DEBUGΪ AM_LOG_LEVEL_NONE
+ * Ʒֻ;棬ڹж AM_LOG_LEVEL=2
  */
+#ifndef AM_LOG_LEVEL
 #ifdef AM_VDEBUG
-#define AM_DBG_INFO(...)    (void)am_kprintf(__VA_ARGS__)
+#define AM_LOG_LEVEL           AM_LOG_LEVEL_DEBUG
+#else
+#define AM_LOG_LEVEL           AM_LOG_LEVEL_NONE
+#endif
+#endif
+
+/**
+ * \brief ǰԴļ־ģ
+ *
+ * ڰļǰ壬磺
+ * \code
+ *  #define AM_LOG_MODULE        AM_LOG_MOD_FTL
+ *  #define AM_LOG_MODULE_LEVEL  AM_LOG_LEVEL_WARN
+ *  #include "am_vdebug.h"
+ * \endcode
+ */
+#ifndef AM_LOG_MODULE
+#define AM_LOG_MODULE          AM_LOG_MOD_APP
+#endif
+
+/**
+ * \brief ǰԴļʱ־𣬲 AM_LOG_LEVELڰļǰ
+ */
+#ifndef AM_LOG_MODULE_LEVEL
+#define AM_LOG_MODULE_LEVEL    AM_LOG_LEVEL
+#endif
+
+/** \brief ʵʱ־ڲʹã */
+#if (AM_LOG_MODULE_LEVEL < AM_LOG_LEVEL)
+#define __AM_LOG_LEVEL         AM_LOG_MODULE_LEVEL
+#else
+#define __AM_LOG_LEVEL         AM_LOG_LEVEL
+#endif
+
+/** \brief ģʱε־ڲʹã am_log_mask_set() */
+extern uint8_t g_am_log_mask_off[AM_LOG_MOD_NUM];
+
+/** \brief ʱǷģü־ */
+#define AM_LOG_ENABLED(module, level) \
+    ((g_am_log_mask_off[(module)] & (1u << (level))) == 0)
+
+/** \brief һ־ڲʹã */
+#define __AM_LOG(level, ...)                                                   \
+    do {                                                                       \
+        if (AM_LOG_ENABLED(AM_LOG_MODULE, level)) {                            \
+            (void)am_kprintf(__VA_ARGS__);                                     \
+        }                                                                      \
+    } while (0)
+
+/** \brief ־÷ͬ am_kprintf() */
+#if (__AM_LOG_LEVEL >= AM_LOG_LEVEL_ERROR)
+#define AM_LOGE(...)    __AM_LOG(AM_LOG_LEVEL_ERROR, __VA_ARGS__)
 #else
-#define AM_DBG_INFO(...)
+#define AM_LOGE(...)
 #endif
 
+/** \brief ־÷ͬ am_kprintf() */
+#if (__AM_LOG_LEVEL >= AM_LOG_LEVEL_WARN)
+#define AM_LOGW(...)    __AM_LOG(AM_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define AM_LOGW(...)
+#endif
+
+/** \brief Ϣ־÷ͬ am_kprintf() */
+#if (__AM_LOG_LEVEL >= AM_LOG_LEVEL_INFO)
+#define AM_LOGI(...)    __AM_LOG(AM_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define AM_LOGI(...)
+#endif
+
+/** \brief ־÷ͬ am_kprintf() */
+#if (__AM_LOG_LEVEL >= AM_LOG_LEVEL_DEBUG)
+#define AM_LOGD(...)    __AM_LOG(AM_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define AM_LOGD(...)
+#endif
+
+/**
+ * \brief AM_VDEBUG, AM_DBG_INFO() 꽫Ϣ
+ *        AM_DBG_INFO()ʵΪ
+ *
+ * ͬ AM_LOGD()
+ */
+#define AM_DBG_INFO(...)    AM_LOGD(__VA_ARGS__)
+
 /** \brief format log message and output */
 #ifdef AM_VDEBUG
 #define AM_LOGF(msg)    (void)am_kprintf msg
@@ -102,11 +214,110 @@ extern "C" {
  */
 void am_debug_init (am_uart_handle_t handle, uint32_t baudrate);
 
+/**
+ * \name ʱĴʽ
+ * @{
+ */
+
+/** \brief ַ */
+#define AM_DEBUG_OVERFLOW_DROP          0
+
+/**
+ * \brief ȴڳռ䣬ʧַ
+ *
+ * ߳джϣȴжϷַͣʱ䣬ʱΪѯ
+ * жԲѯʽͻַ
+ */
+#define AM_DEBUG_OVERFLOW_BLOCK         1
+
+/** \brief ַ */
+#define AM_DEBUG_OVERFLOW_DROP_OLDEST   2
+
+/** @} */
+
+/**
+ * \brief Գʼ
+ *
+ * Ϣд뻷λأɴڷжϷͣϢٵȴ
+ * ڷɡڹжģʽжҲ򿪣յݱ
+ * ʹòѯʽӸôڽݡ
+ *
+ * \param[in] handle   : ׼ĴڷHandle, Ϣô
+ * \param[in] baudrate : ʹõĲ
+ * \param[in] p_buf    : ʵʿɻ size - 1 ַ
+ * \param[in] size     : С
+ * \param[in] policy   : Ĵʽ AM_DEBUG_OVERFLOW_DROP
+ *
+ * \retval  AM_OK     : ʼ
+ * \retval -AM_EINVAL : Чbaudrate Ϊ 0 ҲЧ
+ * \retval        : ڲ֧жģʽʹòѯʽͬ am_debug_init()
+ */
+int am_debug_buffered_init (am_uart_handle_t  handle,
+                            uint32_t          baudrate,
+                            char             *p_buf,
+                            size_t            size,
+                            int               policy);
+
+/**
+ * \brief ģʱ־
+ *
+ * ֻαʱ־Ĭȫ
+ *
+ * \param[in] module : ־ģ飬 AM_LOG_MOD_FTL
+ * \param[in] mask   : ļAM_LOG_MASK(AM_LOG_LEVEL_ERROR) |
+ *                     AM_LOG_MASK(AM_LOG_LEVEL_WARN)  AM_LOG_MASK_UPTO(level)
+ *
+ * \retval  AM_OK     : óɹ
+ * \retval -AM_EINVAL : ģЧ
+ */
+int am_log_mask_set (int module, uint8_t mask);
+
+/**
+ * \brief ȡģʱ־
+ * \param[in] module : ־ģ
+ * \return ļ룩ģЧʱΪ 0
+ */
+uint8_t am_log_mask_get (int module);
+
+/** \brief Ӧ */
+#define AM_LOG_MASK(level)        ((uint8_t)(1u << (level)))
+
+/** \brief  level м */
+#define AM_LOG_MASK_UPTO(level)   ((uint8_t)((2u << (level)) - 2u))
+
+/**
+ * \brief ȡʱ򻺳ַ
+ * \return ַ
+ */
+uint32_t am_debug_dropped_get (void);
+
+/**
+ * \brief ȴеĵϢɣ縴λ͹ģʽǰ
+ *
+ * \param[in] timeout_ms : ʱʱ䣨λmsΪ 0 ʱһֱȴ
+ *
+ * \retval  AM_OK     : ɣδʹû
+ * \retval -AM_ETIME  : ʱڹرжʱȼڴжϵже
+ */
+int am_debug_flush (uint32_t timeout_ms);
+
+/**
+ * \brief am_vfprintf_do() Сֽڣռջռ䣩
+ *
+ * ıתȴûʽʱһ f_puts 
+ */
+#ifndef AM_VFPRINTF_CHUNK_SIZE
+#define AM_VFPRINTF_CHUNK_SIZE  32
+#endif
+
 /**
  * \brief ʽַ
  *
  * ú vXXXprintf() Ļ vXXXprintf() ڴ˺
  *
+ * ֱ֧־ "-0+ "Ⱥ;ȣֻ '*' "hh" "h" "l" "ll" "z"
+ * ת "%d %i %u %o %x %X %c %s %p %%"ָ֧
+ *
  * \param[in] fil     :  Ϊ f_putc  f_puts ĵڶ
  * \param[in] f_putc  :  ָ룬ָĺһַ
  * \param[in] f_puts  :  ָ룬ָĺһַ
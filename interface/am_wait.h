@@ -21,6 +21,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.02 26-10-17  add am_wait_idle_set() and am_wait_idle().
  * - 1.01 15-09-07  tee, add am_wait_on_timeout() interface.
  * - 1.00 15-06-12  tee, first implementation.
  * \endinternal
@@ -110,6 +111,34 @@ int am_wait_on_timeout(am_wait_t *p_wait, uint32_t timeout_ms);
  * \retval -AM_EINVAL ȴʧܣ
  */
 int am_wait_done(am_wait_t *p_wait);
+
+/**
+ * \brief õȴڼִеĿк
+ *
+ * кڹر CPU жϣam_int_cpu_lock()ȷϵȴδã
+ * ִͨ WFI ʹ CPU ˯ߣжϻ CPU 󷵻أٴжϴжϡ
+ * кʱӦжϡ
+ *
+ * кִڼжϴ״̬вܵȴam_wait_on()
+ * am_event_group_wait() ȣҲܴУǶ׵ĵȴֻ״̬
+ * ѯжϼʱ޷õȴ
+ *
+ * \param[in] pfn_idle : кNULL ʾתȴĬϣ
+ * \param[in] p_arg    : кĲ
+ *
+ * \return 
+ */
+void am_wait_idle_set(am_pfnvoid_t pfn_idle, void *p_arg);
+
+/**
+ * \brief ִһοк
+ *
+ * ȴƣ am_event_groupʹãڹر CPU жϲȷϵȴ
+ * δãغٴжϡδÿкʱء
+ *
+ * \return 
+ */
+void am_wait_idle(void);
  
 
 /** 
@@ -19,6 +19,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-17  add am_zlg116_pwr_sleep()
  * - 1.00 17-04-18  nwt, first implementation
  * \endinternal
  */
@@ -170,6 +171,20 @@ void am_zlg116_wake_up_cfg (am_zlg116_pwr_mode_t mode,
  */
 int am_zlg116_pwr_mode_into (am_zlg116_pwr_mode_t mode);
 
+/**
+ * \brief CPU ˯ģʽֱжϹʱ
+ *
+ * ִֻ WFIı PWR ģʽʱӣ豣У
+ * am_zlg116_pwr_init() ʹãʺڵȴжϵѭн͹ġ
+ *
+ * \return 
+ *
+ * \note ر CPU жϣam_int_cpu_lock()ãжԿɻ CPU
+ *       жϷ´жϺִУȴ˯ǰ
+ *       жϱ
+ */
+void am_zlg116_pwr_sleep (void);
+
 /**
  * \brief ȡ PWR ģʽ
  *
@@ -16,9 +16,13 @@
  *
  * \internal
  * \par Modification history
+ * - 1.02 26-10-17  use leveled log macros
+ * - 1.01 26-10-17  add am_zlg116_pwr_sleep()
  * - 1.00 17-04-18  nwt, first implementation
  * \endinternal
  */
+#define AM_LOG_MODULE   AM_LOG_MOD_SOC
+
 #include "am_int.h"
 #include "am_gpio.h"
 #include "am_vdebug.h"
@@ -400,7 +404,7 @@ int am_zlg116_pwr_mode_into (am_zlg116_pwr_mode_t mode)
         }
         __gp_pwr_dev->pwr_mode = AM_ZLG116_PWR_MODE_SLEEP;
 
-        AM_DBG_INFO("enter sleep!\r\n");
+        AM_LOGD("enter sleep!\r\n");
 
         __pwr_cpu_wif(AM_FALSE);
 
@@ -479,6 +483,14 @@ int am_zlg116_pwr_mode_into (am_zlg116_pwr_mode_t mode)
     return AM_OK;
 }
 
+/**
+ * \brief CPU ˯ģʽ
+ */
+void am_zlg116_pwr_sleep (void)
+{
+    __pwr_cpu_wif(AM_FALSE);
+}
+
 /**
  * \brief ȡ PWR ģʽ
  */
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+AMetal binary log (am_binlog) decoder.
+
+Decodes the record stream written by am_binlog_write() back into text, using
+the format strings kept in the ELF file of the firmware.
+
+usage:
+    am_binlog_decode.py app.elf binlog.bin
+    am_binlog_decode.py app.elf /dev/ttyUSB0      (configure it with stty first)
+    cat binlog.bin | am_binlog_decode.py app.elf -
+
+record (little endian):
+    sync(0xA5, 1) nargs(1) id(4) timestamp(4) args(4 * nargs)
+
+Only the Python 3 standard library is required.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC          = 0xA5
+ARGS_MAX      = 6
+HDR_SIZE      = 10
+ID_FREQ       = 0xFFFFFFFF
+ID_LOST       = 0xFFFFFFFE
+FMT_SECTION   = '.am_binlog_fmt'
+
+SHT_NOBITS    = 8
+SHF_ALLOC     = 0x2
+
+# printf conversion: flags, width, precision, length, conversion
+CONV_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?'
+                     r'(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA%])')
+
+
+class Elf(object):
+    """Minimal ELF reader: section headers and contents only."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s: not an ELF file' % path)
+        if self.data[5] != 1:
+            raise ValueError('%s: only little endian ELF is supported' % path)
+
+        is64 = (self.data[4] == 2)
+        if is64:
+            shoff, = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x3A)
+            shfmt = '<IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+            shfmt = '<IIIIIIIIII'
+
+        headers = []
+        for i in range(shnum):
+            (name, stype, flags, addr, offset,
+             size, _, _, _, _) = struct.unpack_from(shfmt, self.data,
+                                                    shoff + i * shentsize)
+            headers.append((name, stype, flags, addr, offset, size))
+
+        strtab = headers[shstrndx]
+        self.sections = []
+        for (name, stype, flags, addr, offset, size) in headers:
+            sname = self._cstr(strtab[4] + name)
+            if stype == SHT_NOBITS or size == 0:
+                continue
+            self.sections.append((sname, stype, flags, addr, offset, size))
+
+        # format strings first, then all the loaded sections (%s arguments,
+        # or format strings left in flash by other toolchains)
+        self.fmt_sections = [s for s in self.sections if s[0] == FMT_SECTION]
+        self.str_sections = self.fmt_sections + \
+                            [s for s in self.sections if s[2] & SHF_ALLOC]
+
+    def _cstr(self, offset, limit=None):
+        end = self.data.find(b'\0', offset, limit)
+        if end < 0:
+            return None
+        return self.data[offset:end].decode('utf-8', 'replace')
+
+    def string_at(self, addr):
+        """C string at the target address, or None"""
+        for (_, _, _, saddr, offset, size) in self.str_sections:
+            if saddr <= addr < saddr + size:
+                return self._cstr(offset + addr - saddr, offset + size)
+        return None
+
+
+def to_signed(val):
+    return val - (1 << 32) if val & 0x80000000 else val
+
+
+def format_record(elf, fmt, args):
+    """printf() with the raw 32 bit arguments"""
+    out  = []
+    pos  = 0
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    for m in CONV_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+
+        flags, width, prec, _, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+
+        if width == '*':
+            width = str(to_signed(next_arg()))
+        if prec == '*':
+            prec = str(to_signed(next_arg()))
+
+        spec = '%' + flags + (width or '') + ('.' + prec if prec else '')
+        val  = next_arg()
+
+        if conv in 'di':
+            out.append((spec + 'd') % to_signed(val))
+        elif conv in 'ouxX':
+            out.append((spec + conv) % val)
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(val & 0xFF))
+        elif conv == 'p':
+            out.append('0x%08x' % val)
+        elif conv == 's':
+            s = elf.string_at(val)
+            out.append((spec + 's') % (s if s is not None else '<0x%08x>' % val))
+        else:
+            out.append('<float 0x%08x>' % val)      # floats are not recorded
+
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def records(stream, valid):
+    """yield (id, timestamp, args) from the byte stream, resynchronizing on
+    corrupted data (unknown id or too many arguments)"""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        buf += chunk
+
+        while True:
+            start = buf.find(bytes([SYNC]))
+            if start < 0:
+                del buf[:]
+                break
+            del buf[:start]
+
+            if len(buf) < 2:
+                break
+            nargs = buf[1]
+            if nargs > ARGS_MAX:
+                del buf[:1]
+                continue
+
+            size = HDR_SIZE + 4 * nargs
+            if len(buf) < size:
+                break
+
+            rid, ts = struct.unpack_from('<II', buf, 2)
+            if not valid(rid):
+                del buf[:1]
+                continue
+
+            args = struct.unpack_from('<%dI' % nargs, buf, HDR_SIZE)
+            yield (rid, ts, args)
+            del buf[:size]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='decode am_binlog records')
+    parser.add_argument('elf', help='ELF file of the firmware')
+    parser.add_argument('input', help="binary log file or device, '-' for stdin")
+    parser.add_argument('-f', '--freq', type=int, default=0,
+                        help='timestamp frequency in Hz (default: from the stream)')
+    opts = parser.parse_args()
+
+    elf = Elf(opts.elf)
+    if not elf.fmt_sections:
+        sys.stderr.write('warning: no %s section, looking up format strings '
+                         'in the loaded sections\n' % FMT_SECTION)
+
+    stream = sys.stdin.buffer if opts.input == '-' else open(opts.input, 'rb')
+
+    freq    = opts.freq
+    last_ts = None
+    high    = 0
+
+    def valid(rid):
+        return rid in (ID_FREQ, ID_LOST) or elf.string_at(rid) is not None
+
+    for (rid, ts, args) in records(stream, valid):
+
+        if rid == ID_FREQ:
+            if not opts.freq and args:
+                freq = args[0]
+            last_ts = None
+            high    = 0
+            continue
+
+        # the 32 bit timestamp wraps around
+        if last_ts is not None and ts < last_ts:
+            high += 1 << 32
+        last_ts = ts
+        tick    = high + ts
+
+        stamp = '[%12.6f] ' % (float(tick) / freq) if freq else '[%12u] ' % tick
+
+        if rid == ID_LOST:
+            text = '*** %u records lost ***\n' % (args[0] if args else 0)
+        else:
+            text = format_record(elf, elf.string_at(rid), args)
+
+        sys.stdout.write(stamp + text if text.endswith('\n') else stamp + text + '\n')
+        sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,88 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ׼Թ
+ *
+ * ׼ PC ϱУ README.rstʱλΪ CPU ڣ
+ * x86 ʹ rdtscAArch64 ʹ cntvct_el0ƽ̨ʹ clock_gettime()
+ * ֵڱȽͬһƽ̨¾ʵֵԿ Cortex-M0
+ * ϵľԺʱ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#ifndef __HOST_BENCH_H
+#define __HOST_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/** \brief ȡڼֵ */
+static inline uint64_t bench_cycles (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+
+    __asm__ volatile ("lfence\n\trdtsc" : "=a" (lo), "=d" (hi) :: "memory");
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t val;
+
+    __asm__ volatile ("isb\n\tmrs %0, cntvct_el0" : "=r" (val) :: "memory");
+    return val;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+/** \brief ʱͳ */
+typedef struct bench_stat {
+    uint64_t sum;       /**< \brief ۼ */
+    uint64_t max;       /**< \brief  */
+    uint64_t num;       /**< \brief  */
+} bench_stat_t;
+
+/** \brief ۼһμʱ */
+static inline void bench_stat_add (bench_stat_t *p_stat, uint64_t cycles)
+{
+    p_stat->sum += cycles;
+    p_stat->num++;
+    if (cycles > p_stat->max) {
+        p_stat->max = cycles;
+    }
+}
+
+/** \brief ƽ */
+static inline double bench_stat_mean (const bench_stat_t *p_stat)
+{
+    return p_stat->num ? (double)p_stat->sum / p_stat->num : 0.0;
+}
+
+/** \brief 򵥵֤ͬƽ̨ɸ */
+static inline uint32_t bench_rand (uint32_t *p_seed)
+{
+    *p_seed = *p_seed * 1103515245u + 12345u;
+    return *p_seed >> 1;
+}
+
+#endif /* __HOST_BENCH_H */
+
+/* end of file */
@@ -0,0 +1,44 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ׼Եж׮̣߳жϣ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-17  add am_int_in_isr()
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include <stdint.h>
+
+/******************************************************************************/
+uint32_t am_int_cpu_lock (void)
+{
+    return 0;
+}
+
+/******************************************************************************/
+void am_int_cpu_unlock (uint32_t key)
+{
+    (void)key;
+}
+
+/******************************************************************************/
+uint32_t am_int_in_isr (void)
+{
+    return 0;
+}
+
+/* end of file */
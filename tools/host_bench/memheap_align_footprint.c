@@ -0,0 +1,166 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ڴռãam_memheap_alloc_align() ԭ am_mem_align() Ƚ
+ *
+ * ԭ am_mem_align()  align + һָ룬ڶַǰԭʼַ
+ * am_mem_alloc() ҲָС룻 am_mem_alloc() ֱӵ
+ * am_memheap_alloc()am_mem_align()  am_memheap_alloc_align()
+ * ͬһϷֱַʽ䣬 am_memheap_info_get() õѷС
+ * ͷ֮Ϊռãֱ״ TLSF README.rst
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "am_memheap.h"
+#include <stdio.h>
+
+#if (AM_MEMHEAP_TLSF_ENABLE != 1)
+#error "memheap_align_footprint requires AM_MEMHEAP_TLSF_ENABLE=1"
+#endif
+
+/** \brief ѿռС */
+#define __POOL_SIZE     (16 * 1024)
+
+static uint64_t __g_pool[__POOL_SIZE / 8];
+
+/** \brief ͵С */
+static const uint32_t __g_mix[] = {4, 8, 12, 16, 24, 32, 48, 64, 128, 256};
+
+/******************************************************************************/
+
+/* ޸ǰ am_mem_align() ʵ֣ڶַǰԭʼַ */
+static void *__old_mem_align (struct am_memheap *p_heap,
+                              uint32_t           size,
+                              uint32_t           align)
+{
+    uintptr_t ptr;
+    uintptr_t align_ptr;
+
+    align = AM_ROUND_UP(align, sizeof(void *));
+
+    ptr = (uintptr_t)am_memheap_alloc(p_heap,
+                                      AM_ROUND_UP(size, sizeof(void *)) +
+                                      align + sizeof(void *));
+    if (ptr == 0) {
+        return NULL;
+    }
+
+    align_ptr = AM_ROUND_UP(ptr + sizeof(void *), align);
+    ((uintptr_t *)align_ptr)[-1] = ptr;
+
+    return (void *)align_ptr;
+}
+
+/******************************************************************************/
+static void __old_mem_free (void *ptr)
+{
+    am_memheap_free((void *)((uintptr_t *)ptr)[-1]);
+}
+
+/******************************************************************************/
+static uint32_t __used_get (struct am_memheap *p_heap)
+{
+    am_memheap_info_t info;
+
+    am_memheap_info_get(p_heap, &info);
+    return info.used_size;
+}
+
+/******************************************************************************/
+
+/*  num ռãold Ϊ AM_TRUE ʱԭ am_mem_align()  */
+static uint32_t __footprint (struct am_memheap *p_heap,
+                             const uint32_t    *p_size,
+                             int                num,
+                             uint32_t           align,
+                             am_bool_t          old)
+{
+    void     *ptr[sizeof(__g_mix) / sizeof(__g_mix[0])];
+    uint32_t  used = __used_get(p_heap);
+    int       i;
+
+    for (i = 0; i < num; i++) {
+        if (old) {
+            ptr[i] = __old_mem_align(p_heap, p_size[i], align);
+        } else if (align <= sizeof(void *)) {
+            ptr[i] = am_memheap_alloc(p_heap, p_size[i]);
+        } else {
+            ptr[i] = am_memheap_alloc_align(p_heap, p_size[i], align);
+        }
+        if ((ptr[i] == NULL) || (((uintptr_t)ptr[i] & (align - 1)) != 0)) {
+            printf("FAIL: size %u align %u\n", p_size[i], align);
+            return 0;
+        }
+    }
+
+    used = __used_get(p_heap) - used;
+
+    for (i = 0; i < num; i++) {
+        if (old) {
+            __old_mem_free(ptr[i]);
+        } else {
+            am_memheap_free(ptr[i]);
+        }
+    }
+
+    return used;
+}
+
+/******************************************************************************/
+static void __report (struct am_memheap *p_heap, const char *p_name)
+{
+    static const uint32_t aligns[] = {8, 16, 32, 64, 128};
+    uint32_t              size     = 100;
+    uint32_t              old, now;
+    int                   num      = sizeof(__g_mix) / sizeof(__g_mix[0]);
+    int                   i;
+
+    old = __footprint(p_heap, __g_mix, num, sizeof(void *), AM_TRUE);
+    now = __footprint(p_heap, __g_mix, num, sizeof(void *), AM_FALSE);
+    printf("%-5s am_mem_alloc() x %d (4..256 B)  old %5u  new %5u  (%+d)\n",
+           p_name, num, old, now, (int)now - (int)old);
+
+    for (i = 0; i < (int)(sizeof(aligns) / sizeof(aligns[0])); i++) {
+        old = __footprint(p_heap, &size, 1, aligns[i], AM_TRUE);
+        now = __footprint(p_heap, &size, 1, aligns[i], AM_FALSE);
+        printf("%-5s am_mem_align(%u, %3u)            old %5u  new %5u  (%+d)\n",
+               p_name, size, aligns[i], old, now, (int)now - (int)old);
+    }
+}
+
+/******************************************************************************/
+int main (void)
+{
+    struct am_memheap heap;
+    uint32_t          size = 64;
+
+    am_memheap_init(&heap, "first", __g_pool, sizeof(__g_pool));
+    printf("block header %u bytes, pointer %u bytes; "
+           "footprint = allocated size incl. headers\n",
+           __footprint(&heap, &size, 1, sizeof(void *), AM_FALSE) - size,
+           (unsigned)sizeof(void *));
+
+    __report(&heap, "first");
+
+    am_memheap_tlsf_init(&heap, "tlsf", __g_pool, sizeof(__g_pool));
+    __report(&heap, "tlsf");
+
+    return 0;
+}
+
+/* end of file */
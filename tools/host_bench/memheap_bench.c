@@ -0,0 +1,257 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ѹ׼ԣ״ TLSF ĺʱƬ
+ *
+ *  8 KB  64 KB Ķѷֱʹ㷨
+ * - ѹ20 ķ䣨СΪ1/8 Ϊ飩Сͷţ
+ *   ÿβ am_memheap_check() ѵԣУδƻ
+ *   ͳƷͷŵƽp99.9 ʧܴԼʱ
+ *   дСпƬʣ
+ * -  16 ֽڵĿѺͷţ´Сնٷ 200 ֽڣ
+ *   ״пնȡ 50 еֵ
+ *
+ *  AM_MEMHEAP_TLSF_ENABLE=1  am_memheap.c README.rst
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "host_bench.h"
+#include "am_memheap.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if (AM_MEMHEAP_TLSF_ENABLE != 1)
+#error "memheap_bench requires AM_MEMHEAP_TLSF_ENABLE=1"
+#endif
+
+/** \brief ѿռֵ */
+#define __POOL_MAX      (64 * 1024)
+
+/** \brief ѹĲ */
+#define __OP_NUM        200000
+
+/** \brief ѹͬʱеڴ */
+#define __SLOT_MAX      (__POOL_MAX / 160)
+
+static uint64_t  __g_pool[__POOL_MAX / 8];
+static uint32_t  __g_alloc_cycles[__OP_NUM];
+static uint32_t  __g_free_cycles[__OP_NUM];
+static char     *__g_slot[__SLOT_MAX];
+static size_t    __g_slot_size[__SLOT_MAX];
+static void     *__g_holes[__POOL_MAX / 32];
+
+/******************************************************************************/
+static int __heap_init (struct am_memheap *p_heap, int tlsf, uint32_t pool_size)
+{
+    if (tlsf) {
+        return am_memheap_tlsf_init(p_heap, "bench", __g_pool, pool_size);
+    }
+    return am_memheap_init(p_heap, "bench", __g_pool, pool_size);
+}
+
+/******************************************************************************/
+static int __cycles_cmp (const void *p_a, const void *p_b)
+{
+    uint32_t a = *(const uint32_t *)p_a;
+    uint32_t b = *(const uint32_t *)p_b;
+
+    return (a < b) ? -1 : (a > b);
+}
+
+/******************************************************************************/
+static int __data_check (const char *p_buf, size_t size, int val)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        if (p_buf[i] != (char)val) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************/
+static int __stress (int tlsf, uint32_t pool_size)
+{
+    struct am_memheap  heap;
+    am_memheap_info_t  info;
+    bench_stat_t       alloc  = {0}, free = {0};
+    uint32_t           seed   = 7;
+    uint32_t           fail   = 0;
+    int                slot_num = pool_size / 160;
+    int                i, k;
+    size_t             size;
+    char              *p_buf;
+    uint64_t           t0;
+
+    if (__heap_init(&heap, tlsf, pool_size) != AM_OK) {
+        printf("FAIL: heap init\n");
+        return -1;
+    }
+    memset(__g_slot, 0, sizeof(__g_slot));
+
+    for (i = 0; i < __OP_NUM; i++) {
+
+        k = bench_rand(&seed) % slot_num;
+
+        if (__g_slot[k] == NULL) {
+
+            size = (bench_rand(&seed) % 8 == 0) ?
+                   64 + bench_rand(&seed) % (pool_size / 64) :
+                   4  + bench_rand(&seed) % 96;
+
+            t0    = bench_cycles();
+            p_buf = am_memheap_alloc(&heap, size);
+            t0    = bench_cycles() - t0;
+            __g_alloc_cycles[alloc.num] = (uint32_t)t0;
+            bench_stat_add(&alloc, t0);
+
+            if (p_buf == NULL) {
+                fail++;
+                continue;
+            }
+            memset(p_buf, k, size);
+            __g_slot[k]      = p_buf;
+            __g_slot_size[k] = size;
+
+        } else if (bench_rand(&seed) % 10 < 2) {
+
+            size  = 4 + bench_rand(&seed) % 200;
+            p_buf = am_memheap_realloc(&heap, __g_slot[k], size);
+            if (p_buf != NULL) {
+                if (__data_check(p_buf,
+                                 size < __g_slot_size[k] ?
+                                 size : __g_slot_size[k], k) != 0) {
+                    printf("FAIL: data lost by realloc\n");
+                    return -1;
+                }
+                memset(p_buf, k, size);
+                __g_slot[k]      = p_buf;
+                __g_slot_size[k] = size;
+            }
+
+        } else {
+
+            if (__data_check(__g_slot[k], __g_slot_size[k], k) != 0) {
+                printf("FAIL: data corrupted\n");
+                return -1;
+            }
+
+            t0 = bench_cycles();
+            am_memheap_free(__g_slot[k]);
+            t0 = bench_cycles() - t0;
+            __g_free_cycles[free.num] = (uint32_t)t0;
+            bench_stat_add(&free, t0);
+
+            __g_slot[k] = NULL;
+        }
+
+        if (am_memheap_check(&heap) != AM_OK) {
+            printf("FAIL: heap corrupted after %d operations\n", i + 1);
+            return -1;
+        }
+    }
+
+    qsort(__g_alloc_cycles, alloc.num, sizeof(uint32_t), __cycles_cmp);
+    qsort(__g_free_cycles,  free.num,  sizeof(uint32_t), __cycles_cmp);
+    am_memheap_info_get(&heap, &info);
+
+    printf("%-5s %5u %8.0f %8u %8llu %8.0f %8u %8llu %6u %6u %6u %5u%%\n",
+           tlsf ? "tlsf" : "first",
+           pool_size / 1024,
+           bench_stat_mean(&alloc),
+           __g_alloc_cycles[alloc.num * 999 / 1000],
+           (unsigned long long)alloc.max,
+           bench_stat_mean(&free),
+           __g_free_cycles[free.num * 999 / 1000],
+           (unsigned long long)free.max,
+           fail,
+           info.free_size,
+           info.largest_free,
+           info.frag);
+
+    return 0;
+}
+
+/******************************************************************************/
+static void __worst (int tlsf, uint32_t pool_size)
+{
+    struct am_memheap  heap;
+    uint64_t           best = UINT64_MAX;
+    uint64_t           t0;
+    void              *p_buf;
+    int                n = 0;
+    int                i;
+
+    __heap_init(&heap, tlsf, pool_size);
+
+    while ((n < (int)(pool_size / 64)) &&
+           ((__g_holes[n] = am_memheap_alloc(&heap, 16)) != NULL)) {
+        n++;
+    }
+    for (i = 0; i < n; i += 2) {
+        am_memheap_free(__g_holes[i]);
+    }
+
+    for (i = 0; i < 50; i++) {
+        t0    = bench_cycles();
+        p_buf = am_memheap_alloc(&heap, 200);
+        t0    = bench_cycles() - t0;
+        if (t0 < best) {
+            best = t0;
+        }
+        if (p_buf != NULL) {
+            am_memheap_free(p_buf);
+        }
+    }
+
+    printf("%-5s %5u %6d holes, 200-byte alloc %llu cycles\n",
+           tlsf ? "tlsf" : "first", pool_size / 1024, (n + 1) / 2,
+           (unsigned long long)best);
+}
+
+/******************************************************************************/
+int main (void)
+{
+    static const uint32_t sizes[] = {8 * 1024, 64 * 1024};
+    int                   i, tlsf;
+
+    printf("%-5s %5s %8s %8s %8s %8s %8s %8s %6s %6s %6s %6s\n",
+           "algo", "KB", "alloc", "p99.9", "max", "free", "p99.9", "max",
+           "fail", "free", "large", "frag");
+
+    for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (tlsf = 0; tlsf < 2; tlsf++) {
+            if (__stress(tlsf, sizes[i]) != 0) {
+                return 1;
+            }
+        }
+    }
+
+    printf("\n");
+    for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (tlsf = 0; tlsf < 2; tlsf++) {
+            __worst(tlsf, sizes[i]);
+        }
+    }
+
+    return 0;
+}
+
+/* end of file */
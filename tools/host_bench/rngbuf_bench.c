@@ -0,0 +1,222 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief λ׼ԣֶдʽֽ/ڣ
+ *
+ * ߽ͨһ 256 ֽڵĻλݣֱʹֽڡ
+ * 鿽㿽spanӿڣͳÿڴֽȡ 7 ֵ
+ * "staged"  "span in-place" ģͬһ/̣ǰ߾м仺
+ * ֱڻλɺʹݡ
+ *
+ * am_rngbuf.c 뱾ļֿӣĿһ£ݱļ
+ * ĳ memcpy()޸ǰİ汾ʱ趨 BENCH_NO_SPAN 
+ * ӿڣ README.rst
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "host_bench.h"
+#include "am_rngbuf.h"
+#include <string.h>
+
+/** \brief λС */
+#define __RB_SIZE       256
+
+/** \brief ÿִֽ */
+#define __TOTAL_BYTES   (4ul * 1024 * 1024)
+
+/** \brief ȡֵ */
+#define __ROUND_NUM     7
+
+static struct am_rngbuf __g_rb;
+static char             __g_rb_buf[__RB_SIZE];
+static char             __g_src[128];
+static char             __g_dst[128];
+static volatile uint32_t __g_sink;
+
+/******************************************************************************/
+static void __run_char (void)
+{
+    size_t   done = 0;
+    size_t   k;
+    char     c;
+    uint32_t sum  = 0;
+
+    while (done < __TOTAL_BYTES) {
+        for (k = 0; k < __RB_SIZE - 1; k++) {
+            am_rngbuf_putchar(&__g_rb, (char)k);
+        }
+        while (am_rngbuf_getchar(&__g_rb, &c)) {
+            sum += (uint8_t)c;
+            done++;
+        }
+    }
+    __g_sink = sum;
+}
+
+/******************************************************************************/
+static void __run_block (size_t block)
+{
+    size_t done = 0;
+
+    while (done < __TOTAL_BYTES) {
+        am_rngbuf_put(&__g_rb, __g_src, block);
+        done += am_rngbuf_get(&__g_rb, __g_dst, block);
+    }
+    __g_sink = (uint8_t)__g_dst[0];
+}
+
+static void __run_block16 (void)  { __run_block(16);  }
+static void __run_block100 (void) { __run_block(100); }
+
+/******************************************************************************/
+
+/* м仺д룬м仺ٴ */
+static void __run_staged (void)
+{
+    size_t   done = 0;
+    size_t   k, n;
+    uint32_t sum  = 0;
+
+    while (done < __TOTAL_BYTES) {
+        for (k = 0; k < 100; k++) {
+            __g_src[k] = (char)(done + k);
+        }
+        am_rngbuf_put(&__g_rb, __g_src, 100);
+
+        n = am_rngbuf_get(&__g_rb, __g_dst, 100);
+        for (k = 0; k < n; k++) {
+            sum += (uint8_t)__g_dst[k];
+        }
+        done += n;
+    }
+    __g_sink = sum;
+}
+
+#ifndef BENCH_NO_SPAN
+
+/******************************************************************************/
+static void __run_span_copy (void)
+{
+    am_rngbuf_span_t span[2];
+    size_t           done = 0;
+    size_t           n;
+
+    while (done < __TOTAL_BYTES) {
+        n = am_rngbuf_write_reserve(&__g_rb, 100, span);
+        memcpy(span[0].p_buf, __g_src, span[0].len);
+        memcpy(span[1].p_buf, __g_src + span[0].len, span[1].len);
+        am_rngbuf_write_commit(&__g_rb, n);
+
+        n = am_rngbuf_read_peek(&__g_rb, 100, span);
+        memcpy(__g_dst, span[0].p_buf, span[0].len);
+        memcpy(__g_dst + span[0].len, span[1].p_buf, span[1].len);
+        am_rngbuf_read_release(&__g_rb, n);
+        done += n;
+    }
+    __g_sink = (uint8_t)__g_dst[0];
+}
+
+/******************************************************************************/
+
+/* ֱڻλɺʹݣ __run_staged() Ľͬ */
+static void __run_span_inplace (void)
+{
+    am_rngbuf_span_t span[2];
+    size_t           done = 0;
+    size_t           i, k, n, len, pos;
+    char            *p_buf;
+    uint32_t         sum  = 0;
+
+    while (done < __TOTAL_BYTES) {
+        n   = am_rngbuf_write_reserve(&__g_rb, 100, span);
+        pos = done;
+        for (i = 0; i < 2; i++) {
+
+            /*  char * д span صȡָͳ */
+            p_buf = span[i].p_buf;
+            len   = span[i].len;
+            for (k = 0; k < len; k++) {
+                p_buf[k] = (char)(pos + k);
+            }
+            pos += len;
+        }
+        am_rngbuf_write_commit(&__g_rb, n);
+
+        n = am_rngbuf_read_peek(&__g_rb, 100, span);
+        for (i = 0; i < 2; i++) {
+            p_buf = span[i].p_buf;
+            len   = span[i].len;
+            for (k = 0; k < len; k++) {
+                sum += (uint8_t)p_buf[k];
+            }
+        }
+        am_rngbuf_read_release(&__g_rb, n);
+        done += n;
+    }
+    __g_sink = sum;
+}
+
+#endif /* BENCH_NO_SPAN */
+
+/******************************************************************************/
+static void __bench (const char *p_name, void (*pfn_run) (void))
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    int      i;
+
+    for (i = 0; i < __ROUND_NUM; i++) {
+        am_rngbuf_flush(&__g_rb);
+
+        t0 = bench_cycles();
+        pfn_run();
+        t0 = bench_cycles() - t0;
+
+        if (t0 < best) {
+            best = t0;
+        }
+    }
+
+    printf("%-16s %8.3f\n", p_name, (double)__TOTAL_BYTES / best);
+}
+
+/******************************************************************************/
+int main (void)
+{
+    if (am_rngbuf_init(&__g_rb, __g_rb_buf, __RB_SIZE) != AM_OK) {
+        printf("FAIL: am_rngbuf_init()\n");
+        return 1;
+    }
+
+    memset(__g_src, 0x5A, sizeof(__g_src));
+
+    printf("%-16s %8s\n", "mode", "B/cycle");
+
+    __bench("char",           __run_char);
+    __bench("block 16",       __run_block16);
+    __bench("block 100",      __run_block100);
+    __bench("staged",         __run_staged);
+#ifndef BENCH_NO_SPAN
+    __bench("span copy",      __run_span_copy);
+    __bench("span in-place",  __run_span_inplace);
+#endif
+
+    return 0;
+}
+
+/* end of file */
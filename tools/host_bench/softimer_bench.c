@@ -0,0 +1,238 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʱ׼ԣֲֵʱ
+ *
+ *  10 ~ 1000 еĶʱ am_softimer_start()е
+ * ʱam_softimer_stop()  am_softimer_module_tick() ƽ
+ * ޽ģʽʹõ am_softimer_module_next_ticks_get() 
+ * 絽ڵĶʱ am_softimer_module_announce() һƽ
+ *  am_softimer_module_tick() ĵ˳һ¡ֱ
+ * AM_SOFTIMER_WHEEL_ENABLE=0/1 룬 README.rst
+ *
+ * \internal
+ * \par Modification history
+ * - 1.02 26-10-17  check am_softimer_module_announce() against tick()
+ * - 1.01 26-10-17  stub am_jobq_job_is_queued() for am_softimer_defer_set()
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "host_bench.h"
+#include "../../components/util/source/am_softimer.c"
+
+/** \brief ʱ */
+#define __TIMER_MAX     1000
+
+/** \brief ÿĴ */
+#define __LOOP_NUM      20000
+
+static am_softimer_t __g_timers[__TIMER_MAX];
+static unsigned int  __g_fired;
+static uint32_t      __g_fired_hash;
+static uint32_t      __g_seed = 1;
+
+/* жӳģδʼʱصֱִ */
+void am_isr_defer_job_init (am_isr_defer_job_t  *p_job,
+                            am_pfnvoid_t         func,
+                            void                *p_arg,
+                            uint16_t             pri)
+{
+}
+
+int am_isr_defer_job_add (am_isr_defer_job_t *p_job)
+{
+    return -AM_EPERM;
+}
+
+am_bool_t am_jobq_job_is_queued (am_jobq_job_t *p_job)
+{
+    return AM_FALSE;
+}
+
+/******************************************************************************/
+static void __timer_cb (void *p_arg)
+{
+    __g_fired++;
+    __g_fired_hash = __g_fired_hash * 31 + (uint32_t)(uintptr_t)p_arg;
+}
+
+/******************************************************************************/
+static void __timers_setup (int num, unsigned int max_ms)
+{
+    int i;
+
+    am_softimer_module_init(1000);              /* 1 tick = 1 ms */
+
+    for (i = 0; i < num; i++) {
+        am_softimer_init(&__g_timers[i], __timer_cb, (void *)(uintptr_t)i);
+        am_softimer_start(&__g_timers[i], 1 + bench_rand(&__g_seed) % max_ms);
+    }
+}
+
+/******************************************************************************/
+static void __bench (int num)
+{
+    bench_stat_t start = {0}, stop = {0}, tick = {0};
+    uint64_t     t0;
+    int          i, idx;
+    unsigned int ms;
+
+    __timers_setup(num, 2000);
+
+    for (i = 0; i < __LOOP_NUM; i++) {
+        idx = bench_rand(&__g_seed) % num;
+        ms  = 1 + bench_rand(&__g_seed) % 2000;
+
+        t0 = bench_cycles();
+        am_softimer_start(&__g_timers[idx], ms);
+        bench_stat_add(&start, bench_cycles() - t0);
+    }
+
+    for (i = 0; i < __LOOP_NUM; i++) {
+        idx = bench_rand(&__g_seed) % num;
+
+        t0 = bench_cycles();
+        am_softimer_stop(&__g_timers[idx]);
+        bench_stat_add(&stop, bench_cycles() - t0);
+
+        am_softimer_start(&__g_timers[idx], 1 + bench_rand(&__g_seed) % 2000);
+    }
+
+    for (i = 0; i < __LOOP_NUM; i++) {
+        t0 = bench_cycles();
+        am_softimer_module_tick();
+        bench_stat_add(&tick, bench_cycles() - t0);
+    }
+
+    printf("%-5s %5d %10.1f %8llu %10.1f %8llu %10.1f %8llu\n",
+           AM_SOFTIMER_WHEEL_ENABLE ? "wheel" : "list",
+           num,
+           bench_stat_mean(&start), (unsigned long long)start.max,
+           bench_stat_mean(&stop),  (unsigned long long)stop.max,
+           bench_stat_mean(&tick),  (unsigned long long)tick.max);
+}
+
+/******************************************************************************/
+
+/*  next_ticks_get() next ڼ䲻жʱ */
+static int __check_next_ticks (int num, unsigned int max_ms)
+{
+    unsigned int next, ticks;
+    double       ratio = 0;
+    int          trial;
+
+    __timers_setup(num, max_ms);
+
+    for (trial = 0; trial < 200; trial++) {
+
+        next       = am_softimer_module_next_ticks_get();
+        __g_fired  = 0;
+
+        for (ticks = 1; __g_fired == 0; ticks++) {
+            am_softimer_module_tick();
+            if (__g_fired != 0) {
+                break;
+            }
+        }
+
+        if (ticks < next) {
+            printf("FAIL: %d timers, next_ticks %u but expired after %u\n",
+                   num, next, ticks);
+            return -1;
+        }
+
+        ratio += (double)next / ticks;
+    }
+
+    printf("%-5s %5d timers up to %7u ms: next_ticks/actual = %.3f\n",
+           AM_SOFTIMER_WHEEL_ENABLE ? "wheel" : "list",
+           num, max_ms, ratio / 200);
+
+    return 0;
+}
+
+/******************************************************************************/
+
+/* ȵ announce() ƽڴ˳ tick() ͬ */
+static int __check_announce (int num, unsigned int max_ms)
+{
+    uint32_t     hash[2];
+    unsigned int fired[2];
+    unsigned int done, n, k;
+    uint32_t     seed;
+    int          announce;
+
+    for (announce = 0; announce < 2; announce++) {
+
+        __g_seed       = 1;
+        seed           = 7;
+        __g_fired      = 0;
+        __g_fired_hash = 0;
+        __timers_setup(num, max_ms);
+
+        for (done = 0; done < 10 * max_ms; done += n) {
+            n = 1 + bench_rand(&seed) % 5000;
+            if (announce) {
+                am_softimer_module_announce(n);
+            } else {
+                for (k = 0; k < n; k++) {
+                    am_softimer_module_tick();
+                }
+            }
+        }
+
+        hash[announce]  = __g_fired_hash;
+        fired[announce] = __g_fired;
+    }
+
+    if ((hash[0] != hash[1]) || (fired[0] != fired[1])) {
+        printf("FAIL: %d timers, announce() fired %u (hash %08x), "
+               "tick() fired %u (hash %08x)\n",
+               num, fired[1], hash[1], fired[0], hash[0]);
+        return -1;
+    }
+
+    printf("%-5s %5d timers up to %7u ms: announce() matches tick(), "
+           "%u expirations\n",
+           AM_SOFTIMER_WHEEL_ENABLE ? "wheel" : "list", num, max_ms, fired[0]);
+
+    return 0;
+}
+
+/******************************************************************************/
+int main (void)
+{
+    static const int nums[] = {10, 30, 100, 300, 1000};
+    int              i;
+
+    printf("%-5s %5s %10s %8s %10s %8s %10s %8s\n", "impl", "N",
+           "start", "max", "stop", "max", "tick", "max");
+
+    for (i = 0; i < (int)(sizeof(nums) / sizeof(nums[0])); i++) {
+        __bench(nums[i]);
+    }
+
+    if ((__check_next_ticks(3,   100000) != 0) ||
+        (__check_next_ticks(30,  100000) != 0) ||
+        (__check_next_ticks(300, 5000)   != 0) ||
+        (__check_announce(30,  100000)   != 0) ||
+        (__check_announce(300, 5000)     != 0)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/* end of file */
@@ -0,0 +1,176 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʽ׼ԣam_snprintf()am_kprintf() ÿεõ
+ *
+ * Լֵ͵ĸʽֱ am_snprintf()  am_kprintf()ͳÿεõ
+ * Լ am_kprintf() ÿεõôÿ 2000 Σȡ 200 
+ * еֵԼĸšam_kprintf() ֻ
+ * ʴڡ am_vfprintf_do.c ¾ɰ汾ֱӣ README.rst
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-17  first implementation
+ * \endinternal
+ */
+
+#include "host_bench.h"
+#include "am_vdebug.h"
+#include "am_koutput.h"
+
+/** \brief ÿֵô */
+#define __LOOP_NUM      2000
+
+/** \brief ȡֵ */
+#define __ROUND_NUM     200
+
+static unsigned long  __g_calls;
+static volatile int   __g_int  = 123456;
+static volatile int   __g_neg  = -42;
+static volatile int   __g_hex  = 0xbeef;
+static char           __g_buf[128];
+
+/******************************************************************************/
+static int __sink_putc (const char c, void *fil)
+{
+    __g_calls++;
+    return 1;
+}
+
+/******************************************************************************/
+static int __sink_puts (const char *s, void *fil)
+{
+    const char *p = s;
+
+    __g_calls++;
+    while (*p != '\0') {
+        p++;
+    }
+    return (int)(p - s);
+}
+
+/******************************************************************************/
+
+/* ÿָʽһÿδ volatile ȡ */
+static void __fmt_literal (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("system started, all peripherals initialised\n");
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf),
+                    "system started, all peripherals initialised\n");
+    }
+}
+
+static void __fmt_int (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("%d", __g_int);
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf), "%d", __g_int);
+    }
+}
+
+static void __fmt_small_int (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("%d", __g_neg);
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf), "%d", __g_neg);
+    }
+}
+
+static void __fmt_hex (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("%08x", __g_hex);
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf), "%08x", __g_hex);
+    }
+}
+
+static void __fmt_mixed (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("adc ch%d = %5u mV, status 0x%08x\n",
+                   3, __g_int, __g_hex);
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf),
+                    "adc ch%d = %5u mV, status 0x%08x\n",
+                    3, __g_int, __g_hex);
+    }
+}
+
+static void __fmt_string (int kprintf)
+{
+    if (kprintf) {
+        am_kprintf("name: %s, id: %d\n", "sensor", __g_int);
+    } else {
+        am_snprintf(__g_buf, sizeof(__g_buf),
+                    "name: %s, id: %d\n", "sensor", __g_int);
+    }
+}
+
+/******************************************************************************/
+static double __cycles_per_call (void (*pfn_fmt) (int), int kprintf)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    int      i, round;
+
+    for (round = 0; round < __ROUND_NUM; round++) {
+        t0 = bench_cycles();
+        for (i = 0; i < __LOOP_NUM; i++) {
+            pfn_fmt(kprintf);
+        }
+        t0 = bench_cycles() - t0;
+        if (t0 < best) {
+            best = t0;
+        }
+    }
+
+    return (double)best / __LOOP_NUM;
+}
+
+/******************************************************************************/
+static void __bench (const char *p_name, void (*pfn_fmt) (int))
+{
+    double snprintf_cycles = __cycles_per_call(pfn_fmt, 0);
+    double kprintf_cycles  = __cycles_per_call(pfn_fmt, 1);
+
+    __g_calls = 0;
+    pfn_fmt(1);
+
+    printf("%-10s %10.0f %10.0f %8lu\n",
+           p_name, snprintf_cycles, kprintf_cycles, __g_calls);
+}
+
+/******************************************************************************/
+int main (void)
+{
+    am_koutput_set(NULL, __sink_putc, __sink_puts);
+
+    printf("%-10s %10s %10s %8s\n", "format", "snprintf", "kprintf", "calls");
+
+    __bench("literal", __fmt_literal);
+    __bench("%d",      __fmt_int);
+    __bench("%d (-42)", __fmt_small_int);
+    __bench("%08x",    __fmt_hex);
+    __bench("mixed",   __fmt_mixed);
+    __bench("%s %d",   __fmt_string);
+
+    return 0;
+}
+
+/* end of file */
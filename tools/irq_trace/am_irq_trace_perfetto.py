@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+AMetal interrupt trace (am_irq_trace) to Chrome/Perfetto trace converter.
+
+The input is either:
+  - the text printed by am_irq_trace_dump() (a serial log; other lines are
+    ignored), or
+  - a binary memory dump of g_am_irq_trace, e.g. from gdb:
+        dump binary value irq.bin g_am_irq_trace
+
+The output is a Chrome JSON trace, open it in https://ui.perfetto.dev or
+chrome://tracing.
+
+usage:
+    am_irq_trace_perfetto.py uart.log -o irq.json
+    am_irq_trace_perfetto.py irq.bin -o irq.json -n 20=UART1 -n 13=TIM3
+
+Only the Python 3 standard library is required.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC        = 0x51525449
+HDR_FMT      = '<IIIII'             # magic freq rec_num count enabled
+REC_FMT      = '<IIhH'              # ts dur inum reserved
+CORE_NAMES   = {-1: 'SysTick', -2: 'PendSV'}
+
+
+def parse_text(data):
+    """records from the am_irq_trace_dump() output, in write order"""
+    freq = 0
+    recs = []
+    text = data.decode('ascii', 'replace')
+
+    # use the last complete dump in the log
+    starts = [m for m in re.finditer(r'#AM_IRQ_TRACE freq=(\d+) count=(\d+)', text)]
+    if not starts:
+        raise ValueError('no "#AM_IRQ_TRACE" header found')
+    start = starts[-1]
+    freq  = int(start.group(1))
+
+    for line in text[start.end():].splitlines():
+        line = line.strip()
+        if line.startswith('#AM_IRQ_TRACE_END'):
+            break
+        m = re.match(r'@(-?\d+) (\d+) (\d+)$', line)
+        if m:
+            recs.append((int(m.group(1)), int(m.group(2)), int(m.group(3))))
+
+    return freq, recs
+
+
+def parse_binary(data):
+    """records from a memory dump of g_am_irq_trace, in write order"""
+    pos = data.find(struct.pack('<I', MAGIC))
+    if pos < 0:
+        raise ValueError('magic 0x%08x not found' % MAGIC)
+
+    _, freq, rec_num, count, _ = struct.unpack_from(HDR_FMT, data, pos)
+    base = pos + struct.calcsize(HDR_FMT)
+    size = struct.calcsize(REC_FMT)
+
+    if len(data) < base + rec_num * size:
+        raise ValueError('dump is truncated, %d records expected' % rec_num)
+
+    first = count - rec_num if count > rec_num else 0
+    recs  = []
+    for i in range(first, count):
+        ts, dur, inum, _ = struct.unpack_from(REC_FMT, data,
+                                              base + (i % rec_num) * size)
+        recs.append((inum, ts, dur))
+
+    return freq, recs
+
+
+def to_events(freq, recs, names):
+    """Chrome trace events, timestamps in microseconds"""
+    events   = []
+    last_end = None
+    high     = 0
+    scale    = 1e6 / freq if freq else 1.0
+
+    # records are written at exit, so the exit times are in order: unwrap
+    # the 32 bit timestamps on them
+    for (inum, ts, dur) in recs:
+        end = (ts + dur) & 0xFFFFFFFF
+        if last_end is not None and end < last_end:
+            high += 1 << 32
+        last_end = end
+
+        start = high + end - dur
+        name  = names.get(inum, CORE_NAMES.get(inum, 'IRQ %d' % inum))
+        events.append({
+            'name': name,
+            'cat':  'irq',
+            'ph':   'X',
+            'ts':   start * scale,
+            'dur':  dur * scale,
+            'pid':  1,
+            'tid':  1,
+            'args': {'inum': inum, 'ticks': dur},
+        })
+
+    events.sort(key=lambda e: (e['ts'], -e['dur']))
+    events.insert(0, {'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': 1,
+                      'args': {'name': 'interrupts'}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description='convert an am_irq_trace dump '
+                                                 'to a Chrome/Perfetto trace')
+    parser.add_argument('input', help="serial log or memory dump, '-' for stdin")
+    parser.add_argument('-o', '--output', default='-', help='output JSON file')
+    parser.add_argument('-f', '--freq', type=int, default=0,
+                        help='timestamp frequency in Hz (default: from the dump)')
+    parser.add_argument('-n', '--name', action='append', default=[],
+                        metavar='INUM=NAME', help='name of an interrupt')
+    opts = parser.parse_args()
+
+    names = {}
+    for item in opts.name:
+        inum, _, name = item.partition('=')
+        names[int(inum, 0)] = name
+
+    if opts.input == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(opts.input, 'rb') as f:
+            data = f.read()
+
+    if b'#AM_IRQ_TRACE freq=' in data:
+        freq, recs = parse_text(data)
+    else:
+        freq, recs = parse_binary(data)
+
+    if opts.freq:
+        freq = opts.freq
+    if not freq:
+        sys.stderr.write('warning: timestamp frequency unknown, '
+                         'times are in ticks\n')
+
+    trace = {'traceEvents': to_events(freq, recs, names),
+             'displayTimeUnit': 'ns'}
+
+    if opts.output == '-':
+        json.dump(trace, sys.stdout, indent=1)
+    else:
+        with open(opts.output, 'w') as f:
+            json.dump(trace, f, indent=1)
+
+    sys.stderr.write('%d records\n' % len(recs))
+
+
+if __name__ == '__main__':
+    main()